@@ -0,0 +1,69 @@
+# PlatformIO extra script (pre:)
+#
+# Before building, regenerates src/hardware/resources/WebFiles.cpp (gzip
+# pages, tools/web_assets.py) if a page in resources/web/ changed.
+#
+# After linking, writes the section sizes of the firmware to
+# .pio/build/<env>/size.json and prints the difference against every other
+# env that was already built, e.g. edgebox-esp-100 vs edgebox-esp-100-nolog,
+# to see how much flash/RAM the logging costs.
+import json
+import os
+import subprocess
+import sys
+
+Import("env")
+
+sys.path.insert(0, os.path.join(env.subst("$PROJECT_DIR"), "tools"))
+import web_assets  # noqa: E402
+
+web_assets.generate()
+
+
+def _section_sizes(elf, size_tool):
+    out = subprocess.check_output([size_tool, "-A", elf]).decode()
+    sizes = {"text": 0, "data": 0, "bss": 0}
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) < 2 or not parts[1].isdigit():
+            continue
+        name, size = parts[0], int(parts[1])
+        if name.startswith((".flash.text", ".iram0.text", ".flash.rodata")):
+            sizes["text"] += size
+        elif name.startswith((".dram0.data", ".flash.appdesc")):
+            sizes["data"] += size
+        elif name.startswith(".dram0.bss"):
+            sizes["bss"] += size
+    return sizes
+
+
+def size_report(source, target, env):
+    elf = str(target[0])
+    build_dir = env.subst("$BUILD_DIR")
+    this_env = env["PIOENV"]
+    size_tool = env.subst("$SIZETOOL") or "xtensa-esp32s3-elf-size"
+
+    try:
+        sizes = _section_sizes(elf, size_tool)
+    except (OSError, subprocess.CalledProcessError) as err:
+        print("[size] could not read %s: %s" % (elf, err))
+        return
+
+    with open(os.path.join(build_dir, "size.json"), "w") as f:
+        json.dump(sizes, f)
+    print("[size] %-24s text=%7d data=%6d bss=%6d"
+          % (this_env, sizes["text"], sizes["data"], sizes["bss"]))
+
+    root = os.path.dirname(build_dir)
+    for other in sorted(os.listdir(root)):
+        path = os.path.join(root, other, "size.json")
+        if other == this_env or not os.path.isfile(path):
+            continue
+        with open(path) as f:
+            ref = json.load(f)
+        print("[size] %-24s text=%+7d data=%+6d bss=%+6d  (vs %s)"
+              % ("  delta", sizes["text"] - ref["text"], sizes["data"] - ref["data"],
+                 sizes["bss"] - ref["bss"], other))
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", size_report)
@@ -3,6 +3,21 @@
 #include <Button.h>
 #include "config.h"
 
+// ── Cycle trace (ver src/ToteTrace.h) ────────────────────────────
+#define TOTE_TRACE_MAX 32
+
+typedef struct {
+  const char* name;  // estado o evento (siempre un literal estático)
+  uint32_t t_us;     // microsegundos desde el START del ciclo
+  char ph;           // 'B' = entrada a estado, 'i' = evento puntual
+} trace_mark;
+
+typedef struct {
+  int64_t start_us;  // esp_timer_get_time() al START
+  uint8_t count;
+  trace_mark marks[TOTE_TRACE_MAX];
+} tote_trace;
+
 typedef struct {
   char id[ID_SIZE];
   float fish_kg;
@@ -10,8 +25,21 @@ typedef struct {
   float water_out_kg;
   float initial_weight;  // Peso inicial antes de dispensar (para calcular deltas sin TARE)
   float raw_kg;  // Peso bruto sin procesar del backend (si disponible)
+  tote_trace trace;  // Timestamps de estados/eventos del ciclo
 } tote_data;
 
+// Ciclo de un tote (Lane), también en los builds nativos
+enum class ToteState {
+  IDLE,
+  DISPENSING_ICE,
+  SETTLING_ICE,       // 5 s pause after ice: pumps off, scale settles
+  DISPENSING_WATER,
+  WAITING_TOTE_ID,
+  COMPLETED,
+  CANCELED,
+  ERROR
+};
+
 enum button_type {
     NONE,
     START,
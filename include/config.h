@@ -5,10 +5,30 @@
 
 #define MIN_WEIGHT 5
 
+// Arranque automático al detectar un tote estable sobre la báscula (IDLE).
+// Apagado por defecto: arranca bombas sin operador, hay que activarlo en
+// /settings o por WS (queda guardado en NVS)
+#define AUTO_START_DEFAULT      false
+#define AUTO_START_BAND_KG      0.15f   // variación máx. mientras "estable"
+#define AUTO_START_HOLD_MS      1500    // tiempo estable antes de arrancar
+
 // #################### DISPENSING TARGETS ####################
 #define TARGET_ICE_KG 2.0    // Peso objetivo de hielo en kg
 #define TARGET_WATER_KG 2.0  // Peso objetivo de agua en kg
 
+// Hielo en dos velocidades: sinfín continuo hasta ICE fine_kg del objetivo,
+// luego pulsos cada vez más cortos (Dosing::Strategy::COARSE_FINE).
+// Umbrales por defecto en Dosing::Config; se cambian en /settings (NVS).
+#define ICE_COARSE_FINE_DEFAULT false
+
+// Agua y hielo a la vez, repartiendo el peso con modelos de caudal
+// aprendidos en los ciclos secuenciales (Dosing::Config::overlap).
+#define DOSING_OVERLAP_DEFAULT  false
+
+// Cambios de settings (web / WS) → NVS: se agrupan y se graban en un solo
+// commit cuando llevan este tiempo sin cambiar (solo las claves distintas)
+#define SETTINGS_SAVE_DELAY_MS  2000
+
 // ###################### INPUTS ######################
 #define START_IO                DI_0
 #define STOP_IO                 DI_1
@@ -24,6 +44,24 @@
 #define INDICATOR_1             DO_0
 #define INDICATOR_2             DO_1
 
+// ###################### LANES ######################
+// Una EdgeBox puede llevar varias posiciones de llenado (Lane): cada una
+// con su báscula (slave ID en la misma línea RS-485, ver ScaleBus), sus
+// bombas, botones e indicador de estado, y su "station" en el WebSocket.
+// La 1ª lane usa los pines de arriba y la station de siempre ("outbound").
+// LANE_NO_IO = sin botón / indicador físico (solo WS, serie, auto-start).
+// Para una 2ª lane: LANE_COUNT 2 y su fila en LANE_TABLE, p.ej. con I/O
+// de expansión (la EdgeBox solo tiene DI_0..DI_3 y DO_0..DO_5):
+//   { "outbound-2", 2, DO_5, EXP_DO_0, EXP_DO_1, LANE_NO_IO,
+//     LANE_NO_IO, LANE_NO_IO, LANE_NO_IO, LANE_NO_IO },
+#define LANE_NO_IO              0xFF
+#define LANE_COUNT              1           // ≤ ScaleBus::MAX_SCALES
+
+//  station        slave           water       ice       ice_stop  indicator    start     stop     manual ice     manual water
+#define LANE_TABLE { \
+  { "outbound",    MAREL_SLAVE_ID, WATER_PUMP, ICE_PUMP, ICE_STOP, INDICATOR_1, START_IO, STOP_IO, MANUAL_ICE_IO, MANUAL_WATER_IO }, \
+}
+
 
 // #################### MAREL - INFO ####################
 // Modbus RTU configuration for RS-485
@@ -31,6 +69,21 @@
 #define MAREL_RX_PIN            18          // GPIO18 (U1RXD)
 #define MAREL_TX_PIN            17          // GPIO17 (U1TXD)
 #define MAREL_DE_RE_PIN         8           // GPIO8 (RS485_RTS)
+#define MAREL_BAUD              9600
+// 1: UART1 en modo RS-485 half-duplex nativo (DE/RE por RTS en hardware,
+//    fin de trama por RX timeout) — Rs485Modbus. 0: librería ModbusRTU
+//    (DE/RE por software). Para comparar frames/s: comando serie "marel bench".
+#define MAREL_NATIVE_RS485      1
+// Varias básculas en la misma línea (ScaleBus): una por slave ID.
+// Poll de peso neto en segundo plano según prioridad del handle:
+// ACTIVE (dosificando) cada SCALE_POLL_ACTIVE_MS (0 = en cuanto la línea
+// queda libre), IDLE cada SCALE_POLL_IDLE_MS.
+#define SCALE_POLL_ACTIVE_MS    0
+#define SCALE_POLL_IDLE_MS      500
+// Hasta qué edad una lectura del poll sirve como peso de la lane; más
+// vieja (polls fallando), la lane vuelve a leer ella misma (NAN si no hay respuesta)
+#define SCALE_MAX_AGE_ACTIVE_MS 150
+#define SCALE_MAX_AGE_IDLE_MS   (2 * SCALE_POLL_IDLE_MS)
 
 //Configuración de red WiFi
 #define HAS_STATIC_IP                               //TURN ON THE STATIC IP
@@ -66,5 +119,4 @@
 #define www_username "admin"
 #define www_password "admin"
 #define VERSION "1.0.0"
-#define SERVER_INDEX_HTML INDEX_HTML
 
@@ -1,34 +1,50 @@
 #include "BLEQRClient.h"
+#include "Debug.h"
+#include "Metrics.h"
+#include <Preferences.h>
+#include <esp_gap_ble_api.h>
 
 // ── Static singleton pointer for callbacks ───────────────────────────────────
 static BLEQRClient* s_instance = nullptr;
 
 // ── Advertised-device callback (fired during scan) ───────────────────────────
+// By name, or by a cached address (a reader renamed or advertising
+// without its name in the scan response is still found). Readers
+// already connected or connecting are skipped
 class QRAdvertisedDeviceCallbacks : public BLEAdvertisedDeviceCallbacks {
   void onResult(BLEAdvertisedDevice advertisedDevice) override {
     if (!s_instance) return;
-    if (advertisedDevice.getName() == BLEQR_DEVICE_NAME) {
-      Serial.printf("[BLE-QR-OUT] Peripheral found: %s\n",
-                    advertisedDevice.getAddress().toString().c_str());
+    BLEAddress address = advertisedDevice.getAddress();
+    if (s_instance->_wanted(address, advertisedDevice.getName() == BLEQR_DEVICE_NAME)) {
       BLEDevice::getScan()->stop();
-      s_instance->_onFound(new BLEAdvertisedDevice(advertisedDevice));
+      s_instance->_onFound(address, advertisedDevice.getAddressType());
     }
   }
 };
+static QRAdvertisedDeviceCallbacks s_scanCallbacks;  // uno solo, reusado en cada scan
 
 // ── Notification callback ────────────────────────────────────────────────────
-static void notifyCallback(BLERemoteCharacteristic*, uint8_t* pData,
+static void notifyCallback(BLERemoteCharacteristic* pChar, uint8_t* pData,
                             size_t length, bool /*isNotify*/) {
-  if (s_instance) s_instance->_onNotify(pData, length);
+  if (s_instance) s_instance->_onNotify(pChar->getRemoteService()->getClient(), pData, length);
 }
 
-// ── Client connection callbacks ───────────────────────────────────────────────
+// ── Client connection callbacks (shared by every reader's BLEClient) ────────
 class QRClientCallbacks : public BLEClientCallbacks {
-  void onConnect(BLEClient*)    override {}
-  void onDisconnect(BLEClient*) override {
-    if (s_instance) s_instance->_onDisconnect();
+  void onConnect(BLEClient*)            override {}
+  void onDisconnect(BLEClient* pClient) override {
+    if (s_instance) s_instance->_onDisconnect(pClient);
   }
 };
+static QRClientCallbacks s_clientCallbacks;
+
+// ── Connector task: connect() + discovery, fuera de loop() ───────────────────
+static void connectTask(void*) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    if (s_instance) s_instance->_connectWorker();
+  }
+}
 
 // ─────────────────────────────────────────────────────────────────────────────
 // Public API
@@ -40,88 +56,331 @@ void BLEQRClient::begin(QRCallback cb) {
 
   BLEDevice::init("");
 
-  _pClient = BLEDevice::createClient();
-  _pClient->setClientCallbacks(new QRClientCallbacks());
+  for (Reader& r : _readers) {
+    r.client = BLEDevice::createClient();
+    r.client->setClientCallbacks(&s_clientCallbacks);
+  }
+
+  xTaskCreatePinnedToCore(connectTask, "bleConnect", 4096, nullptr, 1, &_connTask, 0);
 
-  Serial.println("[BLE-QR-OUT] Initialized – will scan for \"" BLEQR_DEVICE_NAME "\"");
-  _startScan();
+  // Lectores conocidos: conexión directa desde loop(), el resto por scan
+  _loadPeers();
+  _begun.store(true, std::memory_order_release);
+  LOG_BLE("[BLE-QR-OUT] Initialized – up to %u readers \"" BLEQR_DEVICE_NAME "\"\n",
+          BLEQR_MAX_READERS);
 }
 
 void BLEQRClient::loop() {
-  switch (_state) {
-    case BLEQRState::IDLE:
-      break;
+  if (!_begun.load(std::memory_order_acquire)) return;
+  _drainEvents();
 
-    case BLEQRState::SCANNING:
-      break;
+  // Resultado de la conexión en curso
+  if (_connIdx != NONE) {
+    const uint8_t result = _connResult.load(std::memory_order_acquire);
+    if (result != 0) _handleConnectResult(_connIdx, result == 1);
+  }
 
-    case BLEQRState::CONNECTING:
-      if (_foundDevice) {
-        _foundDevice = false;
-        if (_connectToServer()) {
-          _state = BLEQRState::CONNECTED;
-          Serial.println("[BLE-QR-OUT] Connected and subscribed");
-        } else {
-          Serial.println("[BLE-QR-OUT] Connection failed, re-scanning...");
-          _state = BLEQRState::SCANNING;
-          _startScan();
-        }
-      }
-      break;
+  // ACKs pendientes desde loop(), nunca desde el callback BLE
+  for (uint8_t i = 0; i < BLEQR_MAX_READERS; i++) {
+    Reader& r = _readers[i];
+    if (!r.pendingAck) continue;
+    r.pendingAck = false;
+    if (r.state == BLEQRState::CONNECTED && r.reqChar) {
+      r.reqChar->writeValue("ACK", false);
+      LOG_BLE_V("[BLE-QR-OUT] ACK enviado al lector %u\n", i);
+    }
+  }
 
-    case BLEQRState::CONNECTED:
-      // Enviar ACK pendiente desde loop(), nunca desde el callback BLE
-      if (_pendingAck && _pReqChar) {
-        _pReqChar->writeValue("ACK", false);
-        _pendingAck = false;
-        Serial.println("[BLE-QR-OUT] ACK enviado al periférico");
-      }
-      break;
+  if (_connIdx != NONE) return;  // de a una conexión
 
-    case BLEQRState::LOST:
-      if (millis() - _lastScanMs > SCAN_INTERVAL_MS) {
-        Serial.println("[BLE-QR-OUT] Re-scanning for peripheral...");
-        _startScan();
-      }
-      break;
+  // Siguiente conexión: lo encontrado por scan, luego reconexión directa
+  for (uint8_t i = 0; i < BLEQR_MAX_READERS; i++) {
+    if (_readers[i].state == BLEQRState::CONNECTING) {
+      _beginConnect(i, _readers[i].direct);
+      return;
+    }
+  }
+  for (uint8_t i = 0; i < BLEQR_MAX_READERS; i++) {
+    Reader& r = _readers[i];
+    if (r.state != BLEQRState::LOST) continue;
+    if (r.hasPeer && r.directFails < BLEQR_DIRECT_TRIES) {
+      LOG_BLE("[BLE-QR-OUT] Reconnecting to cached reader %u...\n", i);
+      _beginConnect(i, /* direct */ true);
+      return;
+    }
+    r.state = BLEQRState::IDLE;  // queda para el scan
+  }
+
+  // Escanear mientras quede un slot libre
+  bool freeSlot = false;
+  for (const Reader& r : _readers) freeSlot |= r.state == BLEQRState::IDLE;
+  if (freeSlot && !_scanning) _startScan();
+}
+
+BLEQRState BLEQRClient::getState() const {
+  if (!_begun.load(std::memory_order_acquire)) return BLEQRState::IDLE;
+  if (_connected > 0) return BLEQRState::CONNECTED;
+  bool lost = false;
+  for (const Reader& r : _readers) {
+    if (r.state == BLEQRState::CONNECTING) return BLEQRState::CONNECTING;
+    lost |= r.state == BLEQRState::LOST;
+  }
+  return lost && !_scanning ? BLEQRState::LOST : BLEQRState::SCANNING;
+}
+
+bool BLEQRClient::pushes() const {
+  if (_connected == 0) return false;
+  for (const Reader& r : _readers) {
+    if (r.state == BLEQRState::CONNECTED && !r.notifying) return false;
   }
+  return true;
 }
 
 void BLEQRClient::requestQR() {
-  if (_state != BLEQRState::CONNECTED || !_pReqChar) {
-    Serial.println("[BLE-QR-OUT] requestQR(): not connected");
+  if (_connected == 0) {
+    LOG_BLE("[BLE-QR-OUT] requestQR(): not connected\n");
     return;
   }
-  Serial.println("[BLE-QR-OUT] Sending QR request...");
-  _pReqChar->writeValue("GET", false);
+  LOG_BLE_V("[BLE-QR-OUT] Sending QR request...\n");
+  uint32_t now = millis();
+  if (now == 0) now = 1;
+  for (Reader& r : _readers) {
+    if (r.state != BLEQRState::CONNECTED || !r.reqChar) continue;
+    r.reqChar->writeValue("GET", false);
+    r.requestMs = now;
+  }
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
 // Internal callbacks
 // ─────────────────────────────────────────────────────────────────────────────
 
-void BLEQRClient::_onFound(BLEAdvertisedDevice* device) {
-  _serverAddress = device->getAddress().toString().c_str();
-  delete device;
-  _foundDevice = true;
-  _state       = BLEQRState::CONNECTING;
+// BLE task: copiar a la cola y volver. Sin String, sin log, sin callback
+
+BLEQRClient::Event* BLEQRClient::_claim(Event::Kind kind, uint8_t reader) {
+  Event* e = _events.claim();
+  if (!e) {
+    Metrics::inc(Metrics::BLE_EVENTS_DROPPED);  // loop() atrasado: cola llena
+    return nullptr;
+  }
+  e->kind   = kind;
+  e->reader = reader;
+  e->len    = 0;
+  e->ms     = millis();
+  return e;
 }
 
-void BLEQRClient::_onNotify(uint8_t* pData, size_t length) {
-  String value((char*)pData, length);
-  Serial.printf("[BLE-QR-OUT] Notification received: %s\n", value.c_str());
-  if (_callback && _callback(value)) {
-    _pendingAck = true;  // callback procesó exitosamente → ACK en loop()
+uint8_t BLEQRClient::_readerOf(const BLEClient* client) const {
+  for (uint8_t i = 0; i < BLEQR_MAX_READERS; i++) {
+    if (_readers[i].client == client) return i;
   }
+  return NONE;
+}
+
+void BLEQRClient::_onFound(BLEAddress address, esp_ble_addr_type_t type) {
+  Event* e = _claim(Event::FOUND, NONE);
+  if (!e) return;
+  memcpy(e->data, *address.getNative(), sizeof(esp_bd_addr_t));
+  e->data[sizeof(esp_bd_addr_t)] = (char)type;
+  e->len = sizeof(esp_bd_addr_t) + 1;
+  _events.commit();
+}
+
+void BLEQRClient::_onNotify(BLEClient* client, const uint8_t* pData, size_t length) {
+  const uint8_t i = _readerOf(client);
+  if (i == NONE) return;
+  Event* e = _claim(Event::NOTIFY, i);
+  if (!e) return;
+  if (length > BLEQR_MAX_PAYLOAD) length = BLEQR_MAX_PAYLOAD;
+  memcpy(e->data, pData, length);
+  e->data[length] = '\0';
+  e->len = (uint8_t)length;
+  _events.commit();
+}
+
+void BLEQRClient::_onDisconnect(BLEClient* client) {
+  const uint8_t i = _readerOf(client);
+  if (i != NONE && _claim(Event::DISCONNECTED, i)) _events.commit();
 }
 
-void BLEQRClient::_onDisconnect() {
-  Serial.println("[BLE-QR-OUT] Peripheral disconnected");
-  _pDataChar  = nullptr;
-  _pReqChar   = nullptr;
-  _pendingAck = false;  // descartar ACK pendiente si se cayó la conexión
-  _state      = BLEQRState::LOST;
-  _lastScanMs = millis();
+// Scan task: a known reader only while it is neither connected nor
+// connecting; an unknown address only by name
+bool BLEQRClient::_wanted(BLEAddress& address, bool named) const {
+  for (const Reader& r : _readers) {
+    if (r.hasPeer.load(std::memory_order_acquire) &&
+        memcmp(*address.getNative(), r.peer, sizeof(esp_bd_addr_t)) == 0) {
+      return !r.busy.load(std::memory_order_acquire);
+    }
+  }
+  return named;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Event handling (loop task)
+// ─────────────────────────────────────────────────────────────────────────────
+
+void BLEQRClient::_drainEvents() {
+  while (const Event* e = _events.front()) {
+    Metrics::inc(Metrics::BLE_EVENTS);
+    switch (e->kind) {
+      case Event::FOUND:        _handleFound(*e);             break;
+      case Event::NOTIFY:       _handleNotify(*e);            break;
+      case Event::DISCONNECTED: _handleDisconnect(e->reader); break;
+    }
+    _events.pop();
+  }
+}
+
+void BLEQRClient::_handleFound(const Event& e) {
+  _scanning = false;  // el callback paró el scan
+
+  // Slot: el de esa dirección; si no, uno vacío; si no, uno libre cuyo
+  // lector guardado no volvió
+  uint8_t slot = NONE, empty = NONE, stale = NONE;
+  for (uint8_t i = 0; i < BLEQR_MAX_READERS; i++) {
+    const Reader& r = _readers[i];
+    if (r.hasPeer && memcmp(r.peer, e.data, sizeof(esp_bd_addr_t)) == 0) {
+      if (r.state != BLEQRState::IDLE) return;  // ya conectado / conectando
+      slot = i;
+      break;
+    }
+    if (r.state != BLEQRState::IDLE) continue;
+    if (!r.hasPeer && empty == NONE) empty = i;
+    if (r.hasPeer && stale == NONE)  stale = i;
+  }
+  if (slot == NONE) slot = empty != NONE ? empty : stale;
+  if (slot == NONE) return;  // todos los slots ocupados
+
+  Reader& r = _readers[slot];
+  if (!r.hasPeer || memcmp(r.peer, e.data, sizeof(esp_bd_addr_t)) != 0) {
+    r.hasPeer.store(false, std::memory_order_release);  // el scan no lee una dirección a medias
+    memcpy(r.peer, e.data, sizeof(esp_bd_addr_t));
+    _peersDirty = true;
+  }
+  r.peerType = (esp_ble_addr_type_t)e.data[sizeof(esp_bd_addr_t)];
+  r.busy.store(true, std::memory_order_release);
+  r.hasPeer.store(true, std::memory_order_release);
+  r.state  = BLEQRState::CONNECTING;
+  r.direct = false;
+  LOG_BLE("[BLE-QR-OUT] Reader %u found: %s\n", slot, BLEAddress(r.peer).toString().c_str());
+}
+
+void BLEQRClient::_handleNotify(const Event& e) {
+  Reader& r = _readers[e.reader];
+  LOG_BLE_V("[BLE-QR-OUT] Notification from reader %u: %s\n", e.reader, e.data);
+
+  // Respuesta a un GET reciente, o QR empujado por el lector al leerlo
+  const bool answer = r.requestMs != 0 && e.ms - r.requestMs <= BLEQR_POLL_ANSWER_MS;
+  r.requestMs = 0;
+  const bool qr = strcmp(e.data, "NO_QR") != 0;
+  if (qr) Metrics::inc(answer ? Metrics::BLE_QR_POLLED : Metrics::BLE_QR_PUSHED);
+
+  // El mismo tote leído también por otro lector: ya fue entregado.
+  // ACK igual, para que este lector no lo vuelva a ofrecer
+  if (qr && _isDuplicate(e.data, e.ms)) {
+    Metrics::inc(Metrics::BLE_QR_DUPLICATES);
+    LOG_BLE_V("[BLE-QR-OUT] Duplicate QR from reader %u, ignored\n", e.reader);
+    r.pendingAck = true;
+    return;
+  }
+
+  _scannedMs = answer ? 0 : e.ms;
+  _current   = e.reader;
+  if (_callback && _callback(e.data)) {
+    r.pendingAck = true;  // callback procesó exitosamente → ACK a este lector
+    if (qr) {
+      strncpy(_lastQr, e.data, sizeof(_lastQr) - 1);
+      _lastQrMs = e.ms ? e.ms : 1;
+    }
+  }
+  _scannedMs = 0;
+  _current   = NONE;
+}
+
+// Dentro de BLEQR_DEDUP_MS del último QR aceptado, de cualquier lector
+bool BLEQRClient::_isDuplicate(const char* qr, uint32_t now) {
+  return _lastQrMs != 0 && now - _lastQrMs <= BLEQR_DEDUP_MS && strcmp(qr, _lastQr) == 0;
+}
+
+void BLEQRClient::_handleDisconnect(uint8_t i) {
+  Reader& r = _readers[i];
+  // connect() fallido (lo resuelve el resultado) o una caída ya superada
+  if (r.state != BLEQRState::CONNECTED || r.client->isConnected()) return;
+
+  LOG_BLE("[BLE-QR-OUT] Reader %u disconnected\n", i);
+  r.dataChar    = nullptr;
+  r.reqChar     = nullptr;
+  r.notifying   = false;
+  r.pendingAck  = false;  // descartar ACK pendiente si se cayó la conexión
+  r.requestMs   = 0;
+  r.directFails = 0;
+  r.state       = BLEQRState::LOST;
+  r.lostMs      = millis();
+  r.busy.store(false, std::memory_order_release);
+  _countConnected();
+}
+
+void BLEQRClient::_handleConnectResult(uint8_t i, bool ok) {
+  Reader& r = _readers[i];
+  _connResult.store(0, std::memory_order_relaxed);
+  _connIdx = NONE;
+
+  // Caída entre el subscribe y este loop(): su DISCONNECTED ya se ignoró
+  if (ok && !r.client->isConnected()) ok = false;
+  if (ok) {
+    r.state       = BLEQRState::CONNECTED;
+    r.directFails = 0;
+    Metrics::inc(r.direct ? Metrics::BLE_CONNECTS_DIRECT : Metrics::BLE_CONNECTS_SCAN);
+    if (r.lostMs) {
+      Metrics::observe(Metrics::BLE_RECONNECT_US, (millis() - r.lostMs) * 1000);
+      r.lostMs = 0;
+    }
+    if (_peersDirty) _savePeers();
+    _countConnected();
+    LOG_BLE("[BLE-QR-OUT] Reader %u connected (%s) and %s – %u/%u\n", i,
+            r.direct ? "direct" : "scan", r.notifying ? "subscribed" : "polling",
+            _connected, BLEQR_MAX_READERS);
+    return;
+  }
+
+  r.busy.store(false, std::memory_order_release);
+  if (r.direct) {
+    r.directFails++;
+    r.state = BLEQRState::LOST;  // loop(): otro intento directo, o al scan
+    LOG_BLE("[BLE-QR-OUT] Direct connection to reader %u failed (%u/%u)\n",
+            i, r.directFails, BLEQR_DIRECT_TRIES);
+  } else {
+    r.state = BLEQRState::IDLE;
+    LOG_BLE("[BLE-QR-OUT] Connection to reader %u failed, re-scanning...\n", i);
+  }
+}
+
+void BLEQRClient::_countConnected() {
+  uint8_t n = 0;
+  for (const Reader& r : _readers) n += r.state == BLEQRState::CONNECTED;
+  _connected = n;
+  Metrics::set(Metrics::BLE_READERS, n);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Connector task
+// ─────────────────────────────────────────────────────────────────────────────
+
+void BLEQRClient::_beginConnect(uint8_t i, bool direct) {
+  if (_scanning) _stopScan();  // connect() más fiable sin scan en paralelo
+  Reader& r = _readers[i];
+  r.state  = BLEQRState::CONNECTING;
+  r.direct = direct;
+  r.busy.store(true, std::memory_order_release);
+  _connIdx = i;
+  _connResult.store(0, std::memory_order_relaxed);
+  xTaskNotifyGive(_connTask);
+}
+
+void BLEQRClient::_connectWorker() {
+  const bool ok = _connectToServer(_readers[_connIdx]);
+  // Publica dataChar/reqChar/notifying junto con el resultado
+  _connResult.store(ok ? 1 : 2, std::memory_order_release);
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -129,52 +388,103 @@ void BLEQRClient::_onDisconnect() {
 // ─────────────────────────────────────────────────────────────────────────────
 
 void BLEQRClient::_startScan() {
-  _state = BLEQRState::SCANNING;
+  _scanning = true;
 
   BLEScan* pScan = BLEDevice::getScan();
-  pScan->setAdvertisedDeviceCallbacks(new QRAdvertisedDeviceCallbacks());
+  pScan->setAdvertisedDeviceCallbacks(&s_scanCallbacks);
   pScan->setActiveScan(true);
   pScan->setInterval(100);
-  pScan->setWindow(99);
+  // Con lectores conectados, ventana corta: la radio es compartida
+  pScan->setWindow(_connected ? 30 : 99);
   pScan->start(0, nullptr, false);
-  Serial.println("[BLE-QR-OUT] Scan started...");
+  LOG_BLE("[BLE-QR-OUT] Scan started...\n");
 }
 
-bool BLEQRClient::_connectToServer() {
-  BLEAddress address(_serverAddress.c_str());
+void BLEQRClient::_stopScan() {
+  BLEDevice::getScan()->stop();
+  _scanning = false;
+}
+
+// Connector task only
+bool BLEQRClient::_connectToServer(Reader& r) {
+  BLEAddress address(r.peer);
+  r.notifying = false;
+
+  // Intervalo corto (QR al instante) y supervisión corta (caída detectada en 2 s)
+  esp_ble_gap_set_prefer_conn_params(r.peer, BLEQR_CONN_MIN_INT, BLEQR_CONN_MAX_INT,
+                                     BLEQR_CONN_LATENCY, BLEQR_CONN_TIMEOUT);
 
-  if (!_pClient->connect(address)) {
-    Serial.println("[BLE-QR-OUT] connect() failed");
+  if (!r.client->connect(address, r.peerType)) {
+    LOG_BLE("[BLE-QR-OUT] connect() failed\n");
     return false;
   }
 
-  BLERemoteService* pService = _pClient->getService(BLEQR_SERVICE_UUID);
+  BLERemoteService* pService = r.client->getService(BLEQR_SERVICE_UUID);
   if (!pService) {
-    Serial.println("[BLE-QR-OUT] Service not found");
-    _pClient->disconnect();
+    LOG_ERR("[BLE-QR-OUT] Service not found\n");
+    r.client->disconnect();
     return false;
   }
 
-  _pDataChar = pService->getCharacteristic(BLEQR_DATA_CHAR_UUID);
-  if (!_pDataChar) {
-    Serial.println("[BLE-QR-OUT] Data characteristic not found");
-    _pClient->disconnect();
+  r.dataChar = pService->getCharacteristic(BLEQR_DATA_CHAR_UUID);
+  if (!r.dataChar) {
+    LOG_ERR("[BLE-QR-OUT] Data characteristic not found\n");
+    r.client->disconnect();
     return false;
   }
 
-  _pReqChar = pService->getCharacteristic(BLEQR_REQ_CHAR_UUID);
-  if (!_pReqChar) {
-    Serial.println("[BLE-QR-OUT] Request characteristic not found");
-    _pClient->disconnect();
+  r.reqChar = pService->getCharacteristic(BLEQR_REQ_CHAR_UUID);
+  if (!r.reqChar) {
+    LOG_ERR("[BLE-QR-OUT] Request characteristic not found\n");
+    r.client->disconnect();
     return false;
   }
 
-  if (_pDataChar->canNotify()) {
-    _pDataChar->registerForNotify(notifyCallback);
-    Serial.println("[BLE-QR-OUT] Subscribed to QR notifications");
+  if (r.dataChar->canNotify()) {
+    r.dataChar->registerForNotify(notifyCallback);
+    r.notifying = true;
+    LOG_BLE("[BLE-QR-OUT] Subscribed to QR notifications\n");
   } else {
-    Serial.println("[BLE-QR-OUT] Data char cannot notify – proceeding with READ only");
+    LOG_BLE("[BLE-QR-OUT] Data char cannot notify – proceeding with READ only\n");
   }
 
   return true;
 }
+
+// ── Lectores conocidos en NVS: reconexión directa también tras reiniciar ────
+// "qr_peers": por lector, esp_bd_addr_t + tipo de dirección
+static const size_t PEER_BYTES = sizeof(esp_bd_addr_t) + 1;
+
+void BLEQRClient::_loadPeers() {
+  uint8_t buf[BLEQR_MAX_READERS * PEER_BYTES];
+  Preferences prefs;
+  prefs.begin("tote_cfg", /*readOnly=*/true);
+  const size_t n = prefs.getBytes("qr_peers", buf, sizeof(buf)) / PEER_BYTES;
+  prefs.end();
+
+  for (size_t i = 0; i < n; i++) {
+    Reader& r = _readers[i];
+    memcpy(r.peer, &buf[i * PEER_BYTES], sizeof(esp_bd_addr_t));
+    r.peerType = (esp_ble_addr_type_t)buf[i * PEER_BYTES + sizeof(esp_bd_addr_t)];
+    r.hasPeer.store(true, std::memory_order_release);
+    r.state = BLEQRState::LOST;  // loop(): conexión directa
+    LOG_BLE("[BLE-QR-OUT] Cached reader %u: %s\n", (unsigned)i,
+            BLEAddress(r.peer).toString().c_str());
+  }
+}
+
+void BLEQRClient::_savePeers() {
+  uint8_t buf[BLEQR_MAX_READERS * PEER_BYTES];
+  size_t  len = 0;
+  for (const Reader& r : _readers) {
+    if (!r.hasPeer) continue;
+    memcpy(&buf[len], r.peer, sizeof(esp_bd_addr_t));
+    buf[len + sizeof(esp_bd_addr_t)] = (uint8_t)r.peerType;
+    len += PEER_BYTES;
+  }
+  Preferences prefs;
+  prefs.begin("tote_cfg", /*readOnly=*/false);
+  prefs.putBytes("qr_peers", buf, len);
+  prefs.end();
+  _peersDirty = false;
+}
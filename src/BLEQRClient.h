@@ -2,10 +2,32 @@
 /**
  * BLEQRClient – Outbound version
  * --------------------------------
- * BLE Central (client) que conecta al periférico "QR-Reader-OUT".
+ * BLE Central (client) que conecta a los periféricos "QR-Reader-OUT".
  * UUIDs distintos al inbound para que ambos ESP32 no interfieran.
  *
  * UUIDs deben coincidir con el firmware del QR-Reader asignado al outbound.
+ *
+ * Varios lectores a la vez (BLEQR_MAX_READERS, p.ej. uno a cada lado de
+ * la cinta): cada uno ocupa un slot con su BLEClient, sus
+ * características y su ACK. Mientras quede un slot libre se sigue
+ * escaneando. Un mismo QR leído por dos lectores dentro de
+ * BLEQR_DEDUP_MS se entrega una sola vez; el ACK va siempre al lector
+ * que lo envió.
+ *
+ * Los callbacks de Bluedroid (scan, notify, disconnect) corren en la
+ * task del stack BLE: solo copian el evento a una cola SPSC fija (sin
+ * heap, sin bloquear) y loop() los procesa. Así el callback de QR del
+ * usuario, el log y el ACK nunca frenan al stack BLE.
+ *
+ * Entrega de QR: el lector notifica cada QR leído (push). El "GET" de
+ * requestQR() queda como respaldo: pollIntervalMs() dice cada cuánto
+ * pedirlo (lento si hay push, 3 s si alguna característica no notifica).
+ *
+ * Reconexión: las direcciones de los lectores se guardan (RAM + NVS).
+ * Tras una caída, y al arrancar, se conecta directo a esa dirección;
+ * solo si falla BLEQR_DIRECT_TRIES veces el slot vuelve a depender del
+ * scan. connect() y el discovery bloquean hasta segundos: corren de a
+ * uno en una task propia ("bleConnect", core 0), nunca en loop().
  */
 
 #include <Arduino.h>
@@ -14,7 +36,9 @@
 #include <BLEScan.h>
 #include <BLEAdvertisedDevice.h>
 #include <BLERemoteCharacteristic.h>
+#include <atomic>
 #include <functional>
+#include "core/SpscRing.h"
 
 // ── UUIDs (must match QR-Reader-OUT firmware) ────────────────────────────────
 #define BLEQR_DEVICE_NAME     "QR-Reader-OUT"
@@ -22,17 +46,39 @@
 #define BLEQR_DATA_CHAR_UUID  "12345678-1234-1234-1234-223456789abd"  // READ+NOTIFY
 #define BLEQR_REQ_CHAR_UUID   "12345678-1234-1234-1234-223456789abe"  // WRITE
 
+#define BLEQR_MAX_PAYLOAD     64   // notificación más larga aceptada (se trunca)
+#define BLEQR_EVENT_QUEUE     8    // eventos BLE → loop() en vuelo (potencia de 2)
+
+// Bluedroid admite CONFIG_BTDM_CTRL_BLE_MAX_CONN conexiones (3 por defecto)
+#define BLEQR_MAX_READERS     3
+#define BLEQR_DEDUP_MS        3000    // mismo QR aceptado de nuevo (otro lector) = duplicado
+
+// ── Entrega / reconexión ─────────────────────────────────────────────────────
+#define BLEQR_POLL_MS         3000    // GET sin notificaciones
+#define BLEQR_POLL_PUSH_MS    15000   // GET de respaldo con notificaciones activas
+#define BLEQR_POLL_ANSWER_MS  1000    // notificación tras un GET = respuesta, no push
+#define BLEQR_DIRECT_TRIES    2       // conexiones directas antes de escanear
+
+// Parámetros de conexión pedidos al lector (unidades BLE):
+// intervalo 7.5–15 ms (1.25 ms), sin latencia de esclavo, supervisión 2 s
+// (10 ms) para detectar la caída rápido y reconectar
+#define BLEQR_CONN_MIN_INT    6
+#define BLEQR_CONN_MAX_INT    12
+#define BLEQR_CONN_LATENCY    0
+#define BLEQR_CONN_TIMEOUT    200
+
 enum class BLEQRState {
-  IDLE,        // not yet initialized
+  IDLE,        // not yet initialized / free slot
   SCANNING,    // actively scanning for the QR-Reader peripheral
-  CONNECTING,  // found device, attempting connection
+  CONNECTING,  // connecting (found by scan, or direct to the cached address)
   CONNECTED,   // connected and subscribed
-  LOST         // connection lost, will re-scan
+  LOST         // connection lost, will reconnect
 };
 
 class BLEQRClient {
 public:
-  using QRCallback = std::function<bool(const String&)>;  // true = QR procesado → enviar ACK
+  // Llamado desde loop(), nunca desde la task BLE. true = QR procesado → enviar ACK
+  using QRCallback = std::function<bool(const char* qr)>;
 
   /**
    * Call once in setup(). Safe to call even if BLEDevice::init() was already
@@ -41,43 +87,125 @@ public:
   void begin(QRCallback cb);
 
   /**
-   * Call every loop iteration. Drives the state machine (scan → connect →
+   * Call every loop iteration. Drains the BLE event queue (QR callback,
+   * disconnects) and drives the state machine (scan → connect →
    * subscribe). Non-blocking.
    */
   void loop();
 
-  /** Returns true when the peripheral is connected and ready. */
-  bool isConnected() const { return _state == BLEQRState::CONNECTED; }
+  /** True when at least one reader is connected and ready. */
+  bool isConnected() const { return _connected > 0; }
+
+  /** Readers connected right now. */
+  uint8_t connectedCount() const { return _connected; }
+
+  /**
+   * Overall state for the indicator: CONNECTED if any reader is,
+   * else CONNECTING / SCANNING / LOST / IDLE.
+   */
+  BLEQRState getState() const;
+
+  /** Every connected reader is subscribed: scanned QRs arrive on their own. */
+  bool pushes() const;
 
-  BLEQRState getState() const { return _state; }
+  /** How often a waiting tote should fall back to requestQR(). */
+  uint32_t pollIntervalMs() const { return pushes() ? BLEQR_POLL_PUSH_MS : BLEQR_POLL_MS; }
 
   /**
-   * Sends a "GET" write to the request characteristic.
-   * The peripheral will answer with a BLE notification containing the
-   * buffered QR string (or "NO_QR" if nothing has been scanned yet).
+   * Sends a "GET" write to the request characteristic of every
+   * connected reader. Each answers with a BLE notification containing
+   * its buffered QR string (or "NO_QR" if nothing has been scanned yet).
    * Only has effect when isConnected() == true.
    */
   void requestQR();
 
-  // ── Internal use by static callbacks ────────────────────────────────────
-  void _onFound(BLEAdvertisedDevice* device);
-  void _onNotify(uint8_t* data, size_t length);
-  void _onDisconnect();
+  /**
+   * Inside the QR callback: millis() when the reader pushed this QR,
+   * i.e. when it was scanned. 0 for the answer to a requestQR() (the
+   * scan happened at some earlier, unknown time).
+   */
+  uint32_t scannedMs() const { return _scannedMs; }
+
+  /** Inside the QR callback: slot of the reader that sent it. */
+  uint8_t reader() const { return _current; }
+
+  // ── Internal use by static callbacks (BLE task: enqueue only) ──────────
+  void _onFound(BLEAddress address, esp_ble_addr_type_t type);
+  void _onNotify(BLEClient* client, const uint8_t* data, size_t length);
+  void _onDisconnect(BLEClient* client);
+  bool _wanted(BLEAddress& address, bool named) const;
+
+  // ── Internal use by the connector task ─────────────────────────────────
+  void _connectWorker();
 
 private:
-  bool _connectToServer();
+  static const uint8_t NONE = 0xFF;
+
+  struct Event {
+    enum Kind : uint8_t { FOUND, NOTIFY, DISCONNECTED } kind;
+    uint8_t  reader;                      // slot (NONE for FOUND)
+    uint8_t  len;
+    uint32_t ms;                          // millis() in the BLE task
+    char     data[BLEQR_MAX_PAYLOAD + 1];  // NOTIFY: payload + '\0'; FOUND: esp_bd_addr_t + addr type
+  };
+
+  // Un lector. client es fijo desde begin(); la task BLE compara contra
+  // él. peer/hasPeer también los lee el callback de scan
+  struct Reader {
+    BLEClient*                client      = nullptr;
+    BLERemoteCharacteristic*  dataChar    = nullptr;
+    BLERemoteCharacteristic*  reqChar     = nullptr;
+    esp_bd_addr_t             peer        = {};
+    esp_ble_addr_type_t       peerType    = BLE_ADDR_TYPE_PUBLIC;
+    std::atomic<bool>         hasPeer{false};
+    std::atomic<bool>         busy{false};      // conectado o conectando: el scan lo ignora
+    BLEQRState                state       = BLEQRState::IDLE;
+    bool                      direct      = false;
+    uint8_t                   directFails = 0;
+    bool                      notifying   = false;  // suscrito a notificaciones
+    bool                      pendingAck  = false;  // true = enviar ACK en el próximo loop()
+    uint32_t                  requestMs   = 0;      // último GET (distingue respuesta de push)
+    uint32_t                  lostMs      = 0;      // caída (métrica de reconexión)
+  };
+
+  Event*  _claim(Event::Kind kind, uint8_t reader);
+  uint8_t _readerOf(const BLEClient* client) const;
+  void    _drainEvents();
+  void    _handleFound(const Event& e);
+  void    _handleNotify(const Event& e);
+  void    _handleDisconnect(uint8_t i);
+  void    _handleConnectResult(uint8_t i, bool ok);
+  bool    _isDuplicate(const char* qr, uint32_t now);
+  void    _countConnected();
+
+  void _beginConnect(uint8_t i, bool direct);
+  bool _connectToServer(Reader& r);
   void _startScan();
+  void _stopScan();
+  void _loadPeers();
+  void _savePeers();
 
-  BLEClient*                _pClient        = nullptr;
-  BLERemoteCharacteristic*  _pDataChar      = nullptr;
-  BLERemoteCharacteristic*  _pReqChar       = nullptr;
+  // Productor: la task de Bluedroid (todos sus callbacks corren ahí).
+  // Consumidor: loop()
+  SpscRing<Event, BLEQR_EVENT_QUEUE> _events;
 
-  BLEQRState  _state       = BLEQRState::IDLE;
+  Reader      _readers[BLEQR_MAX_READERS];
+  uint8_t     _connected   = 0;
+  std::atomic<bool> _begun{false};     // begin() may run on a boot task (Boot.h)
+  bool        _scanning    = false;
+  bool        _peersDirty  = false;  // direcciones cambiaron, guardar en NVS
   QRCallback  _callback;
 
-  String      _serverAddress;
-  bool        _foundDevice   = false;
-  bool        _pendingAck    = false;  // true = enviar ACK en el próximo loop()
-  uint32_t    _lastScanMs    = 0;
-  static const uint32_t SCAN_INTERVAL_MS = 8000;
+  // Conexión en la task "bleConnect", de a un lector: loop() la pide con
+  // _beginConnect() y lee el resultado (0 = en curso, 1 = ok, 2 = falló)
+  TaskHandle_t          _connTask    = nullptr;
+  std::atomic<uint8_t>  _connResult{0};
+  uint8_t               _connIdx     = NONE;
+
+  // Último QR aceptado (dedup entre lectores)
+  char        _lastQr[BLEQR_MAX_PAYLOAD + 1] = {};
+  uint32_t    _lastQrMs      = 0;
+
+  uint32_t    _scannedMs     = 0;      // QR en curso en el callback
+  uint8_t     _current       = NONE;   // lector del QR en curso
 };
@@ -0,0 +1,80 @@
+// ============================================================
+// Boot.cpp  —  setup() as a small graph of init steps
+// ============================================================
+#include "Boot.h"
+#include <freertos/event_groups.h>
+#include "esp_timer.h"
+#include "Debug.h"
+#include "Metrics.h"
+
+namespace Boot {
+
+  static const char* const NAMES[STEP_COUNT] = {"core", "lanes", "backend", "net", "web", "ble"};
+
+  // Bit per finished step. Created by the first run()/spawn() (setup(),
+  // before any step task exists)
+  static EventGroupHandle_t s_done = nullptr;
+
+  struct Job {
+    Step     step;
+    Fn       fn;
+    uint32_t after;
+  };
+  static Job s_jobs[STEP_COUNT];
+
+  static void exec(const Job& job) {
+    if (job.after) wait(job.after);
+
+    const uint32_t start = (uint32_t)esp_timer_get_time();
+    job.fn();
+    const uint32_t end = (uint32_t)esp_timer_get_time();
+
+    Metrics::bootStep(job.step, NAMES[job.step], start, end);
+    LOG_MAIN("[BOOT] %-8s %5lu → %5lu ms\n", NAMES[job.step],
+             (unsigned long)(start / 1000), (unsigned long)(end / 1000));
+    xEventGroupSetBits(s_done, bit(job.step));
+  }
+
+  static void stepTask(void* arg) {
+    exec(*static_cast<const Job*>(arg));
+    vTaskDelete(nullptr);
+  }
+
+  static void init() {
+    if (!s_done) s_done = xEventGroupCreate();
+  }
+
+  void run(Step step, Fn fn, uint32_t after) {
+    init();
+    s_jobs[step] = {step, fn, after};
+    exec(s_jobs[step]);
+  }
+
+  void spawn(Step step, Fn fn, uint32_t after, uint32_t stack) {
+    init();
+    s_jobs[step] = {step, fn, after};
+    if (xTaskCreatePinnedToCore(stepTask, NAMES[step], stack, &s_jobs[step], 1, nullptr, 0) != pdPASS) {
+      LOG_ERR("[BOOT] no task for step %s, running inline\n", NAMES[step]);
+      exec(s_jobs[step]);
+    }
+  }
+
+  bool done(Step step) {
+    return s_done && (xEventGroupGetBits(s_done) & bit(step));
+  }
+
+  void wait(uint32_t mask) {
+    xEventGroupWaitBits(s_done, mask, pdFALSE, pdTRUE, portMAX_DELAY);
+  }
+
+  void ready() {
+    static bool s_ready = false;
+    if (s_ready) return;
+    s_ready = true;
+
+    const uint32_t now = (uint32_t)esp_timer_get_time();
+    Metrics::bootStep(STEP_COUNT, "ready", now, now);
+    LOG_MAIN("[BOOT] ready at %lu ms (network steps may still be running)\n",
+             (unsigned long)(now / 1000));
+  }
+}
@@ -0,0 +1,52 @@
+#pragma once
+// ============================================================
+// Boot  —  setup() as a small graph of init steps
+//
+// Each step names the steps it needs (`after`, a mask of bit()).
+// run() executes it in the calling task; spawn() gives it its own
+// task on core 0 and returns at once. A step waits for its
+// dependencies' bits (one FreeRTOS event group) before it starts.
+//
+// setup() runs what a tote needs (settings, lanes, backend hooks)
+// on the loop task and spawns the slow network bring-up (Wi-Fi
+// radio, web server / mDNS, BLE stack), so the station doses while
+// networking is still coming up. Code that needs a step (the WS
+// client, communicationTask) checks done() or wait()s for it.
+//
+// Every step's start / end (since power-up) is logged and exported
+// on /metrics as tote_boot_step_{start,end}_seconds{step="..."};
+// ready() adds step="ready" at the first loop pass.
+// ============================================================
+#include <Arduino.h>
+
+namespace Boot {
+
+  enum Step : uint8_t {
+    CORE,       // Serial, Settings, log levels, WeightRecorder
+    LANES,      // scales on the RS-485 line, outputs, buttons
+    BACKEND,    // WS client hooks, ToteValidator / ToteUploader workers
+    NET,        // Wi-Fi radio + first connection attempt, OTA
+    WEB,        // mDNS, HTTP server, /ws
+    BLE,        // BLE stack, QR readers
+    STEP_COUNT
+  };
+
+  constexpr uint32_t bit(Step s) { return 1u << s; }
+
+  using Fn = void (*)();
+
+  /** Runs fn in the calling task once every step in `after` is done. */
+  void run(Step step, Fn fn, uint32_t after = 0);
+
+  /** Runs fn on its own task (core 0) once `after` is done; returns at once. */
+  void spawn(Step step, Fn fn, uint32_t after = 0, uint32_t stack = 4096);
+
+  /** True once the step has finished. Any task. */
+  bool done(Step step);
+
+  /** Blocks the calling task until every step in mask is done. */
+  void wait(uint32_t mask);
+
+  /** First loop pass: the station takes totes. Later calls do nothing. */
+  void ready();
+}
@@ -0,0 +1,125 @@
+// ============================================================
+// Debug.cpp  —  Niveles de log por módulo ajustables en runtime
+// ============================================================
+#include <Arduino.h>
+#include "Debug.h"
+#include "Settings.h"
+
+namespace Log {
+
+  uint8_t levels[LOG_MOD_COUNT] = {
+    LOG_DEFAULT_MAIN,
+    LOG_DEFAULT_MAREL,
+    LOG_DEFAULT_WS,
+    LOG_DEFAULT_WIFI,
+    LOG_DEFAULT_CTRL,
+    LOG_DEFAULT_BLE,
+  };
+
+  static const char* const NAMES[LOG_MOD_COUNT] = {
+    "main", "marel", "ws", "wifi", "ctrl", "ble"
+  };
+
+  static const uint8_t COMPILED[LOG_MOD_COUNT] = {
+    DEBUG_MAIN, DEBUG_MAREL, DEBUG_WS, DEBUG_WIFI, DEBUG_CTRL, DEBUG_BLE
+  };
+
+  void load() {
+    // Settings::load() ya los leyó de NVS (o puso los defaults)
+    const Settings::Snapshot s = Settings::snapshot();
+    memcpy(levels, s.log_lv, sizeof(levels));
+    LOG_MAIN("[Log] main=%u marel=%u ws=%u wifi=%u ctrl=%u ble=%u\n",
+             levels[LOG_MOD_MAIN], levels[LOG_MOD_MAREL], levels[LOG_MOD_WS],
+             levels[LOG_MOD_WIFI], levels[LOG_MOD_CTRL], levels[LOG_MOD_BLE]);
+  }
+
+  const char* moduleName(uint8_t module) {
+    return module < LOG_MOD_COUNT ? NAMES[module] : "?";
+  }
+
+  int moduleFromName(const char* name) {
+    if (!name) return -1;
+    for (uint8_t i = 0; i < LOG_MOD_COUNT; i++) {
+      if (strcasecmp(name, NAMES[i]) == 0) return i;
+    }
+    return -1;
+  }
+
+  uint8_t compiledLevel(uint8_t module) {
+    return module < LOG_MOD_COUNT ? COMPILED[module] : LOG_LVL_OFF;
+  }
+
+  bool setLevel(const char* module, uint8_t level, bool persist) {
+    const int mod = moduleFromName(module);
+    if (mod < 0 || level > LOG_LVL_VERBOSE) {
+      LOG_ERR("Invalid log level '%s' = %u\n", module ? module : "(null)", level);
+      return false;
+    }
+    levels[mod] = level;
+    if (level > COMPILED[mod]) {
+      // Se acepta igual: queda guardado para un build con piso más alto
+      Serial.printf("[Log] %s=%u (compiled max %u, extra output stripped)\n",
+                    NAMES[mod], level, COMPILED[mod]);
+    } else {
+      Serial.printf("[Log] %s=%u\n", NAMES[mod], level);
+    }
+    // En el snapshot de Settings: a NVS con el resto, SETTINGS_SAVE_DELAY_MS después
+    if (persist) Settings::update([&](Settings::Snapshot& s) { s.log_lv[mod] = level; });
+    return true;
+  }
+
+  void toJson(char* out, size_t len) {
+    size_t n = snprintf(out, len, "{");
+    for (uint8_t i = 0; i < LOG_MOD_COUNT && n < len; i++) {
+      n += snprintf(out + n, len - n, "%s\"%s\":{\"level\":%u,\"max\":%u}",
+                    i ? "," : "", NAMES[i], levels[i], COMPILED[i]);
+    }
+    if (n < len) snprintf(out + n, len - n, "}");
+  }
+
+  void handleCommand(const char* line) {
+    char mod[12] = {0};
+    unsigned level = 0;
+    const int fields = sscanf(line, "log %11s %u", mod, &level);
+
+    if (fields == 2) {
+      setLevel(mod, (uint8_t)level);
+      return;
+    }
+    if (fields == 1 && strcmp(mod, "bench") == 0) {
+      benchmark();
+      return;
+    }
+    char json[256];
+    toJson(json, sizeof(json));
+    Serial.printf("[Log] levels %s\n", json);
+    Serial.println("[Log] usage: log <main|marel|ws|wifi|ctrl|ble> <0|1|2> | log bench");
+  }
+
+  void benchmark() {
+    const uint32_t N = 10000;
+    const uint8_t saved = levels[LOG_MOD_MAREL];
+    levels[LOG_MOD_MAREL] = LOG_LVL_OFF;
+    volatile float val = 1.23f;
+
+    // Referencia: el mismo bucle sin LOG (equivale a un piso de compilación 0)
+    uint32_t t0 = ESP.getCycleCount();
+    for (uint32_t i = 0; i < N; i++) {
+      __asm__ __volatile__("" ::: "memory");
+    }
+    const uint32_t base = ESP.getCycleCount() - t0;
+
+    // LOG compilado pero desactivado en runtime
+    t0 = ESP.getCycleCount();
+    for (uint32_t i = 0; i < N; i++) {
+      __asm__ __volatile__("" ::: "memory");
+      LOG_MAREL_V("bench %.2f\n", (float)val);
+    }
+    const uint32_t gated = ESP.getCycleCount() - t0;
+    levels[LOG_MOD_MAREL] = saved;
+
+    Serial.printf("[Log] bench: stripped %.2f cyc/call, runtime-off %.2f cyc/call (+%.2f)\n",
+                  (float)base / N, (float)gated / N, (float)(gated - base) / N);
+  }
+
+} // namespace Log
@@ -1,29 +1,124 @@
 #pragma once
+#include <stdint.h>
+#include <stddef.h>
 // ================================================================
 // Debug.h — Configuración centralizada de debug por módulo
 //
-// Cambia el valor a 1 para activar o 0 para desactivar el debug
-// de cada módulo individualmente. Los errores críticos (LOG_ERR)
-// siempre se muestran sin importar el valor de los flags.
+// Cada módulo tiene dos niveles:
+//   • DEBUG_<MOD>  – nivel máximo COMPILADO (piso en compilación).
+//                    Todo lo que esté por encima se elimina del binario.
+//                    Se puede sobreescribir con -DDEBUG_<MOD>=n.
+//   • Log::levels  – nivel ACTIVO en runtime (web, WS, consola serie),
+//                    persistido en NVS vía Settings (snapshot, "log_lv").
+//
+// Con el módulo desactivado en runtime, cada LOG_* cuesta una lectura
+// de un byte y un salto. Los errores críticos (LOG_ERR) siempre se
+// muestran sin importar el valor de los flags.
 // ================================================================
 
-// ── Toggles por módulo ──────────────────────────────────────────
-#define DEBUG_MAIN    1   // main.cpp      – máquina de estados, bombas
-#define DEBUG_MAREL   0   // marel.cpp     – Modbus RTU registros/coils
-#define DEBUG_WS      0   // websocket_client.cpp – eventos WS (muy ruidoso)
-#define DEBUG_WIFI    0   // WIFI.cpp      – servidor HTTP / OTA / reconexión
-#define DEBUG_CTRL    0   // Controller.cpp – peso, I/O, estado interno
-#define DEBUG_BLE     1   // BLEQRClient   – BLE scan/connect/QR
+// ── Niveles ─────────────────────────────────────────────────────
+#define LOG_LVL_OFF      0
+#define LOG_LVL_INFO     1   // LOG_<MOD>()   – eventos normales
+#define LOG_LVL_VERBOSE  2   // LOG_<MOD>_V() – trazas ruidosas (registros, pesos crudos)
+
+// Compilar con -DLOG_STRIP_ALL para quitar todo salvo LOG_ERR (ver env *-nolog)
+#ifdef LOG_STRIP_ALL
+  #define LOG_COMPILE_DEFAULT LOG_LVL_OFF
+#else
+  #define LOG_COMPILE_DEFAULT LOG_LVL_VERBOSE
+#endif
+
+// ── Piso en compilación por módulo ──────────────────────────────
+#ifndef DEBUG_MAIN
+#define DEBUG_MAIN    LOG_COMPILE_DEFAULT   // main.cpp      – máquina de estados, bombas
+#endif
+#ifndef DEBUG_MAREL
+#define DEBUG_MAREL   LOG_COMPILE_DEFAULT   // marel.cpp     – Modbus RTU registros/coils
+#endif
+#ifndef DEBUG_WS
+#define DEBUG_WS      LOG_COMPILE_DEFAULT   // websocket_client.cpp – eventos WS (muy ruidoso)
+#endif
+#ifndef DEBUG_WIFI
+#define DEBUG_WIFI    LOG_COMPILE_DEFAULT   // WIFI.cpp      – servidor HTTP / OTA / reconexión
+#endif
+#ifndef DEBUG_CTRL
+#define DEBUG_CTRL    LOG_COMPILE_DEFAULT   // Controller.cpp – peso, I/O, estado interno
+#endif
+#ifndef DEBUG_BLE
+#define DEBUG_BLE     LOG_COMPILE_DEFAULT   // BLEQRClient   – BLE scan/connect/QR
+#endif
+
+// ── Nivel por defecto en runtime (si no hay nada guardado en NVS) ─
+#define LOG_DEFAULT_MAIN    LOG_LVL_INFO
+#define LOG_DEFAULT_MAREL   LOG_LVL_OFF
+#define LOG_DEFAULT_WS      LOG_LVL_OFF
+#define LOG_DEFAULT_WIFI    LOG_LVL_OFF
+#define LOG_DEFAULT_CTRL    LOG_LVL_OFF
+#define LOG_DEFAULT_BLE     LOG_LVL_INFO
+
+enum LogModule : uint8_t {
+  LOG_MOD_MAIN,
+  LOG_MOD_MAREL,
+  LOG_MOD_WS,
+  LOG_MOD_WIFI,
+  LOG_MOD_CTRL,
+  LOG_MOD_BLE,
+  LOG_MOD_COUNT
+};
+
+namespace Log {
+  /** Nivel activo por módulo. Leído directamente por las macros LOG_*. */
+  extern uint8_t levels[LOG_MOD_COUNT];
+
+  /** Restaura niveles desde NVS (o defaults). Llamar tras Settings::load(). */
+  void load();
+
+  /** Cambia el nivel de un módulo ("main", "marel", ...). persist=true → Settings (NVS diferido). Cualquier task. */
+  bool setLevel(const char* module, uint8_t level, bool persist = true);
+
+  const char* moduleName(uint8_t module);
+  int         moduleFromName(const char* name);   ///< -1 si no existe
+  uint8_t     compiledLevel(uint8_t module);      ///< piso DEBUG_<MOD>
+
+  /** Niveles actuales como JSON: {"main":{"level":1,"max":2},...} */
+  void toJson(char* out, size_t len);
+
+  /**
+   * Comando de consola serie:
+   *   "log"               → lista niveles
+   *   "log <mod> <nivel>" → cambia y persiste
+   *   "log bench"         → mide ciclos de un LOG_* desactivado
+   */
+  void handleCommand(const char* line);
+
+  /** Ciclos de CPU por llamada: LOG desactivado en runtime vs. eliminado en compilación. */
+  void benchmark();
+}
 
 // ── Macros por módulo ────────────────────────────────────────────
 // Uso:  LOG_MAIN("Mensaje\n")
 //       LOG_MAIN("Peso: %.2f kg\n", val)
-#define LOG_MAIN(fmt, ...)   do { if (DEBUG_MAIN)  Serial.printf(fmt, ##__VA_ARGS__); } while(0)
-#define LOG_MAREL(fmt, ...)  do { if (DEBUG_MAREL) Serial.printf(fmt, ##__VA_ARGS__); } while(0)
-#define LOG_WS(fmt, ...)     do { if (DEBUG_WS)    Serial.printf(fmt, ##__VA_ARGS__); } while(0)
-#define LOG_WIFI(fmt, ...)   do { if (DEBUG_WIFI)  Serial.printf(fmt, ##__VA_ARGS__); } while(0)
-#define LOG_CTRL(fmt, ...)   do { if (DEBUG_CTRL)  Serial.printf(fmt, ##__VA_ARGS__); } while(0)
-#define LOG_BLE(fmt, ...)    do { if (DEBUG_BLE)   Serial.printf(fmt, ##__VA_ARGS__); } while(0)
+//       LOG_MAREL_V("Regs[%04X, %04X]\n", r0, r1)   // solo en nivel VERBOSE
+//
+// (lvl) <= DEBUG_<MOD> es constante: si es falso el compilador elimina
+// la llamada completa, incluidos los argumentos y el string de formato.
+#define LOG_ENABLED(mod, lvl)  ((lvl) <= DEBUG_##mod && Log::levels[LOG_MOD_##mod] >= (lvl))
+#define LOG_AT(mod, lvl, fmt, ...) \
+  do { if (LOG_ENABLED(mod, lvl)) Serial.printf(fmt, ##__VA_ARGS__); } while(0)
+
+#define LOG_MAIN(fmt, ...)     LOG_AT(MAIN,  LOG_LVL_INFO,    fmt, ##__VA_ARGS__)
+#define LOG_MAREL(fmt, ...)    LOG_AT(MAREL, LOG_LVL_INFO,    fmt, ##__VA_ARGS__)
+#define LOG_WS(fmt, ...)       LOG_AT(WS,    LOG_LVL_INFO,    fmt, ##__VA_ARGS__)
+#define LOG_WIFI(fmt, ...)     LOG_AT(WIFI,  LOG_LVL_INFO,    fmt, ##__VA_ARGS__)
+#define LOG_CTRL(fmt, ...)     LOG_AT(CTRL,  LOG_LVL_INFO,    fmt, ##__VA_ARGS__)
+#define LOG_BLE(fmt, ...)      LOG_AT(BLE,   LOG_LVL_INFO,    fmt, ##__VA_ARGS__)
+
+#define LOG_MAIN_V(fmt, ...)   LOG_AT(MAIN,  LOG_LVL_VERBOSE, fmt, ##__VA_ARGS__)
+#define LOG_MAREL_V(fmt, ...)  LOG_AT(MAREL, LOG_LVL_VERBOSE, fmt, ##__VA_ARGS__)
+#define LOG_WS_V(fmt, ...)     LOG_AT(WS,    LOG_LVL_VERBOSE, fmt, ##__VA_ARGS__)
+#define LOG_WIFI_V(fmt, ...)   LOG_AT(WIFI,  LOG_LVL_VERBOSE, fmt, ##__VA_ARGS__)
+#define LOG_CTRL_V(fmt, ...)   LOG_AT(CTRL,  LOG_LVL_VERBOSE, fmt, ##__VA_ARGS__)
+#define LOG_BLE_V(fmt, ...)    LOG_AT(BLE,   LOG_LVL_VERBOSE, fmt, ##__VA_ARGS__)
 
 // Siempre visible — errores críticos (no se puede desactivar)
 #define LOG_ERR(fmt, ...)    Serial.printf("[ERR] " fmt, ##__VA_ARGS__)
@@ -0,0 +1,805 @@
+// ============================================================
+// Lane.cpp  —  Tote cycle of one filling position
+//
+// Also built natively (HAL_HOST): the simulator (src/sim) runs
+// this same state machine over Station<HostBoard>.
+// ============================================================
+#ifdef HAL_HOST
+#include "host/LaneHost.h"
+#else
+#include "main.h"
+#endif
+#include "Lane.h"
+#include "Settings.h"
+#include "Debug.h"
+#include "Metrics.h"
+#include "ToteTrace.h"
+#include "Stats.h"
+#include "WeightRecorder.h"
+#include "ToteValidator.h"
+#include "ToteUploader.h"
+
+// Lane logs: tagged with the station when the EdgeBox runs several
+#if LANE_COUNT > 1
+#define LOG_LANE(fmt, ...) LOG_MAIN("[%s] " fmt, _cfg.station, ##__VA_ARGS__)
+#define ERR_LANE(fmt, ...) LOG_ERR("[%s] " fmt, _cfg.station, ##__VA_ARGS__)
+#else
+#define LOG_LANE(fmt, ...) LOG_MAIN(fmt, ##__VA_ARGS__)
+#define ERR_LANE(fmt, ...) LOG_ERR(fmt, ##__VA_ARGS__)
+#endif
+
+static const uint32_t ICE_PULSE_MS       = Dosing::ICE_PULSE_MS;   // start / stop contact pulse
+static const uint32_t MANUAL_RUN_MS      = 5000;   // manual ice / water buttons
+static const uint32_t BOOT_STOP_PULSE_MS = 500;    // auger stop at power-up
+
+// Deadline helpers (0 = not armed)
+static bool due(uint32_t deadline, uint32_t now) {
+  return deadline != 0 && (int32_t)(now - deadline) >= 0;
+}
+
+static uint32_t after(uint32_t ms) {
+  const uint32_t t = millis() + ms;
+  return t ? t : 1;
+}
+
+Lane::Lane(uint8_t index, const LaneConfig& cfg)
+    : _index(index),
+      _cfg(cfg),
+      _hw(cfg.slave),
+      _io{*this},
+      _dosing(_io),
+      _stage1(2, [this] { initStage1(); }, [this] { destroyStage1(); }),
+      _stage2(2, [this] { LOG_LANE("\n=== Stage 2: Dispensing Ice ===\n"); }, [this] { destroyStage2(); }),
+      _stage3(2, [this] { LOG_LANE("Stage 3 Tote Ready\n"); }, [this] { destroyStage3(); }),
+      _buttons{Button(cfg.stop_io), Button(cfg.start_io), Button(cfg.manual_ice_io), Button(cfg.manual_water_io)} {}
+
+void Lane::begin() {
+  _hw.begin();
+  _hw.scale.setPoll(Hal::Poll::IDLE);   // IDLE: ToteDetector's readings
+
+  const uint8_t outputs[] = {_cfg.water_pump, _cfg.ice_pump, _cfg.ice_stop};
+  _hw.setUpOutputs(outputs, sizeof(outputs));  // GPIO_MODE_OUTPUT, inician en LOW
+
+  const uint8_t inputs[LANE_BTNS] = {_cfg.stop_io, _cfg.start_io, _cfg.manual_ice_io, _cfg.manual_water_io};
+  for (uint8_t i = 0; i < LANE_BTNS; i++) {
+    if (inputs[i] != LANE_NO_IO) _buttons[i].begin();
+  }
+
+  // Ice auger to a known state: stop contact pulse, ended by task()
+  // (no delay(): boot goes on, and with several lanes the pulses overlap)
+  out(_cfg.ice_stop, HIGH);
+  _iceStopPulseEnd = after(BOOT_STOP_PULSE_MS);
+
+  LOG_LANE("Lane %u: station '%s', Marel slave %u\n", _index, _cfg.station, _cfg.slave);
+}
+
+// ── Loop ──────────────────────────────────────────────────────────────────────
+
+void Lane::task() {
+  _hw.task();  // Modbus (shared bus)
+
+  const uint32_t now = millis();
+  if (due(_iceStartPulseEnd, now)) {
+    _iceStartPulseEnd = 0;
+    out(_cfg.ice_pump, LOW);
+    LOG_CTRL("Ice pump start pulse ended\n");
+  }
+  if (due(_iceStopPulseEnd, now)) {
+    _iceStopPulseEnd = 0;
+    out(_cfg.ice_stop, LOW);
+    LOG_CTRL("Ice pump stop pulse ended\n");
+  }
+  if (due(_manualIceOff, now)) {
+    _manualIceOff = 0;
+    stopIcePump();
+    LOG_CTRL("Ice pump turned off\n");
+  }
+  if (due(_manualWaterOff, now)) {
+    _manualWaterOff = 0;
+    waterPump(false);
+    LOG_CTRL("Water pump turned off\n");
+  }
+}
+
+void Lane::update() {
+  pollValidation();
+
+  switch (_state) {
+    case ToteState::IDLE:
+      // Wait for weight to be greater than MIN_WEIGHT
+      onIdle();
+      break;
+
+    case ToteState::DISPENSING_ICE:
+      onIceFilling();
+      break;
+
+    case ToteState::SETTLING_ICE:
+      onSettlingIce();
+      break;
+
+    case ToteState::DISPENSING_WATER:
+      onWaterFilling();
+      break;
+
+    case ToteState::WAITING_TOTE_ID:
+      onWaitingToteId();
+      break;
+
+    case ToteState::COMPLETED:
+      onToteReady();
+      break;
+
+    case ToteState::CANCELED:
+      onCanceled();
+      break;
+
+    case ToteState::ERROR:
+      // TODO: show error, wait for intervention
+      break;
+  }
+}
+
+void Lane::pollButtons() {
+  const uint8_t inputs[LANE_BTNS] = {_cfg.stop_io, _cfg.start_io, _cfg.manual_ice_io, _cfg.manual_water_io};
+  const button_type types[LANE_BTNS] = {STOP, START, MANUAL_ICE, MANUAL_WATER};
+  for (uint8_t i = 0; i < LANE_BTNS; i++) {
+    if (inputs[i] != LANE_NO_IO && _buttons[i].released()) {
+      press(types[i]);
+      return;
+    }
+  }
+}
+
+void Lane::sampleWeight() {
+  const uint32_t now = millis();
+
+  const float current_weight = weight();
+  _latest = {now, current_weight};
+  if (isnan(current_weight)) {
+    LOG_LANE("Weight reading is NaN, skipping broadcast\n");
+    return;
+  }
+  const float DELTA = 0.02f;  // 20 g minimum change
+  bool weight_changed = isnan(_lastBroadcastKg) || fabs(current_weight - _lastBroadcastKg) >= DELTA;
+  bool time_elapsed   = (now - _lastBroadcastMs) >= 1000;
+
+  if (weight_changed || time_elapsed) {
+    _lastBroadcastKg = current_weight;
+    _lastBroadcastMs = now;
+    wsClient.sendWeight(current_weight, _cfg.station);
+  }
+}
+
+void Lane::showState(uint8_t tick) {
+  if (_cfg.indicator == LANE_NO_IO) return;
+  uint8_t level = LOW;
+  switch (_state) {
+    case ToteState::IDLE:
+      level = LOW;                              // Apagado
+      break;
+    case ToteState::DISPENSING_ICE:
+    case ToteState::DISPENSING_WATER:
+      level = (tick % 2) ? HIGH : LOW;          // Parpadeo rápido 500 ms
+      break;
+    case ToteState::SETTLING_ICE:
+      level = (tick % 4 < 2) ? HIGH : LOW;     // Parpadeo medio 1 s (bomba apagada, asentando)
+      break;
+    case ToteState::WAITING_TOTE_ID:
+      level = (tick % 8 < 4) ? HIGH : LOW;     // Parpadeo lento 1 s
+      break;
+    case ToteState::COMPLETED:
+      level = HIGH;                             // Encendido fijo
+      break;
+    case ToteState::CANCELED:
+    case ToteState::ERROR: {                    // Triple flash + 2 s OFF
+      uint8_t p = tick % 20;                   // Ciclo 5 s
+      level = (p < 6 && p % 2 == 0) ? HIGH : LOW;
+      break;
+    }
+  }
+  out(_cfg.indicator, level);
+}
+
+// ── Outputs ───────────────────────────────────────────────────────────────────
+
+void Lane::startIcePump() {
+  out(_cfg.ice_pump, HIGH);
+  _iceStartPulseEnd = after(ICE_PULSE_MS);
+}
+
+void Lane::stopIcePump() {
+  out(_cfg.ice_stop, HIGH);
+  _iceStopPulseEnd = after(ICE_PULSE_MS);
+}
+
+void Lane::waterPump(bool on) {
+  out(_cfg.water_pump, on ? HIGH : LOW);
+}
+
+// ── Dosing engine (src/core/Dosing.h) ─────────────────────────────────────────
+// The engine decides when each pump switches; this is its view of the outputs.
+// The host simulator (src/sim) turns the HostIo writes into plant commands.
+void Lane::Io::water(bool on) {
+  lane.waterPump(on);
+  Trace::event(lane._tote.trace, on ? "water_pump_on" : "water_pump_off");
+}
+
+void Lane::Io::ice(bool on) {
+  if (on) lane.startIcePump();
+  else    lane.stopIcePump();
+  Trace::event(lane._tote.trace, on ? "ice_pump_on" : "ice_pump_off");
+}
+
+// ── State ─────────────────────────────────────────────────────────────────────
+
+const char* Lane::stateName(ToteState state) {
+  switch (state) {
+    case ToteState::IDLE:             return "IDLE";
+    case ToteState::DISPENSING_ICE:   return "DISPENSING_ICE";
+    case ToteState::SETTLING_ICE:     return "SETTLING_ICE";
+    case ToteState::DISPENSING_WATER: return "DISPENSING_WATER";
+    case ToteState::WAITING_TOTE_ID:  return "WAITING_TOTE_ID";
+    case ToteState::COMPLETED:        return "COMPLETED";
+    case ToteState::CANCELED:         return "CANCELED";
+    case ToteState::ERROR:            return "ERROR";
+  }
+  return "?";
+}
+
+bool Lane::acceptsId() const {
+  switch (_state) {
+    case ToteState::DISPENSING_WATER:
+    case ToteState::DISPENSING_ICE:
+    case ToteState::SETTLING_ICE:
+    case ToteState::WAITING_TOTE_ID:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Every ToteState transition goes through here so the cycle trace sees it
+void Lane::setState(ToteState state) {
+  // WS "start" skips start(), so the trace may not have been opened yet
+  if (_state == ToteState::IDLE && state == ToteState::DISPENSING_WATER) {
+    if (_tote.trace.count == 0) Trace::begin(_tote.trace);
+    WeightRecorder::start(_index);
+    _startedMs = millis();
+  }
+  // Whatever started the cycle, the tote now on the scale is not a new one,
+  // and an ID validated for the previous tote doesn't belong to it
+  if (_state == ToteState::IDLE && state != ToteState::IDLE) {
+    _detector.disarm();
+    ToteValidator::reset(_index);
+  }
+  if (state == ToteState::WAITING_TOTE_ID) _qrPolledMs = 0;
+  // Dosing lanes get the line first (ScaleBus); weight() reads the poll
+  switch (state) {
+    case ToteState::DISPENSING_WATER:
+    case ToteState::DISPENSING_ICE:
+    case ToteState::SETTLING_ICE:
+      _hw.scale.setPoll(Hal::Poll::ACTIVE);
+      break;
+    default:
+      _hw.scale.setPoll(Hal::Poll::IDLE);
+      break;
+  }
+  _state = state;
+  if (state != ToteState::IDLE) Trace::state(_tote.trace, stateName(state));
+}
+
+void Lane::onIdle() {
+  const Settings::Snapshot settings = Settings::snapshot();
+  if (!settings.auto_start) return;
+
+  // One detector step per new broadcast reading (every 200 ms)
+  if (_latest.ms == _detectorSeen) return;
+  _detectorSeen = _latest.ms;
+
+  ToteDetector::Config cfg = _detector.config();
+  cfg.min_kg  = settings.min_w;
+  cfg.band_kg = AUTO_START_BAND_KG;
+  cfg.hold_ms = AUTO_START_HOLD_MS;
+  _detector.configure(cfg);
+
+  switch (_detector.sample(_latest.ms, _latest.kg)) {
+    case ToteDetector::Event::DETECTED:
+      Metrics::inc(Metrics::TOTE_AUTO_STARTS);
+      LOG_LANE("\n=== Tote detected: %.2f kg stable (%lu ms from load step) ===\n",
+               _detector.weightKg(), (unsigned long)_detector.loadingMs());
+      startTote(_detector.weightKg(), "auto_start");
+      break;
+
+    case ToteDetector::Event::REJECTED:
+      Metrics::inc(Metrics::TOTE_AUTO_REJECTS);
+      LOG_LANE("Load removed before settling (%lu ms), not a tote\n",
+               (unsigned long)_detector.loadingMs());
+      break;
+
+    default:
+      break;
+  }
+}
+
+void Lane::onWaterFilling() {
+  // Stage 1: water is now first
+  if (_stage1.getCurrentStep() == 0) {
+    _stage1.init();
+    _stage1.nextStep();
+    wsClient.sendStateChange("DISPENSING_WATER", _cfg.station);
+  }
+
+  else if (_stage1.getCurrentStep() == 1) {
+    const float current_weight = weight();
+    const float weight_delta = current_weight - _tote.initial_weight;
+    WeightRecorder::sample(_index, current_weight);
+
+    if (_dosing.step(millis(), weight_delta) == Dosing::Phase::WATER) {
+      if (millis() - _lastPrint > 500) {
+        if (_dosing.overlapped()) {
+          LOG_LANE("Water + ice: %.2f / %.2f kg\r", weight_delta,
+                   _settings.dosing.water_kg + _settings.dosing.ice_kg);
+        } else {
+          LOG_LANE("Water: %.2f / %.2f kg\r", weight_delta, _settings.dosing.water_kg);
+        }
+        _lastPrint = millis();
+      }
+      return;
+    }
+    LOG_LANE("✓ Target water weight reached: %.2f kg\n", weight_delta);
+    _stage1.nextStep();
+  }
+
+  if (_stage1.getCurrentStep() == 2) {
+    _stage1.destroy();
+    // After water, dispense ice
+    setState(ToteState::DISPENSING_ICE);
+    wsClient.sendStateChange("DISPENSING_ICE", _cfg.station);
+    LOG_LANE("Transitioning to DISPENSING_ICE\n");
+  }
+}
+
+void Lane::onIceFilling() {
+  // Stage 2: ice is now second (after water)
+  if (_stage2.getCurrentStep() == 0) {
+    _stage2.init();
+    _stage2.nextStep();
+    wsClient.sendStateChange("DISPENSING_ICE", _cfg.station);
+  }
+
+  else if (_stage2.getCurrentStep() == 1) {
+    const float current_weight = weight();
+    WeightRecorder::sample(_index, current_weight);
+    // weight_delta is cumulative (water + ice); subtract water to get ice only
+    const float weight_delta = current_weight - _tote.initial_weight;
+    const float ice_delta = weight_delta - _settings.dosing.water_kg;
+
+    if (_dosing.step(millis(), weight_delta) == Dosing::Phase::ICE) {
+      if (millis() - _lastPrint > 500) {
+        LOG_LANE("Ice: %.2f / %.2f kg\r", ice_delta, _settings.dosing.ice_kg);
+        _lastPrint = millis();
+      }
+      return;
+    }
+    LOG_LANE("✓ Target ice weight reached: %.2f kg\n", ice_delta);
+    _stage2.nextStep();
+  }
+
+  if (_stage2.getCurrentStep() == 2) {
+    _stage2.destroy();
+    // Settling: let residual ice finish falling
+    setState(ToteState::SETTLING_ICE);
+    wsClient.sendStateChange("SETTLING_ICE", _cfg.station);
+    LOG_LANE("Transitioning to SETTLING_ICE (%u s debounce, %u fine pulses)\n",
+             _dosing.settleMs() / 1000, _dosing.pulses());
+  }
+}
+
+void Lane::onSettlingIce() {
+  // The engine started the settle timer when it stopped the ice pump.
+  // Keep sampling so the recorded curve shows the in-flight ice landing
+  const float current_weight = weight();
+  WeightRecorder::sample(_index, current_weight);
+  if (_dosing.step(millis(), current_weight - _tote.initial_weight) == Dosing::Phase::DONE) {
+    // ID scanned and validated during dosing: nothing left to wait for
+    if (toteIdValidated()) {
+      LOG_LANE("Tote ID %s already validated, skipping WAITING_TOTE_ID\n", _tote.id);
+      completeTote();
+      return;
+    }
+    setState(ToteState::WAITING_TOTE_ID);
+    wsClient.sendStateChange("WAITING_TOTE_ID", _cfg.station);
+    LOG_LANE("Transitioning to WAITING_TOTE_ID\n");
+  }
+}
+
+void Lane::onWaitingToteId() {
+  // Show prompt every 3 seconds
+  if (millis() - _lastPrompt > 3000) {
+    const bool bleReady = bleQRClient.isConnected();
+    LOG_LANE("\n╔════════════════════════════════════╗\n");
+    LOG_LANE("║   WAITING FOR TOTE ID              ║\n");
+    LOG_LANE("╠════════════════════════════════════╣\n");
+    LOG_LANE("║ Raw:   %.2f kg\n", _tote.raw_kg);
+    LOG_LANE("║ Ice:   %.2f kg\n", _tote.ice_out_kg);
+    LOG_LANE("║ Water: %.2f kg\n", _tote.water_out_kg);
+    LOG_LANE("╠════════════════════════════════════╣\n");
+    if (bleReady) {
+      LOG_LANE("║ [BLE]  QR-Reader-OUT conectado ✓   ║\n");
+      LOG_LANE("║        Leyendo QR automáticamente  ║\n");
+    } else {
+      LOG_LANE("║ [BLE]  QR-Reader-OUT no conectado  ║\n");
+    }
+    LOG_LANE("║ [WEB]  Captura con cámara del tel  ║\n");
+    const ToteValidator::Status vs = ToteValidator::status(_index);
+    if (vs != ToteValidator::Status::NONE) {
+      char id[ID_SIZE];
+      ToteValidator::currentId(_index, id, sizeof(id));
+      LOG_LANE("║ [ID]   %s: %s\n", id, ToteValidator::statusName(vs));
+    }
+    LOG_LANE("╚════════════════════════════════════╝\n\n");
+
+    if (vs == ToteValidator::Status::FAILED) {
+      // Backend unreachable earlier: try the same ID again
+      char id[ID_SIZE];
+      ToteValidator::currentId(_index, id, sizeof(id));
+      ToteValidator::submit(_index, id);
+    }
+
+    _lastPrompt = millis();
+  }
+
+  // The reader pushes each QR as it's scanned. "GET" is the fallback: once
+  // on entry (a QR scanned while no tote took it stays in the reader), then
+  // every pollIntervalMs() (3 s without notifications, slow with them)
+  if (bleQRClient.isConnected() &&
+      ToteValidator::status(_index) != ToteValidator::Status::PENDING &&
+      (_qrPolledMs == 0 || millis() - _qrPolledMs >= bleQRClient.pollIntervalMs())) {
+    bleQRClient.requestQR();
+    _qrPolledMs = millis();
+  }
+
+  // Transition to COMPLETED is handled by pollValidation()
+}
+
+void Lane::onToteReady() {
+  // Init stage 3: report the tote and hand the record to ToteUploader
+  if (_stage3.getCurrentStep() == 0) {
+    _stage3.init();
+    _stage3.nextStep();
+    wsClient.sendToteCompleted(_tote.id, _cfg.station);
+    uploadTote();
+  }
+
+  // COMPLETED shows for at least 1 s, and until the PUT has an answer.
+  // Non-blocking: the other lanes keep dosing meanwhile
+  if (_stage3.getCurrentStep() == 1) {
+    ToteUploader::Result r;
+    if (ToteUploader::takeResult(_index, r)) {
+      _putOk   = r.ok;
+      _putDone = true;
+      Trace::event(_tote.trace, r.ok ? "put_done" : "put_failed");
+    }
+    if (!_putDone || millis() - _completedMs < 1000) return;
+    LOG_LANE("Tote completed and sent!\n");
+    _stage3.nextStep();
+  }
+
+  if (_stage3.getCurrentStep() == 2) {
+    _stage3.destroy();
+    // Return to IDLE to wait for next tote
+    setState(ToteState::IDLE);
+    wsClient.sendStateChange("IDLE", _cfg.station);
+    LOG_LANE("\n=== Ready for next tote ===\n");
+  }
+}
+
+void Lane::uploadTote() {
+  // Show all completed tote data
+  LOG_LANE("\n=== Tote Summary ===\n");
+  LOG_LANE("ID:    %s\n",   _tote.id);
+  LOG_LANE("Raw:   %.2f kg\n", _tote.raw_kg);
+  LOG_LANE("Water: %.2f kg\n", _tote.water_out_kg);
+  LOG_LANE("Ice:   %.2f kg\n", _tote.ice_out_kg);
+  LOG_LANE("==================\n\n");
+
+  float temp_out = 0.0;
+
+  WeightRecorder::finish(_index, _tote.id);
+
+  _completedMs = millis();
+  _putDone = false;
+  _putOk   = false;
+  Trace::event(_tote.trace, "put_start");
+  String payload = totePayload(
+    _tote.id,
+    _tote.raw_kg,
+    _tote.ice_out_kg,
+    _tote.water_out_kg,
+    temp_out,
+    &_tote.trace
+  );
+  if (payload.length() == 0 || !ToteUploader::submit(_index, _tote.id, payload)) {
+    _putDone = true;   // nothing to wait for; reported as failed
+    Trace::event(_tote.trace, "put_failed");
+  }
+}
+
+void Lane::onCanceled() {
+  LOG_LANE("Tote canceled, cleaning up...\n");
+
+  // Stop pumps
+  _dosing.abort();
+  stopIcePump();
+  waterPump(false);
+
+  // Drop any ID check still in flight for this tote
+  ToteValidator::reset(_index);
+
+  // Clear data (keep the partial traces for /trace.json and /weight_trace)
+  Trace::archive(_tote.id, _tote.trace);
+  WeightRecorder::finish(_index, "canceled");
+  _tote = {};
+  // Back to the indicator's reading, so IDLE's weight checks see the tote again
+  _hw.clearTare();
+
+  // Reset stages without their destroy callbacks: those report a finished
+  // stage (stats, WS, backend PUT) and must not run for an aborted tote
+  _stage1.setStep(0);
+  _stage2.setStep(0);
+  _stage3.setStep(0);
+
+  // Return to IDLE
+  setState(ToteState::IDLE);
+  LOG_LANE("Returned to IDLE\n");
+}
+
+// ── Stages ────────────────────────────────────────────────────────────────────
+
+void Lane::initStage1() {
+  LOG_LANE("\n=== Stage 1: Filling Water ===\n");
+  // Software tare was taken in startTote(); whatever moved since then
+  // (≈ 0) is kept as the delta base
+  _tote.initial_weight = weightOrLast();
+  LOG_LANE("Initial weight saved: %.2f kg\n", _tote.initial_weight);
+  _settings = Settings::snapshot();
+  _dosing.begin(_settings.dosing, millis());  // water pump on
+  if (_dosing.overlapped()) {
+    // Both on: destroyStage1/2 report the engine's split of the weight
+    const Dosing::FlowModel& w = _dosing.waterFlow();
+    const Dosing::FlowModel& i = _dosing.iceFlow();
+    LOG_LANE("Overlapped dosing: water %.3f kg/s +%lu ms, ice %.3f kg/s +%lu ms\n",
+             w.kgps, (unsigned long)w.lag_ms, i.kgps, (unsigned long)i.lag_ms);
+    Trace::event(_tote.trace, "overlap");
+  }
+}
+
+void Lane::destroyStage1() {
+  // After TARE at start, weight() - initial_weight = water dispensed.
+  // Overlapped, the scale also shows ice: use the engine's flow-model split
+  const float water_out_kg = _dosing.overlapped()
+                               ? _dosing.waterKg()
+                               : weightOrLast() - _tote.initial_weight;
+  LOG_LANE("Water filled: %.2f kg%s\n", water_out_kg, _dosing.overlapped() ? " (estimated)" : "");
+
+  _tote.water_out_kg = water_out_kg;
+  Stats::onWaterDone(_tote.water_out_kg, _settings.dosing.water_kg);
+
+  wsClient.sendWaterDispensed(_tote.water_out_kg, _cfg.station);
+
+  LOG_LANE("Water filling completed\n");
+  LOG_LANE("Stage 1 destroyed\n");
+}
+
+void Lane::destroyStage2() {
+  // Cumulative delta minus water already dispensed = ice only
+  const float ice_out_kg = _dosing.overlapped()
+                             ? _dosing.iceKg()
+                             : weightOrLast() - _tote.initial_weight - _tote.water_out_kg;
+  LOG_LANE("Ice dispensed: %.2f kg%s\n", ice_out_kg, _dosing.overlapped() ? " (estimated)" : "");
+  if (_dosing.overlapped()) {
+    const int32_t saved = _dosing.savedMs();
+    LOG_LANE("Overlap: dosing took %lu ms, %ld ms saved vs sequential\n",
+             (unsigned long)_dosing.dosingMs(), (long)saved);
+    Metrics::inc(Metrics::DOSING_OVERLAPPED);
+    if (saved > 0) Metrics::inc(Metrics::DOSING_SAVED_MS, (uint32_t)saved);
+  }
+
+  _tote.ice_out_kg = ice_out_kg;
+  Stats::onIceDone(_tote.ice_out_kg, _settings.dosing.ice_kg);
+
+  wsClient.sendIceDispensed(_tote.ice_out_kg, _cfg.station);
+
+  LOG_LANE("Ice dispensing completed\n");
+  LOG_LANE("Stage 2 destroyed\n");
+}
+
+void Lane::destroyStage3() {
+  Stats::onToteDone(_tote.trace);
+  sendStats();
+
+  if (_putOk) {
+    LOG_LANE("✓ Tote data sent to backend successfully!\n");
+  } else {
+    ERR_LANE("✗ Failed to send tote data to backend\n");
+    ERR_LANE("  Data will be lost. Please check backend connection.\n");
+  }
+
+  // Reset the (software) tare
+  _hw.clearTare();
+
+  Trace::archive(_tote.id, _tote.trace);
+
+  // Clear data for next tote
+  _tote = {};
+  LOG_LANE("Stage 3 destroyed\n");
+}
+
+// ── Commands ──────────────────────────────────────────────────────────────────
+
+void Lane::press(button_type b) {
+  switch (b) {
+    case START:        start();       break;
+    case STOP:         stop();        break;
+    case MANUAL_ICE:   manualIce();   break;
+    case MANUAL_WATER: manualWater(); break;
+    default:                          break;
+  }
+}
+
+void Lane::start() {
+  if (_state != ToteState::IDLE) {
+    LOG_LANE("Already in process\n");
+    return;
+  }
+
+  LOG_LANE("\n=== System Started ===\n");
+  const Settings::Snapshot settings = Settings::snapshot();
+  LOG_LANE("Minimum weight required: %.2f kg\n", settings.min_w);
+
+  const float current_weight = weight();
+
+  if (current_weight >= settings.min_w) {
+    startTote(current_weight, "start");
+  } else {
+    LOG_LANE("Weight too low (%.2f kg), waiting for tote\n", current_weight);
+  }
+}
+
+void Lane::startRemote() {
+  if (_state != ToteState::IDLE) return;
+  setState(ToteState::DISPENSING_WATER);
+  wsClient.sendStateChange("DISPENSING_WATER", _cfg.station);
+}
+
+// START button or ToteDetector: tote on the scale, weight checked
+void Lane::startTote(float raw_kg, const char* trace_event) {
+  // Store total weight as-is — backend calculates fish_kg
+  _tote.raw_kg = raw_kg;
+  LOG_LANE("Raw weight (fish + tote + inbound residues): %.2f kg\n", _tote.raw_kg);
+
+  Trace::begin(_tote.trace);
+  Trace::event(_tote.trace, trace_event);
+
+  // Software tare at the weight just read so dispensing deltas start from
+  // zero: no Modbus command, no settle wait
+  _hw.setTare(raw_kg);
+  _lastKg = 0;
+  Trace::event(_tote.trace, "tare_done");
+
+  setState(ToteState::DISPENSING_WATER);
+  LOG_LANE("Transitioning to DISPENSING_WATER\n");
+}
+
+void Lane::stop() {
+  LOG_LANE("\n=== STOP pressed ===\n");
+
+  // Stop all pumps
+  stopIcePump();
+  waterPump(false);
+  _manualIceOff   = 0;
+  _manualWaterOff = 0;
+
+  // Cancel current process
+  setState(ToteState::CANCELED);
+}
+
+void Lane::manualIce() {
+  LOG_LANE("Manual Ice\n");
+  startIcePump();
+  _manualIceOff = after(MANUAL_RUN_MS);
+}
+
+void Lane::manualWater() {
+  LOG_LANE("Manual Water\n");
+  waterPump(true);
+  _manualWaterOff = after(MANUAL_RUN_MS);
+}
+
+// ── Tote ID ───────────────────────────────────────────────────────────────────
+
+void Lane::setToteId(const char* id) {
+  if (strlen(id) >= ID_SIZE) {
+    ERR_LANE("Tote ID is too long\n");
+    return;
+  }
+
+  strncpy(_tote.id, id, ID_SIZE);
+  _tote.id[ID_SIZE - 1] = '\0'; // Ensure null termination
+  LOG_LANE("Tote ID set to: %s\n", _tote.id);
+}
+
+bool Lane::submitToteId(const char* id, uint32_t scannedMs) {
+  // Accepted from START on, so the backend check overlaps dosing.
+  // Only hand the ID over: the check runs on ToteValidator's task.
+  if (!acceptsId()) {
+    LOG_LANE("Cannot set ID, no tote in process (%s)\n", stateName());
+    return false;
+  }
+
+  if (!ToteValidator::submit(_index, id)) return false;
+  _qrScannedMs = scannedMs;
+  Trace::event(_tote.trace, "qr_received");
+  LOG_LANE("Tote ID '%s' received in %s, validating in background\n", id, stateName());
+  return true;
+}
+
+// Applies a finished background validation to the current tote
+void Lane::pollValidation() {
+  ToteValidator::Result r;
+  if (!ToteValidator::takeResult(_index, r)) return;
+
+  switch (r.status) {
+    case ToteValidator::Status::VALID:
+      Trace::event(_tote.trace, "validation_ok");
+      LOG_LANE("Tote ID validated successfully! (%lu ms)\n", (unsigned long)r.latency_ms);
+      if (_qrScannedMs) {
+        Metrics::observe(Metrics::QR_TO_ID_US, (millis() - _qrScannedMs) * 1000);
+        _qrScannedMs = 0;
+      }
+
+      // Copy ID to tote struct
+      memset(_tote.id, 0, sizeof(_tote.id));
+      strncpy(_tote.id, r.id, sizeof(_tote.id) - 1);
+      LOG_LANE("Tote ID set to: %s\n", _tote.id);
+
+      // Raw weight from inbound replaces the one read at START
+      if (!isnan(r.raw_kg)) _tote.raw_kg = r.raw_kg;
+
+      // Send validation via WebSocket
+      wsClient.sendToteValidated(_tote.id, _cfg.station);
+
+      // Still dosing: onSettlingIce() completes as soon as it's done
+      if (_state == ToteState::WAITING_TOTE_ID) completeTote();
+      break;
+
+    case ToteValidator::Status::REJECTED:
+      Trace::event(_tote.trace, "validation_rejected");
+      ERR_LANE("ERROR: Tote ID not found in backend!\n");
+      ERR_LANE("Please check the ID and try again.\n");
+      wsClient.sendError("Tote ID not found in backend", _cfg.station);
+      break;
+
+    case ToteValidator::Status::FAILED:
+      Trace::event(_tote.trace, "validation_failed");
+      wsClient.sendError("Tote ID could not be validated (backend unreachable), retrying", _cfg.station);
+      break;
+
+    default:
+      break;
+  }
+}
+
+// Backend accepted the latest scanned ID and it's already in the tote record
+bool Lane::toteIdValidated() {
+  char id[ID_SIZE];
+  ToteValidator::currentId(_index, id, sizeof(id));
+  return ToteValidator::status(_index) == ToteValidator::Status::VALID &&
+         _tote.id[0] != '\0' && strcmp(id, _tote.id) == 0;
+}
+
+void Lane::completeTote() {
+  setState(ToteState::COMPLETED);
+  wsClient.sendStateChange("COMPLETED", _cfg.station);
+}
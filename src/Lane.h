@@ -0,0 +1,190 @@
+#pragma once
+// ============================================================
+// Lane  —  One filling position: scale, pumps, buttons, tote cycle
+//
+// Everything that used to be main.cpp's single tote: its ToteState,
+// the three Stages, the dosing engine (with its learned flow
+// models), auto-start detection, pump pulse timers, the tote record
+// and its trace. One EdgeBox runs LANE_COUNT of these side by side
+// (LANE_TABLE in config.h); each has
+//   - its own Marel on the shared RS-485 line (Station → MarelClient
+//     handle on ScaleBus, slave ID from the table),
+//   - its own outputs, buttons and state indicator,
+//   - its own "station" on the backend WebSocket,
+//   - its own ToteValidator / WeightRecorder slot (index()).
+// Settings (targets, strategy) and Stats are station-wide.
+//
+// Called from the loop task only, submitToteId() included: BLE scans
+// arrive through bleQRClient.loop()'s ring and WS messages are handled
+// there too. It only hands the ID to ToteValidator.
+// ============================================================
+#include <Arduino.h>
+#include <Button.h>
+#include "Types.h"                  // ToteState
+#include "Stage.h"
+#include "hal/Station.h"
+#include "core/Dosing.h"
+#include "core/ToteDetector.h"
+#include "Settings.h"
+
+struct LaneConfig {
+  const char* station;      // WS "station" field
+  uint8_t slave;            // Marel slave ID on the shared line
+  uint8_t water_pump;
+  uint8_t ice_pump;         // start pulse
+  uint8_t ice_stop;         // stop pulse
+  uint8_t indicator;        // cycle state (INDICATOR_1 role), LANE_NO_IO: none
+  uint8_t start_io;         // buttons, LANE_NO_IO: none
+  uint8_t stop_io;
+  uint8_t manual_ice_io;
+  uint8_t manual_water_io;
+};
+
+class Lane {
+public:
+  Lane(uint8_t index, const LaneConfig& cfg);
+
+  /** Scale, outputs and buttons. Call once in setup(). */
+  void begin();
+
+  /** Modbus and pump pulse timers; every loop pass. */
+  void task();
+
+  /** Tote state machine; every loop pass. */
+  void update();
+
+  /** Physical buttons (buttons_routine, 20 ms). */
+  void pollButtons();
+
+  /** Weight for the WS broadcast and auto-start (broadcast_weight_routine, 200 ms). */
+  void sampleWeight();
+
+  /** Cycle state on the lane's indicator (indicator_task, 250 ms ticks). */
+  void showState(uint8_t tick);
+
+  // ── Commands (buttons, serial, WS) ──────────────────────────
+  void press(button_type b);
+  void start();          // START: weight check, then dosing
+  void startRemote();    // WS "start": no weight check
+  void stop();           // STOP: pumps off, cycle canceled
+  void manualIce();
+  void manualWater();
+
+  /**
+   * Scanned / typed tote ID (loop task). False if no tote in process.
+   * scannedMs: millis() of the scan when known (tote_qr_to_id_seconds).
+   */
+  bool submitToteId(const char* id, uint32_t scannedMs = 0);
+  /** Writes the ID into the tote record without validation. */
+  void setToteId(const char* id);
+
+  // Service (serial console, IDLE only)
+  bool hardwareTare()              { return _hw.hardwareTare(); }
+  bool hardwareClearTare()         { return _hw.hardwareClearTare(); }
+#ifndef HAL_HOST
+  void benchmarkScale(uint16_t n)  { _hw.scale.marel().benchmark(n); }
+#endif
+
+  uint8_t     index() const      { return _index; }
+  const char* station() const    { return _cfg.station; }
+  ToteState   state() const      { return _state; }
+  const char* stateName() const  { return stateName(_state); }
+  /** A tote is in process and can take an ID (START → WAITING_TOTE_ID). */
+  bool        acceptsId() const;
+  /** millis() at START of the current cycle. */
+  uint32_t    startedMs() const  { return _startedMs; }
+
+  static const char* stateName(ToteState state);
+
+  /** Scale, I/O and clock (host: the simulator drives the HostBoard). */
+  Hal::Station<Hal::Board>& station() { return _hw; }
+
+private:
+  // The dosing engine's view of this lane's pumps
+  struct Io {
+    Lane& lane;
+    void water(bool on);
+    void ice(bool on);
+  };
+
+  enum { BTN_STOP, BTN_START, BTN_ICE, BTN_WATER, LANE_BTNS };
+
+  void setState(ToteState state);
+  void startTote(float raw_kg, const char* trace_event);
+  void startIcePump();
+  void stopIcePump();
+  void waterPump(bool on);
+  void completeTote();
+  void uploadTote();
+  bool toteIdValidated();
+  void pollValidation();
+
+  void onIdle();
+  void onWaterFilling();
+  void onIceFilling();
+  void onSettlingIce();
+  void onWaitingToteId();
+  void onToteReady();
+  void onCanceled();
+
+  void initStage1();
+  void destroyStage1();
+  void destroyStage2();
+  void destroyStage3();
+
+  float weight() {
+    const float kg = _hw.getWeight();
+    if (!isnan(kg)) _lastKg = kg;
+    return kg;
+  }
+  // Stage boundaries: a read that timed out takes the last good one
+  // instead of turning the tote's reference (or its report) into NaN
+  float weightOrLast() {
+    const float kg = weight();
+    return isnan(kg) ? _lastKg : kg;
+  }
+  void  out(uint8_t ch, uint8_t level) { if (ch != LANE_NO_IO) _hw.writeDigitalOutput(ch, level); }
+
+  const uint8_t    _index;
+  const LaneConfig _cfg;
+
+  Hal::Station<Hal::Board> _hw;
+  Io                       _io;
+  Dosing::Engine<Io>       _dosing;
+  ToteDetector             _detector;
+  // Settings of the tote in progress, taken once in initStage1(): the
+  // engine, the logs and Stats all see the same version. A change made
+  // mid-tote applies from the next one
+  Settings::Snapshot       _settings;
+
+  Stage _stage1, _stage2, _stage3;
+  Button _buttons[LANE_BTNS];
+
+  volatile ToteState _state = ToteState::IDLE;
+  tote_data _tote = {};
+  uint32_t  _startedMs = 0;
+
+  // Last reading of sampleWeight(); onIdle() feeds it to _detector
+  // instead of adding its own Modbus reads
+  struct { uint32_t ms; float kg; } _latest = {0, NAN};
+  float    _lastKg = NAN;   // last weight() that answered (current tare)
+  uint32_t _detectorSeen = 0;
+  float    _lastBroadcastKg = 0;
+  uint32_t _lastBroadcastMs = 0;
+
+  // Pump pulse / manual-run deadlines (millis, 0 = none)
+  uint32_t _iceStartPulseEnd = 0;
+  uint32_t _iceStopPulseEnd  = 0;
+  uint32_t _manualIceOff     = 0;
+  uint32_t _manualWaterOff   = 0;
+
+  // COMPLETED: backend PUT in the background (ToteUploader)
+  uint32_t _completedMs = 0;
+  bool     _putDone     = false;
+  bool     _putOk       = false;
+
+  uint32_t _lastPrint  = 0;   // dosing progress lines
+  uint32_t _lastPrompt = 0;   // WAITING_TOTE_ID box
+  uint32_t _qrPolledMs  = 0;  // last BLE "GET" in WAITING_TOTE_ID (0 = not yet)
+  uint32_t _qrScannedMs = 0;  // scan of the ID being validated (0 = unknown)
+};
@@ -0,0 +1,202 @@
+// ============================================================
+// Metrics.cpp  —  Counters / gauges / histograms for /metrics
+// ============================================================
+#include "Metrics.h"
+#include <atomic>
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "config.h"
+
+namespace Metrics {
+
+  // ── Definitions ─────────────────────────────────────────────
+  struct Def {
+    const char* name;
+    const char* help;
+  };
+
+  static const Def COUNTER_DEFS[COUNTER_COUNT] = {
+    {"tote_loop_iterations_total",   "loop() passes"},
+    {"tote_modbus_requests_total",   "Modbus transactions issued to the scale"},
+    {"tote_modbus_timeouts_total",   "Modbus transactions without answer within 1 s"},
+    {"tote_modbus_errors_total",     "Modbus transactions answered with an exception or bad frame"},
+    {"tote_modbus_queue_fails_total","Modbus requests rejected by the master queue"},
+    {"tote_modbus_polls_total",      "Background scale polls issued on the shared bus"},
+    {"tote_modbus_poll_fails_total", "Background scale polls without a valid answer"},
+    {"tote_ws_connects_total",       "Backend WebSocket connections (first + reconnects)"},
+    {"tote_ws_disconnects_total",    "Backend WebSocket disconnections"},
+    {"tote_ws_send_dropped_total",   "Backend WebSocket messages dropped while disconnected"},
+    {"tote_wifi_reconnects_total",   "WiFi reconnect attempts"},
+    {"tote_wifi_fast_connects_total","WiFi connections to the cached BSSID/channel, no scan"},
+    {"tote_auto_starts_total",       "Cycles started by stable-weight tote detection"},
+    {"tote_auto_rejects_total",      "Loads above min weight that left before settling"},
+    {"tote_dosing_overlapped_total", "Cycles dosing water and ice at the same time"},
+    {"tote_dosing_saved_ms_total",   "Dosing time saved by overlapped cycles vs sequential (ms)"},
+    {"tote_ble_events_total",        "BLE callbacks handed to the main loop"},
+    {"tote_ble_events_dropped_total","BLE callbacks dropped, event queue full"},
+    {"tote_ble_qr_pushed_total",     "QRs notified by the reader when scanned"},
+    {"tote_ble_qr_polled_total",     "QRs received as the answer to a GET request"},
+    {"tote_ble_connects_direct_total","QR reader connections to the cached address"},
+    {"tote_ble_connects_scan_total", "QR reader connections after a scan"},
+    {"tote_ble_qr_duplicates_total", "QRs already accepted from another reader, not delivered again"},
+    {"tote_ota_updates_total",       "Images flashed through /update"},
+    {"tote_ota_failures_total",      "Uploads to /update aborted (gzip, digest or flash error)"},
+    {"tote_settings_nvs_commits_total", "Coalesced settings writes to NVS"},
+    {"tote_settings_nvs_keys_total", "Settings keys written to NVS (changed ones only)"},
+  };
+
+  static const Def GAUGE_DEFS[GAUGE_COUNT] = {
+    {"tote_ws_clients",     "Browsers connected to /ws"},
+    {"tote_wifi_rssi_dbm",  "WiFi RSSI (0 when disconnected)"},
+    {"tote_ble_readers_connected", "QR readers connected"},
+    {"tote_ota_throughput_bytes_per_second", "Upload rate of the last successful /update"},
+    {"tote_settings_version", "Version of the published settings snapshot"},
+  };
+
+  // Upper bounds in microseconds; +Inf is implicit
+  static const uint32_t LOOP_BOUNDS[]   = {1000, 5000, 10000, 20000, 50000, 100000, 250000, 1000000};
+  static const uint32_t MODBUS_BOUNDS[] = {5000, 10000, 20000, 30000, 50000, 100000, 250000, 1000000};
+  static const uint32_t HUMAN_BOUNDS[]  = {100000, 250000, 500000, 1000000, 2000000, 5000000, 10000000, 30000000};
+  static const uint8_t  MAX_BOUNDS      = 8;
+
+  struct HistDef {
+    const char*     name;
+    const char*     help;
+    const uint32_t* bounds;
+    uint8_t         nbounds;
+  };
+
+  static const HistDef HIST_DEFS[HISTOGRAM_COUNT] = {
+    {"tote_loop_time_seconds",      "Work per loop() pass", LOOP_BOUNDS,   sizeof(LOOP_BOUNDS)   / sizeof(uint32_t)},
+    {"tote_modbus_latency_seconds", "Modbus round-trip",    MODBUS_BOUNDS, sizeof(MODBUS_BOUNDS) / sizeof(uint32_t)},
+    {"tote_qr_to_id_seconds",       "QR scanned to tote ID validated", HUMAN_BOUNDS, sizeof(HUMAN_BOUNDS) / sizeof(uint32_t)},
+    {"tote_ble_reconnect_seconds",  "QR reader disconnect to reconnected", HUMAN_BOUNDS, sizeof(HUMAN_BOUNDS) / sizeof(uint32_t)},
+    {"tote_wifi_boot_connect_seconds", "Boot to first WiFi IP", HUMAN_BOUNDS, sizeof(HUMAN_BOUNDS) / sizeof(uint32_t)},
+    {"tote_wifi_reconnect_seconds", "WiFi link lost to IP again", HUMAN_BOUNDS, sizeof(HUMAN_BOUNDS) / sizeof(uint32_t)},
+  };
+
+  // ── Storage ─────────────────────────────────────────────────
+  struct Hist {
+    std::atomic<uint32_t> buckets[MAX_BOUNDS + 1];  // non-cumulative, last = +Inf
+    std::atomic<uint32_t> sumUs;                     // wraps after ~71 min of loop time; rate() handles it
+  };
+
+  static std::atomic<uint32_t> s_counters[COUNTER_COUNT];
+  static std::atomic<int32_t>  s_gauges[GAUGE_COUNT];
+  static Hist                  s_hists[HISTOGRAM_COUNT];
+
+  struct TaskEntry {
+    const char*  name;
+    TaskHandle_t handle;
+  };
+  static const uint8_t MAX_TASKS = 6;
+  static TaskEntry     s_tasks[MAX_TASKS];
+  static uint8_t       s_taskCount = 0;
+
+  // end != 0 publishes the entry (release); render() skips the rest
+  struct BootEntry {
+    const char*           name;
+    uint32_t              startUs;
+    std::atomic<uint32_t> endUs;
+  };
+  static const uint8_t MAX_BOOT_STEPS = 8;
+  static BootEntry     s_boot[MAX_BOOT_STEPS];
+
+  // ── Hot path ────────────────────────────────────────────────
+  void inc(Counter c, uint32_t n) {
+    s_counters[c].fetch_add(n, std::memory_order_relaxed);
+  }
+
+  void set(Gauge g, int32_t value) {
+    s_gauges[g].store(value, std::memory_order_relaxed);
+  }
+
+  void observe(Histogram h, uint32_t value) {
+    const HistDef& def = HIST_DEFS[h];
+    uint8_t i = 0;
+    while (i < def.nbounds && value > def.bounds[i]) i++;
+    s_hists[h].buckets[i].fetch_add(1, std::memory_order_relaxed);
+    s_hists[h].sumUs.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  uint32_t get(Counter c) {
+    return s_counters[c].load(std::memory_order_relaxed);
+  }
+
+  void registerTask(const char* name, TaskHandle_t handle) {
+    if (s_taskCount >= MAX_TASKS || handle == NULL) return;
+    s_tasks[s_taskCount++] = {name, handle};
+  }
+
+  void bootStep(uint8_t slot, const char* name, uint32_t startUs, uint32_t endUs) {
+    if (slot >= MAX_BOOT_STEPS) return;
+    s_boot[slot].name    = name;
+    s_boot[slot].startUs = startUs;
+    s_boot[slot].endUs.store(endUs ? endUs : 1, std::memory_order_release);
+  }
+
+  // ── Exposition ──────────────────────────────────────────────
+  static void header(Print& out, const char* name, const char* help, const char* type) {
+    out.printf("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+  }
+
+  void render(Print& out) {
+    header(out, "tote_info", "Firmware build", "gauge");
+    out.printf("tote_info{version=\"%s\"} 1\n", VERSION);
+
+    header(out, "tote_uptime_seconds", "Time since boot", "gauge");
+    out.printf("tote_uptime_seconds %.3f\n", esp_timer_get_time() / 1e6);
+
+    header(out, "tote_heap_free_bytes", "Free internal heap", "gauge");
+    out.printf("tote_heap_free_bytes %u\n", (unsigned)heap_caps_get_free_size(MALLOC_CAP_INTERNAL));
+    header(out, "tote_heap_min_free_bytes", "Lowest free heap since boot", "gauge");
+    out.printf("tote_heap_min_free_bytes %u\n", (unsigned)heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL));
+    header(out, "tote_heap_largest_free_block_bytes", "Largest allocatable block", "gauge");
+    out.printf("tote_heap_largest_free_block_bytes %u\n", (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL));
+
+    header(out, "tote_task_stack_free_bytes", "Task stack high-water mark (unused bytes)", "gauge");
+    for (uint8_t i = 0; i < s_taskCount; i++) {
+      out.printf("tote_task_stack_free_bytes{task=\"%s\"} %u\n",
+                 s_tasks[i].name, (unsigned)uxTaskGetStackHighWaterMark(s_tasks[i].handle));
+    }
+
+    header(out, "tote_boot_step_start_seconds", "Boot step start, since power-up", "gauge");
+    for (const BootEntry& b : s_boot) {
+      if (b.endUs.load(std::memory_order_acquire) == 0) continue;
+      out.printf("tote_boot_step_start_seconds{step=\"%s\"} %.3f\n", b.name, b.startUs / 1e6);
+    }
+    header(out, "tote_boot_step_end_seconds", "Boot step end, since power-up", "gauge");
+    for (const BootEntry& b : s_boot) {
+      const uint32_t end = b.endUs.load(std::memory_order_acquire);
+      if (end == 0) continue;
+      out.printf("tote_boot_step_end_seconds{step=\"%s\"} %.3f\n", b.name, end / 1e6);
+    }
+
+    for (uint8_t c = 0; c < COUNTER_COUNT; c++) {
+      header(out, COUNTER_DEFS[c].name, COUNTER_DEFS[c].help, "counter");
+      out.printf("%s %u\n", COUNTER_DEFS[c].name, s_counters[c].load(std::memory_order_relaxed));
+    }
+
+    for (uint8_t g = 0; g < GAUGE_COUNT; g++) {
+      header(out, GAUGE_DEFS[g].name, GAUGE_DEFS[g].help, "gauge");
+      out.printf("%s %d\n", GAUGE_DEFS[g].name, s_gauges[g].load(std::memory_order_relaxed));
+    }
+
+    for (uint8_t h = 0; h < HISTOGRAM_COUNT; h++) {
+      const HistDef& def = HIST_DEFS[h];
+      header(out, def.name, def.help, "histogram");
+      uint32_t cumulative = 0;
+      for (uint8_t i = 0; i <= def.nbounds; i++) {
+        cumulative += s_hists[h].buckets[i].load(std::memory_order_relaxed);
+        if (i < def.nbounds) {
+          out.printf("%s_bucket{le=\"%g\"} %u\n", def.name, def.bounds[i] / 1e6, cumulative);
+        } else {
+          out.printf("%s_bucket{le=\"+Inf\"} %u\n", def.name, cumulative);
+        }
+      }
+      out.printf("%s_sum %.6f\n", def.name, s_hists[h].sumUs.load(std::memory_order_relaxed) / 1e6);
+      out.printf("%s_count %u\n", def.name, cumulative);
+    }
+  }
+
+} // namespace Metrics
@@ -0,0 +1,82 @@
+#pragma once
+// ============================================================
+// Metrics  —  Fixed registry of counters / gauges / histograms
+//
+// Updated from hot paths with relaxed atomics (no locks, no heap),
+// rendered in Prometheus text format by GET /metrics (WIFI.cpp).
+// Heap, uptime and task stack high-water marks are sampled at
+// scrape time.
+// ============================================================
+#include <Arduino.h>
+
+namespace Metrics {
+
+  enum Counter : uint8_t {
+    LOOP_ITERATIONS,     ///< loop() passes
+    MODBUS_REQUESTS,     ///< Modbus transactions issued to the Marel
+    MODBUS_TIMEOUTS,     ///< transactions with no answer within 1 s
+    MODBUS_ERRORS,       ///< transactions answered with an exception or a bad frame
+    MODBUS_QUEUE_FAILS,  ///< requests the ModbusRTU master refused to queue
+    MODBUS_POLLS,        ///< background net weight polls (ScaleBus)
+    MODBUS_POLL_FAILS,   ///< polls that timed out or were rejected
+    WS_CONNECTS,         ///< backend WebSocket (re)connections
+    WS_DISCONNECTS,      ///< backend WebSocket drops
+    WS_SEND_DROPPED,     ///< messages not sent because WS was down
+    WIFI_RECONNECTS,     ///< connection attempts after the link was up once
+    WIFI_FAST_CONNECTS,  ///< connections made with the cached BSSID/channel (no scan)
+    TOTE_AUTO_STARTS,    ///< cycles started by ToteDetector (no START press)
+    TOTE_AUTO_REJECTS,   ///< loads above min weight that left before settling
+    DOSING_OVERLAPPED,   ///< cycles that ran water and ice together
+    DOSING_SAVED_MS,     ///< dosing time those cycles saved vs sequential (ms)
+    BLE_EVENTS,          ///< BLE callbacks (scan hit, notify, disconnect) handled in loop()
+    BLE_EVENTS_DROPPED,  ///< BLE callbacks lost because the event queue was full
+    BLE_QR_PUSHED,       ///< QRs notified by the reader as they were scanned
+    BLE_QR_POLLED,       ///< QRs that arrived as the answer to a "GET" request
+    BLE_CONNECTS_DIRECT, ///< reader connections to the cached address (no scan)
+    BLE_CONNECTS_SCAN,   ///< reader connections after a scan
+    BLE_QR_DUPLICATES,   ///< QRs already accepted from another reader (not delivered again)
+    OTA_UPDATES,         ///< firmware / SPIFFS images flashed through /update
+    OTA_FAILURES,        ///< /update uploads aborted (bad gzip, digest mismatch, flash error)
+    SETTINGS_NVS_COMMITS, ///< coalesced settings writes to NVS
+    SETTINGS_NVS_KEYS,   ///< settings keys written (only the ones that changed)
+    COUNTER_COUNT
+  };
+
+  enum Gauge : uint8_t {
+    WS_CLIENTS,          ///< browsers connected to /ws
+    WIFI_RSSI,           ///< dBm, 0 when disconnected
+    BLE_READERS,         ///< QR readers connected
+    OTA_THROUGHPUT,      ///< last successful /update, upload bytes per second
+    SETTINGS_VERSION,    ///< version of the published settings snapshot (1 at boot)
+    GAUGE_COUNT
+  };
+
+  enum Histogram : uint8_t {
+    LOOP_TIME_US,        ///< work done per loop() pass (excludes the 20 ms delay)
+    MODBUS_LATENCY_US,   ///< request → response round-trip
+    QR_TO_ID_US,         ///< QR scanned (BLE push / browser) → tote ID validated on its lane
+    BLE_RECONNECT_US,    ///< reader connection lost → connected again
+    WIFI_BOOT_CONNECT_US, ///< boot → first WiFi IP
+    WIFI_RECONNECT_US,   ///< WiFi link lost → IP again
+    HISTOGRAM_COUNT
+  };
+
+  void inc(Counter c, uint32_t n = 1);
+  void set(Gauge g, int32_t value);
+  void observe(Histogram h, uint32_t value);
+
+  /** Current value of a counter (tests, host benchmarks). */
+  uint32_t get(Counter c);
+
+  /** Registers a FreeRTOS task whose stack high-water mark is exported. */
+  void registerTask(const char* name, TaskHandle_t handle);
+
+  /**
+   * Boot timeline entry (Boot.cpp): µs since power-up. One slot per
+   * step, written once by the task that ran it.
+   */
+  void bootStep(uint8_t slot, const char* name, uint32_t startUs, uint32_t endUs);
+
+  /** Prometheus text exposition (format 0.0.4). */
+  void render(Print& out);
+}
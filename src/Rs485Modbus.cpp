@@ -0,0 +1,139 @@
+// ============================================================
+// Rs485Modbus.cpp  —  Modbus RTU master on the UART's RS-485 mode
+// ============================================================
+#include "Rs485Modbus.h"
+#include "Debug.h"
+
+using namespace ModbusRtu;
+
+bool Rs485Modbus::begin(uart_port_t port, uint32_t baud, int rxPin, int txPin, int dePin) {
+  uart_config_t cfg = {};
+  cfg.baud_rate  = (int)baud;
+  cfg.data_bits  = UART_DATA_8_BITS;
+  cfg.parity     = UART_PARITY_DISABLE;
+  cfg.stop_bits  = UART_STOP_BITS_1;
+  cfg.flow_ctrl  = UART_HW_FLOWCTRL_DISABLE;
+  cfg.source_clk = UART_SCLK_APB;
+
+  // RX ring 2× the largest frame, no TX ring (uart_write_bytes copies
+  // straight into the FIFO: requests are 8 bytes), 16-event queue
+  esp_err_t err = uart_driver_install(port, 2 * MAX_FRAME, 0, 16, &_queue, 0);
+  if (err == ESP_OK) err = uart_param_config(port, &cfg);
+  // RTS drives DE/RE; CTS unused
+  if (err == ESP_OK) err = uart_set_pin(port, txPin, rxPin, dePin, UART_PIN_NO_CHANGE);
+  if (err == ESP_OK) err = uart_set_mode(port, UART_MODE_RS485_HALF_DUPLEX);
+  if (err == ESP_OK) err = uart_set_rx_timeout(port, RX_TOUT_SYMS);
+  if (err != ESP_OK) {
+    LOG_ERR("[RS485] UART%d setup failed: %s\n", (int)port, esp_err_to_name(err));
+    return false;
+  }
+  _port = port;
+  return true;
+}
+
+uint16_t Rs485Modbus::send(size_t len, uint16_t count, void* dest, cbTransaction cb) {
+  if (_pending || _queue == nullptr) return 0;
+  // Drop anything left on the line (late reply to a timed-out request)
+  uart_flush_input(_port);
+  xQueueReset(_queue);
+  _rxLen   = 0;
+  _count16 = count;
+  _dest    = dest;
+  _cb      = cb;
+  _pending = true;
+  _sentMs  = millis();
+  uart_write_bytes(_port, (const char*)_req, len);
+  _count.tx++;
+  return ++_transaction ? _transaction : ++_transaction;
+}
+
+uint16_t Rs485Modbus::readHreg(uint8_t slaveId, uint16_t offset, uint16_t* value, uint16_t numregs,
+                               cbTransaction cb, uint8_t) {
+  if (_pending) return 0;
+  return send(buildRead(_req, slaveId, FC_READ_HREGS, offset, numregs), numregs, value, cb);
+}
+
+uint16_t Rs485Modbus::readCoil(uint8_t slaveId, uint16_t offset, bool* value, uint16_t numregs,
+                               cbTransaction cb, uint8_t) {
+  if (_pending) return 0;
+  return send(buildRead(_req, slaveId, FC_READ_COILS, offset, numregs), numregs, value, cb);
+}
+
+uint16_t Rs485Modbus::writeCoil(uint8_t slaveId, uint16_t offset, bool value, cbTransaction cb, uint8_t) {
+  if (_pending) return 0;
+  return send(buildWriteCoil(_req, slaveId, offset, value), 1, nullptr, cb);
+}
+
+void Rs485Modbus::task(uint32_t wait_ms) {
+  if (_queue == nullptr) return;
+
+  uart_event_t ev;
+  TickType_t   wait = wait_ms ? pdMS_TO_TICKS(wait_ms) : 0;
+  while (xQueueReceive(_queue, &ev, wait) == pdTRUE) {
+    wait = 0;   // slept once; now just empty the queue
+    switch (ev.type) {
+      case UART_DATA:
+        drain();
+        // TOUT fired (t3.5 of silence) or the whole reply is already in
+        if (_rxLen > 0 && (ev.timeout_flag ||
+                           (_pending && replyComplete(_req, _count16, _rx, _rxLen)))) {
+          handleFrame();
+          _rxLen = 0;
+        }
+        break;
+
+      case UART_FIFO_OVF:
+      case UART_BUFFER_FULL:
+        _count.overflows++;
+        uart_flush_input(_port);
+        xQueueReset(_queue);
+        _rxLen = 0;
+        return;
+
+      default:   // break / parity / frame errors: the CRC will reject the frame
+        break;
+    }
+  }
+
+  if (_pending && millis() - _sentMs >= TIMEOUT_MS) {
+    _count.timeouts++;
+    finish(Modbus::EX_TIMEOUT);
+  }
+}
+
+void Rs485Modbus::drain() {
+  size_t avail = 0;
+  uart_get_buffered_data_len(_port, &avail);
+  if (avail > sizeof(_rx) - _rxLen) avail = sizeof(_rx) - _rxLen;
+  if (avail == 0) return;
+  const int n = uart_read_bytes(_port, _rx + _rxLen, avail, 0);
+  if (n > 0) _rxLen += (size_t)n;
+}
+
+void Rs485Modbus::handleFrame() {
+  const uint8_t rc = _pending ? decodeReply(_req, _count16, _rx, _rxLen, _dest)
+                              : (checkCrc(_rx, _rxLen) ? REPLY_FOREIGN : REPLY_BAD_CRC);
+  switch (rc) {
+    case REPLY_BAD_CRC:
+      _count.crcErrors++;
+      return;   // wait for a retry or the timeout
+    case REPLY_FOREIGN:
+      _count.rx++;
+      _count.unexpected++;
+      return;
+    case REPLY_BAD_LENGTH:
+      _count.rx++;
+      finish(Modbus::EX_DATA_MISMACH);
+      return;
+    default:
+      _count.rx++;
+      finish((Modbus::ResultCode)rc);   // REPLY_OK = EX_SUCCESS, else the exception code
+      return;
+  }
+}
+
+void Rs485Modbus::finish(Modbus::ResultCode rc) {
+  _pending = false;
+  if (_cb) _cb(rc, _transaction, nullptr);
+  _cb = nullptr;
+}
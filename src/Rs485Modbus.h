@@ -0,0 +1,80 @@
+#pragma once
+// ============================================================
+// Rs485Modbus  —  Modbus RTU master on the ESP32 UART's native
+//                 RS-485 half-duplex mode (device only)
+//
+// Drop-in for the emelianov ModbusRTU master subset MarelClient
+// uses (readHreg / readCoil / writeCoil queue one transaction,
+// task() drives it, slave() != 0 while pending, 1 s timeout).
+// The difference is who does the line work:
+//   - DE/RE is the UART's RTS line in UART_MODE_RS485_HALF_DUPLEX:
+//     asserted by the peripheral on the first start bit, released
+//     after the last stop bit. No GPIO toggling, no software
+//     turnaround gap, no collision if loop() runs late.
+//   - End of frame is the UART RX timeout (TOUT, ~3.5 chars of
+//     silence): the driver posts a UART_DATA event with
+//     timeout_flag, so task(wait_ms) can sleep on the event queue
+//     and wake exactly when the reply is complete. No polling of
+//     available() or micros().
+// Framing and reply decoding: core/ModbusRtu.h (same code as the
+// host shim the native benchmarks run).
+//
+// Selected in marel.h with MAREL_NATIVE_RS485 (config.h).
+// ============================================================
+#include <Arduino.h>
+#include <ModbusRTU.h>        // Modbus::ResultCode, cbTransaction
+#include "driver/uart.h"
+#include "core/ModbusRtu.h"
+
+class Rs485Modbus {
+public:
+  /** Installs the UART driver in RS-485 half-duplex mode; dePin = RTS. */
+  bool begin(uart_port_t port, uint32_t baud, int rxPin, int txPin, int dePin);
+  void master() {}
+
+  /**
+   * Handles UART events and the timeout. wait_ms > 0 sleeps on the
+   * event queue for up to that long (MarelClient::waitForResponse);
+   * 0 returns at once (loop()).
+   */
+  void task(uint32_t wait_ms = 0);
+
+  /** Slave ID of the pending transaction, 0 when idle. */
+  uint8_t slave() const { return _pending ? _req[0] : 0; }
+
+  uint16_t readHreg(uint8_t slaveId, uint16_t offset, uint16_t* value, uint16_t numregs = 1,
+                    cbTransaction cb = nullptr, uint8_t unit = 1);
+  uint16_t readCoil(uint8_t slaveId, uint16_t offset, bool* value, uint16_t numregs = 1,
+                    cbTransaction cb = nullptr, uint8_t unit = 1);
+  uint16_t writeCoil(uint8_t slaveId, uint16_t offset, bool value,
+                     cbTransaction cb = nullptr, uint8_t unit = 1);
+
+  struct Counters {
+    uint32_t tx, rx, crcErrors, unexpected, timeouts, overflows;
+  };
+  const Counters& counters() const { return _count; }
+
+private:
+  static const uint32_t TIMEOUT_MS   = 1000;   // as ModbusRTU
+  static const uint8_t  RX_TOUT_SYMS = 4;      // ≥ t3.5 of silence ends a frame
+
+  uint16_t send(size_t len, uint16_t count, void* dest, cbTransaction cb);
+  void     drain();
+  void     handleFrame();
+  void     finish(Modbus::ResultCode rc);
+
+  uart_port_t   _port  = UART_NUM_MAX;
+  QueueHandle_t _queue = nullptr;
+  bool     _pending = false;
+  uint8_t  _req[ModbusRtu::REQUEST_SIZE];
+  uint16_t _count16 = 0;
+  void*    _dest    = nullptr;
+  cbTransaction _cb;
+  uint16_t _transaction = 0;
+  uint32_t _sentMs  = 0;
+
+  uint8_t  _rx[ModbusRtu::MAX_FRAME];
+  size_t   _rxLen   = 0;
+
+  Counters _count = {};
+};
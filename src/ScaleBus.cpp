@@ -0,0 +1,153 @@
+// ============================================================
+// ScaleBus.cpp  —  Shared RS-485 line: master setup, poll scheduler
+// ============================================================
+#include "ScaleBus.h"
+#include "Debug.h"
+#include "Metrics.h"
+
+ScaleBus::ScaleBus(uint8_t rxPin, uint8_t txPin, uint8_t dePin)
+    : _rxPin(rxPin), _txPin(txPin), _dePin(dePin) {}
+
+bool ScaleBus::begin() {
+  if (_begun) return true;
+#if MAREL_BUS_NATIVE
+  // UART1 in RS-485 half-duplex mode: RTS drives DE/RE in hardware
+  if (!_mb.begin(UART_NUM_1, MAREL_BAUD, _rxPin, _txPin, _dePin)) return false;
+  _mb.master();
+#else
+  // Configure Serial1 for Modbus RTU on specified pins
+  Serial1.begin(MAREL_BAUD, SERIAL_8N1, _rxPin, _txPin);
+
+  // Configure DE/RE pin
+  pinMode(_dePin, OUTPUT);
+  digitalWrite(_dePin, LOW);  // Reception mode by default
+
+  // Initialize Modbus as Master
+  _mb.begin(&Serial1, _dePin);
+  _mb.master();
+#endif
+  _begun = true;
+
+  LOG_MAREL("Modbus RTU Master initialized (%s)\n",
+            MAREL_BUS_NATIVE ? "UART RS-485 half-duplex" : "ModbusRTU, software DE/RE");
+  LOG_MAREL("RX: GPIO%d, TX: GPIO%d, DE/RE: GPIO%d\n", _rxPin, _txPin, _dePin);
+  return true;
+}
+
+bool ScaleBus::attach(MarelClient* client) {
+  for (uint8_t i = 0; i < _n; i++) {
+    if (_clients[i] == client) return true;
+  }
+  if (_n >= MAX_SCALES) return false;
+  _clients[_n++] = client;
+  return true;
+}
+
+// ── Line ─────────────────────────────────────────────────────
+
+void ScaleBus::pump() {
+#if MAREL_BUS_NATIVE
+  _mb.task(5);  // sleeps on the UART event queue until the reply's RX timeout
+#else
+  _mb.task();
+  yield();
+#endif
+}
+
+bool ScaleBus::acquire() {
+  const uint32_t start = millis();
+  while (_mb.slave() && (millis() - start) < 1000) pump();
+  return !_mb.slave();
+}
+
+cbTransaction ScaleBus::command() {
+  _cmdDone = false;
+  return [this](Modbus::ResultCode rc, uint16_t, void*) {
+    _cmdRc   = rc;
+    _cmdDone = true;
+    return true;
+  };
+}
+
+bool ScaleBus::wait() {
+  // Block until the queued transaction completes (1 second timeout).
+  // The library expires it after its own 1 s too; slave() clears then
+  // as well, so only the callback's result code says it was answered.
+  Metrics::inc(Metrics::MODBUS_REQUESTS);
+  const uint32_t t0 = micros();
+  unsigned long start = millis();
+  while (!_cmdDone && (millis() - start) < 1000) pump();
+  if (!_cmdDone || _cmdRc == Modbus::EX_TIMEOUT) {
+    Metrics::inc(Metrics::MODBUS_TIMEOUTS);
+    return false;
+  }
+  if (_cmdRc != Modbus::EX_SUCCESS) {
+    Metrics::inc(Metrics::MODBUS_ERRORS);
+    LOG_MAREL_V("Command failed: 0x%02X\n", _cmdRc);
+    return false;
+  }
+  Metrics::observe(Metrics::MODBUS_LATENCY_US, micros() - t0);
+  return true;
+}
+
+// ── Polling ──────────────────────────────────────────────────
+
+void ScaleBus::task() {
+  if (!_begun) return;
+  _mb.task();
+  if (_mb.slave() || _n == 0) return;
+
+  const uint32_t now = millis();
+  const int8_t i = nextPoll(now);
+  if (i >= 0) startPoll((uint8_t)i, now);
+}
+
+int8_t ScaleBus::nextPoll(uint32_t now_ms) {
+  int8_t active = -1, idle = -1;
+  for (uint8_t k = 0; k < _n; k++) {
+    const uint8_t     i = (uint8_t)((_rr + k) % _n);
+    const MarelClient* c = _clients[i];
+    if (!c->_initialized || c->_priority == MarelClient::POLL_OFF) continue;
+
+    const uint32_t period = c->_priority == MarelClient::POLL_ACTIVE ? SCALE_POLL_ACTIVE_MS
+                                                                     : SCALE_POLL_IDLE_MS;
+    const uint32_t since  = now_ms - c->_polledMs;
+    if (since < period) continue;
+
+    if (c->_priority == MarelClient::POLL_ACTIVE) {
+      if (active < 0) active = (int8_t)i;
+    } else {
+      // Overdue by a whole period: the active scales have had their share
+      if (since >= 2 * period) return (int8_t)i;
+      if (idle < 0) idle = (int8_t)i;
+    }
+  }
+  return active >= 0 ? active : idle;
+}
+
+void ScaleBus::startPoll(uint8_t idx, uint32_t now_ms) {
+  MarelClient* c = _clients[idx];
+  if (!_mb.readHreg(c->_slaveID, REG_NET_WEIGHT, _pollRegs, 2,
+                    [this](Modbus::ResultCode rc, uint16_t, void*) { return pollDone(rc); })) {
+    Metrics::inc(Metrics::MODBUS_QUEUE_FAILS);
+    return;
+  }
+  Metrics::inc(Metrics::MODBUS_POLLS);
+  c->_polledMs = now_ms;
+  _polling     = (int8_t)idx;
+  _rr          = (uint8_t)((idx + 1) % _n);
+}
+
+bool ScaleBus::pollDone(Modbus::ResultCode rc) {
+  if (_polling < 0) return true;
+  MarelClient* c = _clients[_polling];
+  _polling = -1;
+
+  if (rc != Modbus::EX_SUCCESS) {
+    Metrics::inc(Metrics::MODBUS_POLL_FAILS);
+    LOG_MAREL_V("Poll slave %d failed: 0x%02X\n", c->_slaveID, rc);
+    return true;
+  }
+  c->storeNet(true, MarelClient::registersToFloat(_pollRegs[0], _pollRegs[1]));
+  return true;
+}
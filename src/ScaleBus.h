@@ -0,0 +1,89 @@
+#pragma once
+// ============================================================
+// ScaleBus  —  One RS-485 line, several Marel indicators
+//
+// Owns the Modbus master (Rs485Modbus or ModbusRTU, see marel.h)
+// and shares it between MarelClient handles, one per slave ID:
+//
+//   ScaleBus    bus(MAREL_RX_PIN, MAREL_TX_PIN, MAREL_DE_RE_PIN);
+//   MarelClient a(1, bus), b(2, bus);
+//
+// Two kinds of traffic:
+//   - Commands (MarelClient's blocking calls: getNetWeightKg, setTare,
+//     ...). They go out as soon as the transaction on the line ends,
+//     ahead of any poll.
+//   - Polls of the net weight, issued by task() in the background
+//     for handles with a poll priority, into MarelClient::latest().
+//     Polling does not block loop().
+//
+// Poll scheduling, each time the line is free:
+//   1. an IDLE scale overdue by a whole period (no starvation)
+//   2. ACTIVE scales (dosing), every SCALE_POLL_ACTIVE_MS
+//   3. IDLE scales, every SCALE_POLL_IDLE_MS
+// Within one class a round-robin pointer rotates the start, so
+// equal-priority scales get equal turns. OFF (the default) is never
+// polled; such a handle behaves exactly like a standalone client.
+// ============================================================
+#include <Arduino.h>
+#include "marel.h"
+
+class ScaleBus {
+public:
+  static const uint8_t MAX_SCALES = 4;
+
+  ScaleBus(uint8_t rxPin, uint8_t txPin, uint8_t dePin);
+
+  /** Sets up the UART and master once; later calls do nothing. */
+  bool begin();
+  bool begun() const { return _begun; }
+
+  /** MarelClient::begin() registers itself. False when full. */
+  bool attach(MarelClient* client);
+
+  /** Drives the line and issues due polls. Call every loop pass. */
+  void task();
+
+  /**
+   * Waits (up to 1 s) for the transaction on the line to end, so a
+   * command can go out next. False if the line stayed busy.
+   */
+  bool acquire();
+
+  /**
+   * Completion callback for a command: pass it to the readHreg /
+   * writeCoil just queued, then wait() for it.
+   */
+  cbTransaction command();
+
+  /**
+   * Blocks until the command just queued completes. True only for an
+   * EX_SUCCESS answer: a timeout (ours or the library's) or an error
+   * reply leaves the registers as they were and returns false.
+   */
+  bool wait();
+
+  /** True while c's poll is the transaction on the line. */
+  bool polling(const MarelClient* c) const { return _polling >= 0 && _clients[_polling] == c; }
+
+  MarelMaster& master() { return _mb; }
+
+private:
+  int8_t nextPoll(uint32_t now_ms);
+  void   startPoll(uint8_t idx, uint32_t now_ms);
+  bool   pollDone(Modbus::ResultCode rc);
+  void   pump();
+
+  MarelMaster _mb;
+  uint8_t      _rxPin, _txPin, _dePin;
+  bool         _begun   = false;
+
+  MarelClient* _clients[MAX_SCALES] = {};
+  uint8_t      _n       = 0;
+  uint8_t      _rr      = 0;      // round-robin start for the next pick
+  int8_t       _polling = -1;     // index of the client whose poll is on the line
+  uint16_t     _pollRegs[2] = {0, 0};
+
+  // Result of the command on the line (command() / wait())
+  bool               _cmdDone = true;
+  Modbus::ResultCode _cmdRc   = Modbus::EX_SUCCESS;
+};
@@ -2,40 +2,229 @@
 // Settings.cpp  —  NVS-persisted runtime configuration
 // ============================================================
 #include "Settings.h"
+#include <Preferences.h>
+#include <nvs.h>
+#include <atomic>
+#include <string.h>
 #include "Debug.h"
+#include "Metrics.h"
 
 namespace Settings {
 
   static Preferences _prefs;
-  static volatile float _iceKg    = (float)TARGET_ICE_KG;
-  static volatile float _waterKg  = (float)TARGET_WATER_KG;
-  static volatile float _minWeight= (float)MIN_WEIGHT;
+
+  // ── Snapshot double buffer ──────────────────────────────────
+  // Writers (web, WS, setup) take turns on s_mux and fill the slot that
+  // is not current, then switch s_cur. A reader may still be copying
+  // the other slot when a second change reuses it: each slot carries a
+  // sequence number (odd = being written) and the reader retries if it
+  // moved during the copy.
+  struct Slot {
+    std::atomic<uint32_t> seq{0};
+    Snapshot              data;
+  };
+  static Slot                 s_slots[2];
+  static std::atomic<uint8_t> s_cur{0};
+  static portMUX_TYPE         s_mux = portMUX_INITIALIZER_UNLOCKED;
+
+  // ── Persistence ─────────────────────────────────────────────
+  static Snapshot              s_saved;         // what NVS holds (flush() only)
+  static std::atomic<uint32_t> s_changedMs{0};  // last unsaved change, 0 = none
+  static std::atomic<bool>     s_flushing{false};
+
+  static bool coarseFine(const Snapshot& s) { return s.dosing.strategy == Dosing::Strategy::COARSE_FINE; }
+
+  // Only what NVS stores (and the web / WS can change)
+  static bool sameValues(const Snapshot& a, const Snapshot& b) {
+    return a.dosing.ice_kg        == b.dosing.ice_kg &&
+           a.dosing.water_kg      == b.dosing.water_kg &&
+           a.min_w                == b.min_w &&
+           a.auto_start           == b.auto_start &&
+           a.dosing.strategy      == b.dosing.strategy &&
+           a.dosing.fine_kg       == b.dosing.fine_kg &&
+           a.dosing.tol_kg        == b.dosing.tol_kg &&
+           a.dosing.pulse_max_ms  == b.dosing.pulse_max_ms &&
+           a.dosing.pulse_min_ms  == b.dosing.pulse_min_ms &&
+           a.dosing.pulse_wait_ms == b.dosing.pulse_wait_ms &&
+           a.dosing.overlap       == b.dosing.overlap &&
+           memcmp(a.log_lv, b.log_lv, sizeof(a.log_lv)) == 0;
+  }
+
+  Snapshot snapshot() {
+    for (;;) {
+      const Slot& slot = s_slots[s_cur.load(std::memory_order_acquire)];
+      const uint32_t seq = slot.seq.load(std::memory_order_acquire);
+      if (seq & 1) continue;  // a writer is filling it right now
+      Snapshot copy = slot.data;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.seq.load(std::memory_order_relaxed) == seq) return copy;
+    }
+  }
+
+  // Publishes next (as version + 1) unless another change went in since
+  // it was copied: next.version is then behind
+  static bool publish(Snapshot& next) {
+    portENTER_CRITICAL(&s_mux);
+    const uint8_t cur = s_cur.load(std::memory_order_relaxed);
+    if (s_slots[cur].data.version != next.version) {
+      portEXIT_CRITICAL(&s_mux);
+      return false;
+    }
+    next.version++;
+    Slot& slot = s_slots[cur ^ 1];
+    slot.seq.fetch_add(1, std::memory_order_relaxed);   // odd: readers retry
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.data = next;
+    slot.seq.fetch_add(1, std::memory_order_release);   // even again
+    s_cur.store(cur ^ 1, std::memory_order_release);
+    portEXIT_CRITICAL(&s_mux);
+
+    s_changedMs.store(millis() | 1, std::memory_order_release);  // | 1: never 0
+    Metrics::set(Metrics::SETTINGS_VERSION, (int32_t)next.version);
+    return true;
+  }
+
+  void update(const std::function<void(Snapshot&)>& edit) {
+    for (;;) {
+      const Snapshot before = snapshot();
+      Snapshot next = before;
+      edit(next);
+      if (sameValues(next, before)) return;
+      if (!publish(next)) continue;  // lost the race: edit the newer one
+
+      const Dosing::Config& d = next.dosing;
+      LOG_MAIN("[Settings] v%lu  ice=%.2f kg  water=%.2f kg  min=%.2f kg  auto_start=%d  "
+               "ice %s  fine=%.2f kg  tol=%.3f kg  pulse=%u..%u ms  wait=%u ms  overlap=%d\n",
+               (unsigned long)next.version, d.ice_kg, d.water_kg, next.min_w, next.auto_start,
+               Dosing::strategyName(d.strategy), d.fine_kg, d.tol_kg,
+               d.pulse_min_ms, d.pulse_max_ms, d.pulse_wait_ms, d.overlap);
+      return;
+    }
+  }
 
   void load() {
+    Snapshot s;
+    Dosing::Config& d = s.dosing;
     _prefs.begin("tote_cfg", /*readOnly=*/true);
-    _iceKg     = _prefs.getFloat("ice_kg",   (float)TARGET_ICE_KG);
-    _waterKg   = _prefs.getFloat("water_kg", (float)TARGET_WATER_KG);
-    _minWeight = _prefs.getFloat("min_w",    (float)MIN_WEIGHT);
+    d.ice_kg        = _prefs.getFloat("ice_kg",   (float)TARGET_ICE_KG);
+    d.water_kg      = _prefs.getFloat("water_kg", (float)TARGET_WATER_KG);
+    s.min_w         = _prefs.getFloat("min_w",    (float)MIN_WEIGHT);
+    s.auto_start    = _prefs.getBool("auto_st",   AUTO_START_DEFAULT);
+    const Dosing::Config def;
+    d.strategy      = _prefs.getBool("ice_cf", ICE_COARSE_FINE_DEFAULT)
+                        ? Dosing::Strategy::COARSE_FINE : Dosing::Strategy::SINGLE_SHOT;
+    d.fine_kg       = _prefs.getFloat("fine_kg", def.fine_kg);
+    d.tol_kg        = _prefs.getFloat("tol_kg",  def.tol_kg);
+    d.pulse_max_ms  = _prefs.getUShort("p_max",  def.pulse_max_ms);
+    d.pulse_min_ms  = _prefs.getUShort("p_min",  def.pulse_min_ms);
+    d.pulse_wait_ms = _prefs.getUShort("p_wait", def.pulse_wait_ms);
+    d.overlap       = _prefs.getBool("overlap",  DOSING_OVERLAP_DEFAULT);
+    uint8_t lv[LOG_MOD_COUNT];
+    if (_prefs.getBytesLength("log_lv") == sizeof(lv) &&
+        _prefs.getBytes("log_lv", lv, sizeof(lv)) == sizeof(lv)) {
+      for (uint8_t i = 0; i < LOG_MOD_COUNT; i++) {
+        s.log_lv[i] = lv[i] > LOG_LVL_VERBOSE ? LOG_LVL_VERBOSE : lv[i];
+      }
+    }
     _prefs.end();
-    LOG_MAIN("[Settings] Loaded  ice=%.2f kg  water=%.2f kg  min=%.2f kg\n",
-                  _iceKg, _waterKg, _minWeight);
+
+    // setup(), before any other task reads or writes settings
+    s.version = 1;
+    s_slots[0].data = s;
+    s_cur.store(0, std::memory_order_release);
+    s_saved = s;
+    Metrics::set(Metrics::SETTINGS_VERSION, (int32_t)s.version);
+
+    LOG_MAIN("[Settings] Loaded  ice=%.2f kg  water=%.2f kg  min=%.2f kg  auto_start=%d\n",
+                  d.ice_kg, d.water_kg, s.min_w, s.auto_start);
+    LOG_MAIN("[Settings] Ice     %s  fine=%.2f kg  tol=%.3f kg  pulse=%u..%u ms  wait=%u ms  overlap=%d\n",
+                  Dosing::strategyName(d.strategy), d.fine_kg, d.tol_kg,
+                  d.pulse_min_ms, d.pulse_max_ms, d.pulse_wait_ms, d.overlap);
   }
 
-  void save(float iceKg, float waterKg, float minWeight) {
-    _iceKg     = iceKg;
-    _waterKg   = waterKg;
-    _minWeight = minWeight;
-    _prefs.begin("tote_cfg", /*readOnly=*/false);
-    _prefs.putFloat("ice_kg",   iceKg);
-    _prefs.putFloat("water_kg", waterKg);
-    _prefs.putFloat("min_w",    minWeight);
-    _prefs.end();
-    LOG_MAIN("[Settings] Saved   ice=%.2f kg  water=%.2f kg  min=%.2f kg\n",
-                  iceKg, waterKg, minWeight);
+  // ── NVS ─────────────────────────────────────────────────────
+  // Same encodings as Preferences (float = 4-byte blob, bool = u8), so
+  // load() reads them back with getFloat() / getBool() / getUShort() / getBytes()
+
+  void loop() {
+    const uint32_t changed = s_changedMs.load(std::memory_order_acquire);
+    if (changed && millis() - changed >= SETTINGS_SAVE_DELAY_MS) flush();
   }
 
-  float getTargetIceKg()  { return _iceKg;    }
-  float getTargetWaterKg(){ return _waterKg;   }
-  float getMinWeight()    { return _minWeight; }
+  void flush() {
+    while (s_flushing.exchange(true, std::memory_order_acquire)) delay(1);
+    if (!s_changedMs.load(std::memory_order_acquire)) {
+      s_flushing.store(false, std::memory_order_release);
+      return;
+    }
+    // Cleared first: a change from now on schedules another flush
+    s_changedMs.store(0, std::memory_order_release);
+    const Snapshot s = snapshot();
+    const Dosing::Config& d = s.dosing;
+    const Dosing::Config& was = s_saved.dosing;
+
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open("tote_cfg", NVS_READWRITE, &nvs);
+    const bool opened = err == ESP_OK;
+    uint8_t keys = 0;
+    auto putFloat = [&](const char* key, float v, float old) {
+      if (err != ESP_OK || v == old) return;
+      err = nvs_set_blob(nvs, key, &v, sizeof(v));
+      keys++;
+    };
+    auto putU16 = [&](const char* key, uint32_t v, uint32_t old) {
+      if (err != ESP_OK || v == old) return;
+      err = nvs_set_u16(nvs, key, (uint16_t)v);
+      keys++;
+    };
+    auto putBool = [&](const char* key, bool v, bool old) {
+      if (err != ESP_OK || v == old) return;
+      err = nvs_set_u8(nvs, key, v);
+      keys++;
+    };
+    auto putBytes = [&](const char* key, const uint8_t* v, const uint8_t* old, size_t len) {
+      if (err != ESP_OK || memcmp(v, old, len) == 0) return;
+      err = nvs_set_blob(nvs, key, v, len);
+      keys++;
+    };
+    putFloat("ice_kg",   d.ice_kg,        was.ice_kg);
+    putFloat("water_kg", d.water_kg,      was.water_kg);
+    putFloat("min_w",    s.min_w,         s_saved.min_w);
+    putBool ("auto_st",  s.auto_start,    s_saved.auto_start);
+    putBool ("ice_cf",   coarseFine(s),   coarseFine(s_saved));
+    putFloat("fine_kg",  d.fine_kg,       was.fine_kg);
+    putFloat("tol_kg",   d.tol_kg,        was.tol_kg);
+    putU16  ("p_max",    d.pulse_max_ms,  was.pulse_max_ms);
+    putU16  ("p_min",    d.pulse_min_ms,  was.pulse_min_ms);
+    putU16  ("p_wait",   d.pulse_wait_ms, was.pulse_wait_ms);
+    putBool ("overlap",  d.overlap,       was.overlap);
+    putBytes("log_lv",   s.log_lv,        s_saved.log_lv, sizeof(s.log_lv));
+    if (err == ESP_OK && keys) err = nvs_commit(nvs);
+    if (opened) nvs_close(nvs);
+
+    if (err == ESP_OK) {
+      s_saved = s;
+      if (keys) {
+        Metrics::inc(Metrics::SETTINGS_NVS_COMMITS);
+        Metrics::inc(Metrics::SETTINGS_NVS_KEYS, keys);
+      }
+      LOG_MAIN("[Settings] Saved   v%lu to NVS (%u key%s)\n",
+               (unsigned long)s.version, keys, keys == 1 ? "" : "s");
+    } else {
+      // Retry on the next loop() after the delay
+      s_changedMs.store(millis() | 1, std::memory_order_release);
+      LOG_ERR("[Settings] NVS write failed: %s\n", esp_err_to_name(err));
+    }
+    s_flushing.store(false, std::memory_order_release);
+  }
+
+  // ── Getters ─────────────────────────────────────────────────
+
+  float getTargetIceKg()  { return snapshot().dosing.ice_kg;   }
+  float getTargetWaterKg(){ return snapshot().dosing.water_kg; }
+  float getMinWeight()    { return snapshot().min_w;           }
+  bool  getAutoStart()    { return snapshot().auto_start;      }
+
+  Dosing::Config dosingConfig() { return snapshot().dosing; }
 
 } // namespace Settings
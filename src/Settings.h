@@ -1,13 +1,37 @@
 #pragma once
 // ============================================================
 // Settings  —  NVS-persisted runtime configuration
-// Namespace: "tote_cfg"   Keys: ice_kg | water_kg | min_w
+// Namespace: "tote_cfg"   Keys: ice_kg | water_kg | min_w | auto_st | log_lv
+//                               ice_cf | fine_kg | tol_kg | p_max | p_min | p_wait | overlap
+//
+// The values live in an immutable, versioned Snapshot. A change builds
+// the next one and publishes it whole (double buffer), so a reader
+// never sees new targets with old dosing options. Readers that need
+// several values, or keep them for a tote cycle, take one snapshot().
+//
+// NVS is written in the background (loop() on communicationTask):
+// SETTINGS_SAVE_DELAY_MS after the last change, only the keys that
+// differ from what is stored, one commit.
 // ============================================================
 #include <Arduino.h>
-#include <Preferences.h>
+#include <functional>
 #include "config.h"
+#include "Debug.h"
+#include "core/Dosing.h"
 
 namespace Settings {
+
+  struct Snapshot {
+    uint32_t       version    = 0;     ///< +1 per published change
+    Dosing::Config dosing;             ///< targets (water_kg, ice_kg) + ice strategy / overlap
+    float          min_w      = (float)MIN_WEIGHT;  ///< minimum tote weight to begin cycle (kg)
+    bool           auto_start = AUTO_START_DEFAULT; ///< start by itself when a tote settles (onIDLE)
+    uint8_t        log_lv[LOG_MOD_COUNT] = {        ///< runtime log level per module (Log::levels)
+      LOG_DEFAULT_MAIN, LOG_DEFAULT_MAREL, LOG_DEFAULT_WS,
+      LOG_DEFAULT_WIFI, LOG_DEFAULT_CTRL,  LOG_DEFAULT_BLE,
+    };
+  };
+
   /**
    * Load values from NVS.  Falls back to compile-time defaults
    * defined in config.h when no saved value exists.
@@ -15,13 +39,33 @@ namespace Settings {
    */
   void  load();
 
+  /** Consistent copy of the current values. Lock-free, any task. */
+  Snapshot snapshot();
+
   /**
-   * Persist new values to NVS and update the in-memory cache.
-   * Takes effect immediately — no reboot required.
+   * Change settings: edit gets a copy of the current snapshot and the
+   * result is published as the next version (nothing happens if edit
+   * changed nothing). Takes effect immediately — no reboot required;
+   * NVS follows SETTINGS_SAVE_DELAY_MS later. Any task; if another
+   * change lands meanwhile, edit runs again on top of it.
    */
-  void  save(float iceKg, float waterKg, float minWeight);
+  void  update(const std::function<void(Snapshot&)>& edit);
+
+  /** Background persistence. Call periodically from a non-control task. */
+  void  loop();
+
+  /** Write pending changes to NVS now (before a restart). */
+  void  flush();
 
   float getTargetIceKg();   ///< Target ice dispensing weight (kg)
   float getTargetWaterKg(); ///< Target water filling weight (kg)
   float getMinWeight();     ///< Minimum tote weight to begin cycle (kg)
+  bool  getAutoStart();     ///< Start a cycle by itself when a tote settles
+
+  /**
+   * Engine config for the next cycle: targets above plus the ice
+   * strategy (SINGLE_SHOT / COARSE_FINE), its fine-dosing thresholds
+   * and whether water and ice may overlap.
+   */
+  Dosing::Config dosingConfig();
 }
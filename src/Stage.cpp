@@ -45,7 +45,7 @@ void Stage::destroy() {
 }
 
 void Stage::DEBUG_M(const char *message) {
-    if (!DEBUG_CTRL) return;
+    if (!LOG_ENABLED(CTRL, LOG_LVL_INFO)) return;
     char buffer[100];
     snprintf(buffer, sizeof(buffer), "[Stage]: %s", message);
     Serial.println(buffer);
@@ -0,0 +1,162 @@
+// ============================================================
+// Stats.cpp  —  On-device production statistics
+// ============================================================
+#include "Stats.h"
+#include "ToteTrace.h"
+#include "core/LogHistogram.h"
+#include <memory>
+#include <new>
+
+namespace Stats {
+
+  enum Stage : uint8_t { ST_WATER, ST_ICE, ST_SETTLE, ST_ID_WAIT, ST_CYCLE, STAGE_COUNT };
+  static const char* const STAGE_KEYS[STAGE_COUNT] = {"water", "ice", "settle", "id_wait", "cycle"};
+
+  // Rolling throughput: one slot per minute over the last hour
+  static const uint8_t THROUGHPUT_SLOTS = 60;
+  struct MinuteSlot {
+    uint32_t minute;
+    uint16_t totes;
+  };
+
+  static LogHistogram       s_stageMs[STAGE_COUNT];
+  static LogHistogram       s_validateMs;
+  static LogHistogram       s_putMs;
+  static SignedLogHistogram s_waterOverG;
+  static SignedLogHistogram s_iceOverG;
+  static float              s_waterGiveawayKg = 0;
+  static float              s_iceGiveawayKg   = 0;
+  static uint32_t           s_totesTotal      = 0;
+  static MinuteSlot         s_slots[THROUGHPUT_SLOTS];
+
+  // /stats is served from the async_tcp task while loop() records
+  static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+
+  static int32_t toGrams(float kg) {
+    return (int32_t)lroundf(kg * 1000.0f);
+  }
+
+  void onWaterDone(float water_kg, float target_kg) {
+    if (isnan(water_kg)) return;
+    const int32_t over = toGrams(water_kg - target_kg);
+    portENTER_CRITICAL(&s_mux);
+    s_waterOverG.record(over);
+    if (over > 0) s_waterGiveawayKg += over / 1000.0f;
+    portEXIT_CRITICAL(&s_mux);
+  }
+
+  void onIceDone(float ice_kg, float target_kg) {
+    if (isnan(ice_kg)) return;
+    const int32_t over = toGrams(ice_kg - target_kg);
+    portENTER_CRITICAL(&s_mux);
+    s_iceOverG.record(over);
+    if (over > 0) s_iceGiveawayKg += over / 1000.0f;
+    portEXIT_CRITICAL(&s_mux);
+  }
+
+  void onToteDone(const tote_trace& trace) {
+    const int32_t stage[STAGE_COUNT] = {
+      Trace::stateMs(trace, "DISPENSING_WATER"),
+      Trace::stateMs(trace, "DISPENSING_ICE"),
+      Trace::stateMs(trace, "SETTLING_ICE"),
+      Trace::stateMs(trace, "WAITING_TOTE_ID"),
+      Trace::eventMs(trace, "put_start"),   // START → data ready for backend
+    };
+    const int32_t qr   = Trace::eventMs(trace, "qr_received");
+    const int32_t ok   = Trace::eventMs(trace, "validation_ok");
+    const int32_t put0 = Trace::eventMs(trace, "put_start");
+    const int32_t put1 = Trace::eventMs(trace, "put_done");
+    const uint32_t minute = millis() / 60000UL;
+
+    portENTER_CRITICAL(&s_mux);
+    for (uint8_t i = 0; i < STAGE_COUNT; i++) {
+      if (stage[i] >= 0) s_stageMs[i].record(stage[i]);
+    }
+    if (qr >= 0 && ok >= qr)     s_validateMs.record(ok - qr);
+    if (put0 >= 0 && put1 >= put0) s_putMs.record(put1 - put0);
+
+    MinuteSlot& slot = s_slots[minute % THROUGHPUT_SLOTS];
+    if (slot.minute != minute) {
+      slot.minute = minute;
+      slot.totes  = 0;
+    }
+    slot.totes++;
+    s_totesTotal++;
+    portEXIT_CRITICAL(&s_mux);
+  }
+
+  static void durationJson(JsonObject out, const LogHistogram& h) {
+    out["n"]   = h.count();
+    out["p50"] = h.percentile(0.50f);
+    out["p90"] = h.percentile(0.90f);
+    out["p99"] = h.percentile(0.99f);
+    out["max"] = h.max();
+  }
+
+  static void overshootJson(JsonObject out, const SignedLogHistogram& h) {
+    out["n"]    = h.count();
+    out["mean"] = h.mean();
+    out["p10"]  = h.percentile(0.10f);
+    out["p50"]  = h.percentile(0.50f);
+    out["p90"]  = h.percentile(0.90f);
+    out["min"]  = h.min();
+    out["max"]  = h.max();
+  }
+
+  // What toJson() needs, copied under s_mux so the percentile scans and
+  // the JSON are built with the lock released (~4 KB: heap, not stack)
+  struct Snapshot {
+    LogHistogram       stageMs[STAGE_COUNT];
+    LogHistogram       validateMs;
+    LogHistogram       putMs;
+    SignedLogHistogram waterOverG;
+    SignedLogHistogram iceOverG;
+    float              waterGiveawayKg;
+    float              iceGiveawayKg;
+    uint32_t           totesTotal;
+    uint32_t           lastHour;
+  };
+
+  void toJson(JsonObject out) {
+    std::unique_ptr<Snapshot> s(new (std::nothrow) Snapshot);
+    if (!s) return;
+    const uint32_t minute = millis() / 60000UL;
+
+    portENTER_CRITICAL(&s_mux);
+    for (uint8_t i = 0; i < STAGE_COUNT; i++) s->stageMs[i] = s_stageMs[i];
+    s->validateMs      = s_validateMs;
+    s->putMs           = s_putMs;
+    s->waterOverG      = s_waterOverG;
+    s->iceOverG        = s_iceOverG;
+    s->waterGiveawayKg = s_waterGiveawayKg;
+    s->iceGiveawayKg   = s_iceGiveawayKg;
+    s->totesTotal      = s_totesTotal;
+    s->lastHour        = 0;
+    for (const MinuteSlot& slot : s_slots) {
+      if (slot.totes && minute - slot.minute < THROUGHPUT_SLOTS) s->lastHour += slot.totes;
+    }
+    portEXIT_CRITICAL(&s_mux);
+
+    out["uptime_s"]       = millis() / 1000UL;
+    out["totes_total"]    = s->totesTotal;
+    out["totes_per_hour"] = s->lastHour;
+
+    JsonObject stages = out.createNestedObject("stages_ms");
+    for (uint8_t i = 0; i < STAGE_COUNT; i++) {
+      durationJson(stages.createNestedObject(STAGE_KEYS[i]), s->stageMs[i]);
+    }
+
+    JsonObject backend = out.createNestedObject("backend_ms");
+    durationJson(backend.createNestedObject("validate"), s->validateMs);
+    durationJson(backend.createNestedObject("put"),      s->putMs);
+
+    JsonObject over = out.createNestedObject("overshoot_g");
+    overshootJson(over.createNestedObject("water"), s->waterOverG);
+    overshootJson(over.createNestedObject("ice"),   s->iceOverG);
+
+    JsonObject giveaway = out.createNestedObject("giveaway_kg");
+    giveaway["water"] = s->waterGiveawayKg;
+    giveaway["ice"]   = s->iceGiveawayKg;
+  }
+
+} // namespace Stats
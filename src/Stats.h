@@ -0,0 +1,32 @@
+#pragma once
+// ============================================================
+// Stats  —  On-device production statistics
+//
+// Rolling totes/hour, per-stage duration percentiles, dosing
+// overshoot distributions and backend latency, aggregated on the
+// station so supervisors don't depend on the backend for it.
+// Fed from the destroyStage* callbacks; everything lives in
+// fixed-size LogHistograms (src/core), so memory is bounded no
+// matter the uptime.
+// Exposed as GET /stats and the WebSocket "stats" message.
+// ============================================================
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "Types.h"
+
+// Room needed by Stats::toJson()
+#define STATS_JSON_SIZE 2048
+
+namespace Stats {
+  /** destroyStage1: water actually dispensed vs. target. */
+  void onWaterDone(float water_kg, float target_kg);
+
+  /** destroyStage2: ice actually dispensed vs. target. */
+  void onIceDone(float ice_kg, float target_kg);
+
+  /** destroyStage3: stage durations and backend latency from the cycle trace. */
+  void onToteDone(const tote_trace& trace);
+
+  /** Snapshot as JSON (ms for durations, grams for overshoot). */
+  void toJson(JsonObject out);
+}
@@ -0,0 +1,116 @@
+// ============================================================
+// ToteTrace.cpp  —  Per-tote cycle-time tracer
+// ============================================================
+#include "ToteTrace.h"
+#include "esp_timer.h"
+
+namespace Trace {
+
+  struct Entry {
+    char       id[ID_SIZE];
+    tote_trace trace;
+  };
+
+  static Entry        s_history[TRACE_HISTORY];
+  static uint8_t      s_head  = 0;   // next slot to write
+  static uint8_t      s_count = 0;
+  static portMUX_TYPE s_mux   = portMUX_INITIALIZER_UNLOCKED;
+
+  static void push(tote_trace& t, const char* name, char ph) {
+    if (t.start_us == 0) return;            // sin begin() no hay ciclo abierto
+    if (t.count >= TOTE_TRACE_MAX) return;  // trazas largas se truncan, nunca bloquean
+    trace_mark& m = t.marks[t.count++];
+    m.name = name;
+    m.t_us = (uint32_t)(esp_timer_get_time() - t.start_us);
+    m.ph   = ph;
+  }
+
+  void begin(tote_trace& t) {
+    t.start_us = esp_timer_get_time();
+    t.count    = 0;
+  }
+
+  void state(tote_trace& t, const char* name) {
+    push(t, name, 'B');
+  }
+
+  void event(tote_trace& t, const char* name) {
+    push(t, name, 'i');
+  }
+
+  int32_t stateMs(const tote_trace& t, const char* name) {
+    for (uint8_t i = 0; i < t.count; i++) {
+      if (t.marks[i].ph != 'B' || strcmp(t.marks[i].name, name) != 0) continue;
+      for (uint8_t j = i + 1; j < t.count; j++) {
+        if (t.marks[j].ph == 'B') return (t.marks[j].t_us - t.marks[i].t_us) / 1000;
+      }
+      return -1;  // todavía en ese estado
+    }
+    return -1;
+  }
+
+  int32_t eventMs(const tote_trace& t, const char* name) {
+    for (uint8_t i = 0; i < t.count; i++) {
+      if (t.marks[i].ph == 'i' && strcmp(t.marks[i].name, name) == 0) return t.marks[i].t_us / 1000;
+    }
+    return -1;
+  }
+
+  void archive(const char* toteId, const tote_trace& t) {
+    if (t.count == 0) return;
+    portENTER_CRITICAL(&s_mux);
+    Entry& e = s_history[s_head];
+    strncpy(e.id, toteId && toteId[0] ? toteId : "(no id)", ID_SIZE - 1);
+    e.id[ID_SIZE - 1] = '\0';
+    e.trace = t;
+    s_head  = (s_head + 1) % TRACE_HISTORY;
+    if (s_count < TRACE_HISTORY) s_count++;
+    portEXIT_CRITICAL(&s_mux);
+  }
+
+  void toJson(const tote_trace& t, JsonArray out) {
+    for (uint8_t i = 0; i < t.count; i++) {
+      JsonArray m = out.createNestedArray();
+      m.add(t.marks[i].name);
+      m.add(t.marks[i].t_us / 1000);
+    }
+  }
+
+  void writeChromeJson(Print& out) {
+    out.print("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool first = true;
+
+    for (uint8_t n = 0; n < s_count; n++) {
+      // Oldest first; copy under lock so archive() can't tear the entry
+      Entry e;
+      portENTER_CRITICAL(&s_mux);
+      e = s_history[(s_head + TRACE_HISTORY - s_count + n) % TRACE_HISTORY];
+      portEXIT_CRITICAL(&s_mux);
+
+      const uint32_t tid = n + 1;
+      out.printf("%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                 first ? "" : ",", tid, e.id);
+      first = false;
+
+      const tote_trace& t = e.trace;
+      const uint32_t end_us = t.count ? t.marks[t.count - 1].t_us : 0;
+      for (uint8_t i = 0; i < t.count; i++) {
+        const trace_mark& m = t.marks[i];
+        const uint64_t ts = (uint64_t)t.start_us + m.t_us;
+        if (m.ph == 'B') {
+          uint32_t next = end_us;
+          for (uint8_t j = i + 1; j < t.count; j++) {
+            if (t.marks[j].ph == 'B') { next = t.marks[j].t_us; break; }
+          }
+          out.printf(",{\"name\":\"%s\",\"cat\":\"state\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%llu,\"dur\":%u}",
+                     m.name, tid, ts, next - m.t_us);
+        } else {
+          out.printf(",{\"name\":\"%s\",\"cat\":\"event\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%llu}",
+                     m.name, tid, ts);
+        }
+      }
+    }
+    out.print("]}");
+  }
+
+} // namespace Trace
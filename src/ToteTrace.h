@@ -0,0 +1,42 @@
+#pragma once
+// ============================================================
+// ToteTrace  —  Per-tote cycle-time tracer
+//
+// Each ToteState transition and key sub-event (pumps, tare, QR,
+// validation, PUT) is stamped with esp_timer_get_time() into the
+// tote's tote_trace (Types.h). The trace travels with the backend
+// PUT and the last TRACE_HISTORY cycles are kept in RAM for
+// GET /trace.json (Chrome trace-event format, open in
+// chrome://tracing or ui.perfetto.dev).
+// ============================================================
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "Types.h"
+
+#define TRACE_HISTORY 8
+
+namespace Trace {
+  /** Resets the trace and sets t=0 to now. */
+  void begin(tote_trace& t);
+
+  /** Entry into a ToteState (rendered as a span until the next state). */
+  void state(tote_trace& t, const char* name);
+
+  /** Instant sub-event (pump on/off, tare done, QR received, ...). */
+  void event(tote_trace& t, const char* name);
+
+  /** Milliseconds spent in `name` (first entry until the next state), -1 if absent. */
+  int32_t stateMs(const tote_trace& t, const char* name);
+
+  /** Milliseconds from START to the first `name` event, -1 if absent. */
+  int32_t eventMs(const tote_trace& t, const char* name);
+
+  /** Copies a finished cycle into the history ring. */
+  void archive(const char* toteId, const tote_trace& t);
+
+  /** Appends [[name, t_ms], ...] for the backend payload. */
+  void toJson(const tote_trace& t, JsonArray out);
+
+  /** History ring as Chrome trace-event JSON. */
+  void writeChromeJson(Print& out);
+}
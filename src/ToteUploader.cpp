@@ -0,0 +1,138 @@
+// ============================================================
+// ToteUploader.cpp  —  Backend PUT of finished totes in the background
+// ============================================================
+#include "ToteUploader.h"
+#include <WiFi.h>
+#include <HTTPClient.h>
+#include "Debug.h"
+
+namespace ToteUploader {
+
+  static portMUX_TYPE  s_mux  = portMUX_INITIALIZER_UNLOCKED;
+  static TaskHandle_t  s_task = nullptr;
+
+  // One per lane. Flags guarded by s_mux; id/payload belong to the loop
+  // while !pending and to the worker while pending (no heap work under
+  // the spinlock)
+  struct Slot {
+    char     id[ID_SIZE];
+    String   payload;
+    bool     pending;
+    uint32_t submitMs;
+    Result   result;
+    bool     fresh;     // result not taken yet
+  };
+  static Slot s_slots[LANE_COUNT];
+
+  // ── Backend ─────────────────────────────────────────────────────────────────
+  static int put(const char* id, const String& payload) {
+    if (WiFi.status() != WL_CONNECTED) {
+      LOG_ERR("WiFi not connected, cannot update backend\n");
+      return 0;
+    }
+
+    HTTPClient http;
+    String url = String(BACKEND_URL) + "/api/totes/" + String(id);
+
+    LOG_MAIN("\n=== Updating Backend ===\n");
+    LOG_MAIN("PUT: %s (%u bytes)\n", url.c_str(), payload.length());
+
+    http.begin(url);
+    http.addHeader("Content-Type", "application/json");
+    http.setTimeout(10000); // 10 seconds timeout
+
+    const int httpCode = http.PUT(payload);
+
+    if (httpCode > 0) {
+      LOG_MAIN("HTTP Response code: %d\n", httpCode);
+      String response = http.getString();
+      LOG_MAIN("Response: %s\n", response.c_str());
+    }
+    else {
+      LOG_ERR("HTTP PUT failed, error: %s\n", http.errorToString(httpCode).c_str());
+    }
+
+    http.end();
+    return httpCode;
+  }
+
+  // ── Worker ──────────────────────────────────────────────────────────────────
+  static bool uploadNext() {
+    uint32_t t0 = 0;
+    int      lane = -1;
+    portENTER_CRITICAL(&s_mux);
+    for (uint8_t i = 0; i < LANE_COUNT; i++) {
+      if (s_slots[i].pending) {
+        lane = i;
+        t0   = s_slots[i].submitMs;
+        break;
+      }
+    }
+    portEXIT_CRITICAL(&s_mux);
+    if (lane < 0) return false;
+
+    Slot& s = s_slots[lane];
+    const int code = put(s.id, s.payload);
+    const uint32_t latency = millis() - t0;
+    LOG_MAIN("Tote %s: PUT %s in %lu ms\n", s.id, code == 200 ? "ok" : "failed", (unsigned long)latency);
+    s.payload = String();   // free it before handing the slot back
+
+    portENTER_CRITICAL(&s_mux);
+    s.result  = {code == 200, code, latency};
+    s.pending = false;
+    s.fresh   = true;
+    portEXIT_CRITICAL(&s_mux);
+    return true;
+  }
+
+  static void worker(void*) {
+    for (;;) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      while (uploadNext()) {}
+    }
+  }
+
+  // ── API ─────────────────────────────────────────────────────────────────────
+  void begin() {
+    if (s_task) return;
+    // HTTPClient + the payload String: same budget as the validator
+    xTaskCreatePinnedToCore(worker, "toteUploader", 8192, nullptr, 1, &s_task, 0);
+  }
+
+  bool submit(uint8_t lane, const char* toteId, String& payload) {
+    if (lane >= LANE_COUNT || payload.length() == 0 || pending(lane)) return false;
+
+    Slot& s = s_slots[lane];
+    strncpy(s.id, toteId, ID_SIZE - 1);
+    s.id[ID_SIZE - 1] = '\0';
+    s.payload = std::move(payload);
+
+    portENTER_CRITICAL(&s_mux);
+    s.pending  = true;
+    s.fresh    = false;
+    s.submitMs = millis();
+    portEXIT_CRITICAL(&s_mux);
+
+    if (s_task) xTaskNotifyGive(s_task);
+    return true;
+  }
+
+  bool pending(uint8_t lane) {
+    if (lane >= LANE_COUNT) return false;
+    portENTER_CRITICAL(&s_mux);
+    const bool p = s_slots[lane].pending;
+    portEXIT_CRITICAL(&s_mux);
+    return p;
+  }
+
+  bool takeResult(uint8_t lane, Result& out) {
+    if (lane >= LANE_COUNT) return false;
+    portENTER_CRITICAL(&s_mux);
+    Slot& s = s_slots[lane];
+    const bool fresh = s.fresh;
+    if (fresh) out = s.result;
+    s.fresh = false;
+    portEXIT_CRITICAL(&s_mux);
+    return fresh;
+  }
+}
@@ -0,0 +1,39 @@
+#pragma once
+// ============================================================
+// ToteUploader  —  Backend PUT of finished totes in the background
+//
+// The loop builds the tote record (main.cpp totePayload()) and
+// hands it over; a worker task (core 0) does the PUT
+// /api/totes/<id>, up to 10 s on a bad link. With several lanes
+// (Lane.h) a blocking PUT in COMPLETED would stall the others'
+// dosing loops while their pumps run; this keeps them stepping.
+//
+// Same shape as ToteValidator: one slot per lane, submit() from
+// the loop, takeResult() polled from the loop.
+// ============================================================
+#include <Arduino.h>
+#include "config.h"
+
+namespace ToteUploader {
+
+  struct Result {
+    bool     ok;            // HTTP 200
+    int      httpCode;      // < 0: HTTPClient error, 0: no WiFi
+    uint32_t latency_ms;    // submit → answer
+  };
+
+  /** Starts the worker task. Call once in setup(). */
+  void begin();
+
+  /**
+   * Queues the PUT of payload for toteId (loop task only). Takes the
+   * payload's buffer. False if the lane still has an upload in flight.
+   */
+  bool submit(uint8_t lane, const char* toteId, String& payload);
+
+  /** True while the lane's upload is queued or in flight. */
+  bool pending(uint8_t lane);
+
+  /** The lane's answer, once: true the first call after it arrives. */
+  bool takeResult(uint8_t lane, Result& out);
+}
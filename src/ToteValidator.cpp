@@ -0,0 +1,211 @@
+// ============================================================
+// ToteValidator.cpp  —  Backend tote-ID check in the background
+// ============================================================
+#include "ToteValidator.h"
+#include <WiFi.h>
+#include <HTTPClient.h>
+#include <ArduinoJson.h>
+#include "Debug.h"
+
+namespace ToteValidator {
+
+  static portMUX_TYPE  s_mux    = portMUX_INITIALIZER_UNLOCKED;
+  static TaskHandle_t  s_task   = nullptr;
+
+  // One per lane, guarded by s_mux
+  struct Slot {
+    char      id[ID_SIZE];
+    uint32_t  gen;        // bumped by submit()/reset()
+    uint32_t  submitMs;
+    Status    status;
+    Result    result;
+    bool      fresh;      // result not taken yet
+  };
+  static Slot s_slots[LANE_COUNT] = {};
+
+  // ── Backend ─────────────────────────────────────────────────────────────────
+  static Status check(const char* id, float& raw_kg) {
+    raw_kg = NAN;
+    if (WiFi.status() != WL_CONNECTED) {
+      LOG_ERR("WiFi not connected, cannot validate ID\n");
+      return Status::FAILED;
+    }
+
+    HTTPClient http;
+    String url = String(BACKEND_URL) + "/api/totes/" + id;
+    
+    LOG_MAIN("GET: %s\n", url.c_str());
+    
+    http.begin(url);
+    http.setTimeout(5000); // 5 seconds timeout
+    
+    const int httpCode = http.GET();
+    Status status = Status::FAILED;
+    
+    if (httpCode == 200) {
+      String payload = http.getString();
+      LOG_MAIN("Tote found in backend\n");
+      
+      // Parse JSON response
+      DynamicJsonDocument doc(1024);
+      DeserializationError error = deserializeJson(doc, payload);
+      
+      if (!error) {
+        const char* confirmed = doc["tote"]["tote_id"];
+        LOG_MAIN("Backend confirmed tote ID: %s\n", confirmed);
+        
+        // raw_kg from inbound, used later to calculate fish weight
+        if (doc["tote"].containsKey("raw_kg")) {
+          raw_kg = doc["tote"]["raw_kg"].as<float>();
+          LOG_MAIN("Raw weight from inbound: %.2f kg\n", raw_kg);
+        }
+      }
+      status = Status::VALID;
+    }
+    else if (httpCode == 404) {
+      LOG_ERR("Tote ID not found (404)\n");
+      status = Status::REJECTED;
+    }
+    else if (httpCode > 0) {
+      LOG_ERR("HTTP Response code: %d\n", httpCode);
+    }
+    else {
+      LOG_ERR("HTTP GET failed, error: %s\n", http.errorToString(httpCode).c_str());
+    }
+    
+    http.end();
+    return status;
+  }
+
+  // ── Worker ──────────────────────────────────────────────────────────────────
+  // Validates the oldest pending submission; false when none is left
+  static bool validateNext() {
+    char     id[ID_SIZE];
+    uint32_t gen = 0, t0 = 0;
+    int      lane = -1;
+    portENTER_CRITICAL(&s_mux);
+    for (uint8_t i = 0; i < LANE_COUNT; i++) {
+      const Slot& s = s_slots[i];
+      if (s.status == Status::PENDING && (lane < 0 || (int32_t)(s.submitMs - t0) < 0)) {
+        lane = i;
+        t0   = s.submitMs;
+      }
+    }
+    if (lane >= 0) {
+      memcpy(id, s_slots[lane].id, sizeof(id));
+      gen = s_slots[lane].gen;
+    }
+    portEXIT_CRITICAL(&s_mux);
+    if (lane < 0) return false;
+
+    LOG_MAIN("Validating Tote ID '%s' (lane %d) with backend...\n", id, lane);
+    float raw_kg;
+    const Status st = check(id, raw_kg);
+    const uint32_t latency = millis() - t0;
+
+    portENTER_CRITICAL(&s_mux);
+    Slot& s = s_slots[lane];
+    const bool current = gen == s.gen;   // not superseded or reset meanwhile
+    if (current) {
+      s.status = st;
+      s.result.status     = st;
+      memcpy(s.result.id, id, sizeof(id));
+      s.result.raw_kg     = raw_kg;
+      s.result.latency_ms = latency;
+      s.fresh = true;
+    }
+    portEXIT_CRITICAL(&s_mux);
+    LOG_MAIN("Tote ID '%s': %s in %lu ms%s\n", id, statusName(st), (unsigned long)latency,
+             current ? "" : " (stale, dropped)");
+    // Stale: the slot is PENDING again with the newer ID, or reset
+    return true;
+  }
+
+  static void worker(void*) {
+    for (;;) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      while (validateNext()) {}
+    }
+  }
+
+  // ── API ─────────────────────────────────────────────────────────────────────
+  void begin() {
+    if (s_task) return;
+    // HTTPClient + DynamicJsonDocument(1024): same budget as communicationTask
+    xTaskCreatePinnedToCore(worker, "toteValidator", 8192, nullptr, 1, &s_task, 0);
+  }
+
+  bool submit(uint8_t lane, const char* id) {
+    if (lane >= LANE_COUNT) return false;
+    const size_t len = strlen(id);
+    if (len == 0 || len >= ID_SIZE) {
+      LOG_ERR("Tote ID length %u not accepted\n", (unsigned)len);
+      return false;
+    }
+
+    portENTER_CRITICAL(&s_mux);
+    Slot& s = s_slots[lane];
+    const bool same = (s.status == Status::PENDING || s.status == Status::VALID) && strcmp(s.id, id) == 0;
+    if (!same) {
+      memcpy(s.id, id, len + 1);
+      s.gen++;
+      s.submitMs = millis();
+      s.status   = Status::PENDING;
+      s.fresh    = false;
+    }
+    portEXIT_CRITICAL(&s_mux);
+
+    if (!same && s_task) xTaskNotifyGive(s_task);
+    return true;
+  }
+
+  Status status(uint8_t lane) {
+    if (lane >= LANE_COUNT) return Status::NONE;
+    portENTER_CRITICAL(&s_mux);
+    const Status s = s_slots[lane].status;
+    portEXIT_CRITICAL(&s_mux);
+    return s;
+  }
+
+  void currentId(uint8_t lane, char* out, size_t size) {
+    out[0] = '\0';
+    if (lane >= LANE_COUNT) return;
+    portENTER_CRITICAL(&s_mux);
+    strncpy(out, s_slots[lane].id, size);
+    portEXIT_CRITICAL(&s_mux);
+    out[size - 1] = '\0';
+  }
+
+  bool takeResult(uint8_t lane, Result& out) {
+    if (lane >= LANE_COUNT) return false;
+    portENTER_CRITICAL(&s_mux);
+    Slot& s = s_slots[lane];
+    const bool fresh = s.fresh;
+    if (fresh) out = s.result;
+    s.fresh = false;
+    portEXIT_CRITICAL(&s_mux);
+    return fresh;
+  }
+
+  void reset(uint8_t lane) {
+    if (lane >= LANE_COUNT) return;
+    portENTER_CRITICAL(&s_mux);
+    Slot& s = s_slots[lane];
+    s.id[0]  = '\0';
+    s.gen++;
+    s.status = Status::NONE;
+    s.fresh  = false;
+    portEXIT_CRITICAL(&s_mux);
+  }
+
+  const char* statusName(Status s) {
+    switch (s) {
+      case Status::NONE:     return "none";
+      case Status::PENDING:  return "pending";
+      case Status::VALID:    return "valid";
+      case Status::REJECTED: return "rejected";
+      case Status::FAILED:   return "failed";
+    }
+    return "?";
+  }
+}
@@ -0,0 +1,61 @@
+#pragma once
+// ============================================================
+// ToteValidator  —  Backend tote-ID check in the background
+//
+// A scanned ID is handed to a worker task (core 0) that does the
+// GET /api/totes/<id>; the loop picks the outcome up later. This
+// lets the station accept the QR at any point after START and have
+// the ID validated while water and ice are still going in, instead
+// of blocking the caller for up to 5 s in WAITING_TOTE_ID.
+//
+// submit() may be called from any task (BLE, AsyncTCP, loop);
+// takeResult() from the loop. A newer submit() or reset() makes an
+// in-flight answer stale, it's dropped when it arrives.
+//
+// One slot per lane (LANE_COUNT, see Lane.h): each filling position
+// validates its own tote; one worker serves them in turn.
+// ============================================================
+#include <Arduino.h>
+#include "config.h"
+
+namespace ToteValidator {
+
+  enum class Status : uint8_t {
+    NONE,       // nothing submitted for this tote
+    PENDING,    // request queued or in flight
+    VALID,      // backend knows the ID
+    REJECTED,   // 404 / unknown ID
+    FAILED      // no WiFi, timeout, HTTP error: worth retrying
+  };
+
+  struct Result {
+    Status   status;
+    char     id[ID_SIZE];
+    float    raw_kg;        // tote.raw_kg from inbound, NAN if the backend had none
+    uint32_t latency_ms;    // submit → answer
+  };
+
+  /** Starts the worker task. Call once in setup(). */
+  void begin();
+
+  /**
+   * Queues validation of id for a lane. Re-submitting the ID already
+   * pending or validated is a no-op. False if the ID doesn't fit in
+   * tote_data.id.
+   */
+  bool submit(uint8_t lane, const char* id);
+
+  /** Status of the lane's latest submission. */
+  Status status(uint8_t lane);
+
+  /** ID of the lane's latest submission ("" if none). */
+  void currentId(uint8_t lane, char* out, size_t size);
+
+  /** The lane's latest answer, once: true the first call after it arrives. */
+  bool takeResult(uint8_t lane, Result& out);
+
+  /** New tote / cancel: forget the lane's ID and any answer still on its way. */
+  void reset(uint8_t lane);
+
+  const char* statusName(Status s);
+}
@@ -0,0 +1,144 @@
+// ============================================================
+// WeightRecorder.cpp  —  Compressed per-tote weight curves
+// ============================================================
+#include "WeightRecorder.h"
+#include "esp_heap_caps.h"
+#include "core/WeightTraceCodec.h"
+#include "Debug.h"
+
+namespace WeightRecorder {
+
+  struct Slot {
+    uint8_t*                  buf;
+    WeightTraceCodec::Encoder enc;
+    char                      id[ID_SIZE];
+  };
+
+  // Open trace of one lane
+  struct Writer {
+    int8_t   slot;      // -1 = closed
+    uint32_t t0;
+    uint32_t dropped;
+  };
+
+  static Slot     s_slots[WEIGHT_TRACE_SLOTS];
+  static uint8_t  s_nslots  = 0;
+  static uint8_t  s_current = 0;   // newest slot (being written or last written)
+  static uint8_t  s_count   = 0;
+  static Writer   s_writers[LANE_COUNT];
+  // Writers on the lanes' task, readers on AsyncTCP / communicationTask
+  static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+
+  static bool inUse(uint8_t slot) {
+    for (uint8_t l = 0; l < LANE_COUNT; l++) {
+      if (s_writers[l].slot == (int8_t)slot) return true;
+    }
+    return false;
+  }
+
+  void begin() {
+    for (uint8_t l = 0; l < LANE_COUNT; l++) s_writers[l] = {-1, 0, 0};
+
+    uint8_t wanted = WEIGHT_TRACE_SLOTS;
+    uint32_t caps  = MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT;
+    if (heap_caps_get_free_size(MALLOC_CAP_SPIRAM) < (size_t)WEIGHT_TRACE_SLOTS * WEIGHT_TRACE_BYTES) {
+      wanted = WEIGHT_TRACE_SLOTS_NOPSRAM;
+      caps   = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+    }
+
+    for (s_nslots = 0; s_nslots < wanted; s_nslots++) {
+      uint8_t* buf = (uint8_t*)heap_caps_malloc(WEIGHT_TRACE_BYTES, caps);
+      if (!buf) break;
+      s_slots[s_nslots].buf   = buf;
+      s_slots[s_nslots].id[0] = '\0';
+    }
+
+    LOG_MAIN("[WeightRecorder] %u slots x %u bytes in %s\n", s_nslots, WEIGHT_TRACE_BYTES,
+             (caps & MALLOC_CAP_SPIRAM) ? "PSRAM" : "internal RAM");
+  }
+
+  void start(uint8_t lane) {
+    if (s_nslots == 0 || lane >= LANE_COUNT) return;
+    portENTER_CRITICAL(&s_mux);
+    Writer& w = s_writers[lane];
+    w.slot = -1;   // a restart drops the lane's unfinished trace
+
+    // Next slot in ring order that no other lane is writing
+    uint8_t next = s_count > 0 ? (s_current + 1) % s_nslots : s_current;
+    uint8_t tries = 0;
+    while (inUse(next) && ++tries < s_nslots) next = (next + 1) % s_nslots;
+    if (inUse(next)) {   // every slot busy: this cycle goes unrecorded
+      portEXIT_CRITICAL(&s_mux);
+      return;
+    }
+
+    s_current = next;
+    Slot& slot = s_slots[s_current];
+    slot.enc.reset(slot.buf, WEIGHT_TRACE_BYTES);
+    slot.id[0] = '\0';
+    if (s_count < s_nslots) s_count++;
+    w = {(int8_t)s_current, millis(), 0};
+    portEXIT_CRITICAL(&s_mux);
+  }
+
+  void sample(uint8_t lane, float kg) {
+    if (lane >= LANE_COUNT || s_writers[lane].slot < 0 || isnan(kg)) return;
+    Writer& w = s_writers[lane];
+    const int32_t grams = (int32_t)lroundf(kg * 1000.0f);
+    const uint32_t t    = millis() - w.t0;
+    portENTER_CRITICAL(&s_mux);
+    if (!s_slots[w.slot].enc.add(t, grams)) w.dropped++;
+    portEXIT_CRITICAL(&s_mux);
+  }
+
+  void finish(uint8_t lane, const char* toteId) {
+    if (lane >= LANE_COUNT || s_writers[lane].slot < 0) return;
+    Writer& w = s_writers[lane];
+    Slot& slot = s_slots[w.slot];
+    portENTER_CRITICAL(&s_mux);
+    strncpy(slot.id, toteId ? toteId : "", ID_SIZE - 1);
+    slot.id[ID_SIZE - 1] = '\0';
+    w.slot = -1;
+    portEXIT_CRITICAL(&s_mux);
+    LOG_MAIN("[WeightRecorder] %u samples → %u bytes (%.1fx)%s\n",
+             slot.enc.count(), slot.enc.size(),
+             slot.enc.size() ? (slot.enc.count() * 8.0f) / slot.enc.size() : 0.0f,
+             w.dropped ? " (buffer full, tail dropped)" : "");
+  }
+
+  // s_mux held
+  static void copy(const Slot& slot, uint8_t* buf, View& out) {
+    out.size    = slot.enc.size();
+    out.samples = slot.enc.count();
+    memcpy(buf, slot.buf, out.size);   // ≤ WEIGHT_TRACE_BYTES, ~2 bytes/sample
+    memcpy(out.toteId, slot.id, ID_SIZE);
+    out.data = buf;
+  }
+
+  bool get(uint8_t i, uint8_t* buf, View& out) {
+    portENTER_CRITICAL(&s_mux);
+    const bool ok = i < s_count;
+    if (ok) copy(s_slots[(s_current + s_nslots - i) % s_nslots], buf, out);
+    portEXIT_CRITICAL(&s_mux);
+    return ok;
+  }
+
+  bool find(const char* toteId, uint8_t* buf, View& out) {
+    if (!toteId || !toteId[0]) return false;
+    portENTER_CRITICAL(&s_mux);
+    bool ok = false;
+    for (uint8_t i = 0; i < s_count && !ok; i++) {
+      const uint8_t k = (s_current + s_nslots - i) % s_nslots;
+      if (inUse(k) || strcmp(s_slots[k].id, toteId) != 0) continue;
+      copy(s_slots[k], buf, out);
+      ok = true;
+    }
+    portEXIT_CRITICAL(&s_mux);
+    return ok;
+  }
+
+  uint8_t count() {
+    return s_count;
+  }
+
+} // namespace WeightRecorder
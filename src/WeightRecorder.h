@@ -0,0 +1,56 @@
+#pragma once
+// ============================================================
+// WeightRecorder  —  Full weight curve of each tote
+//
+// Every scale sample taken during DISPENSING_WATER, DISPENSING_ICE
+// and SETTLING_ICE is appended to a per-tote buffer compressed with
+// WeightTraceCodec (delta + zigzag varint, ~2 bytes/sample).
+// The last WEIGHT_TRACE_SLOTS cycles are kept in a ring, in PSRAM
+// when the module has it. The current trace is uploaded with the
+// tote record; older ones via GET /weight_trace?i=N.
+// Decode with tools/weight_trace.py.
+//
+// Each lane (Lane.h) has its own open trace; the ring is shared and
+// a new trace never takes a slot another lane is still writing.
+// Readers (web server, uploader) run on other tasks and get a copy.
+// ============================================================
+#include <Arduino.h>
+#include "config.h"
+
+#define WEIGHT_TRACE_SLOTS        8      // ring depth with PSRAM
+#define WEIGHT_TRACE_SLOTS_NOPSRAM 2     // ring depth in internal RAM
+#define WEIGHT_TRACE_BYTES        8192   // ≈ 3500 samples ≈ 2.5 min at loop rate
+
+namespace WeightRecorder {
+  /** Allocates the ring. Call once in setup(). */
+  void begin();
+
+  /** Starts a new trace for the lane in the next free ring slot (overwrites the oldest). */
+  void start(uint8_t lane);
+
+  /** Appends one scale sample to the lane's open trace (no-op when closed or full). */
+  void sample(uint8_t lane, float kg);
+
+  /** Closes the lane's open trace and tags it with the tote ID. */
+  void finish(uint8_t lane, const char* toteId);
+
+  // A copy: the ring slot behind it can be reused by start() at any time
+  struct View {
+    const uint8_t* data;             // the caller's buffer
+    size_t         size;
+    uint32_t       samples;
+    char           toteId[ID_SIZE];
+  };
+
+  /**
+   * Copies trace i (0 → most recent, open or last finished) into buf,
+   * WEIGHT_TRACE_BYTES long, under the recorder's lock. False if none.
+   */
+  bool get(uint8_t i, uint8_t* buf, View& out);
+
+  /** Same for the most recent finished trace tagged with toteId. */
+  bool find(const char* toteId, uint8_t* buf, View& out);
+
+  /** Number of traces held. */
+  uint8_t count();
+}
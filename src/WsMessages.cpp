@@ -0,0 +1,94 @@
+#include "WsMessages.h"
+
+namespace WsMsg {
+
+  const char* STATION = "outbound";
+
+  template <class Doc>
+  static size_t emit(const Doc& doc, String& out) {
+    out = "";
+    serializeJson(doc, out);
+    return out.length();
+  }
+
+  size_t identify(String& out, const char* const* stations, uint8_t count) {
+    StaticJsonDocument<256> doc;
+    doc["type"] = "identify";
+    doc["clientType"] = "esp32";
+    if (stations && count > 1) {
+      JsonArray list = doc.createNestedArray("stations");
+      for (uint8_t i = 0; i < count; i++) list.add(stations[i]);
+    }
+    return emit(doc, out);
+  }
+
+  size_t heartbeat(String& out) {
+    StaticJsonDocument<128> doc;
+    doc["type"] = "heartbeat";
+    doc["station"] = STATION;
+    return emit(doc, out);
+  }
+
+  size_t weightUpdate(String& out, float weight, const char* station) {
+    StaticJsonDocument<128> doc;
+    doc["type"] = "weight_update";
+    doc["station"] = station;
+    doc["weight"] = weight;
+    return emit(doc, out);
+  }
+
+  size_t stateChange(String& out, const char* state, const char* station) {
+    StaticJsonDocument<128> doc;
+    doc["type"] = "state_change";
+    doc["station"] = station;
+    doc["state"] = state;
+    return emit(doc, out);
+  }
+
+  size_t toteEvent(String& out, const char* type, const char* toteId, const char* station) {
+    StaticJsonDocument<128> doc;
+    doc["type"] = type;
+    doc["station"] = station;
+    doc["toteId"] = toteId;
+    return emit(doc, out);
+  }
+
+  size_t dispensed(String& out, const char* type, const char* field, float kg, const char* station) {
+    StaticJsonDocument<128> doc;
+    doc["type"] = type;
+    doc["station"] = station;
+    doc[field] = kg;
+    return emit(doc, out);
+  }
+
+  size_t error(String& out, const char* message, const char* station) {
+    StaticJsonDocument<256> doc;
+    doc["type"] = "error";
+    doc["station"] = station;
+    doc["message"] = message;
+    return emit(doc, out);
+  }
+
+  size_t settingsCurrent(String& out, float ice_kg, float water_kg, float min_w, bool auto_start) {
+    StaticJsonDocument<192> doc;
+    doc["type"]     = "settings_current";
+    doc["station"]  = STATION;
+    doc["ice_kg"]   = ice_kg;
+    doc["water_kg"] = water_kg;
+    doc["min_w"]    = min_w;
+    doc["auto_start"] = auto_start;
+    return emit(doc, out);
+  }
+
+  size_t stats(String& out, JsonDocument& stats) {
+    stats["type"]    = "stats";
+    stats["station"] = STATION;
+    return emit(stats, out);
+  }
+
+  const char* decode(const char* payload, size_t length, JsonDocument& doc, DeserializationError& err) {
+    err = deserializeJson(doc, payload, length);
+    if (err) return nullptr;
+    return doc["type"];
+  }
+}
@@ -0,0 +1,44 @@
+#pragma once
+// ============================================================
+// WsMessages  —  JSON wire format of the station ⇄ backend socket
+//
+// Encoders and the decoder ToteWebSocketClient uses, kept apart
+// from the WebSocketsClient transport so they can be built and
+// benchmarked natively (env:native). Document sizes are the ones
+// the client has always used.
+// ============================================================
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+namespace WsMsg {
+
+  // Station field on every outgoing message: the first lane's, and the
+  // default for messages that aren't about one lane (heartbeat, settings,
+  // stats). Other lanes pass their own (LANE_TABLE in config.h).
+  extern const char* STATION;
+
+  // Room for incoming messages (commands, qr_scanned, settings...)
+  typedef StaticJsonDocument<512> InDoc;
+
+  // ── Encoders: serialize into out, return its length ───────────────────────
+  /** stations: every lane's station when there is more than one (else omitted) */
+  size_t identify(String& out, const char* const* stations = nullptr, uint8_t count = 0);
+  size_t heartbeat(String& out);
+  size_t weightUpdate(String& out, float weight, const char* station = STATION);
+  size_t stateChange(String& out, const char* state, const char* station = STATION);
+  /** tote_validated / tote_completed */
+  size_t toteEvent(String& out, const char* type, const char* toteId, const char* station = STATION);
+  /** ice_dispensed / water_dispensed; field is "ice_kg" or "water_kg" */
+  size_t dispensed(String& out, const char* type, const char* field, float kg, const char* station = STATION);
+  size_t error(String& out, const char* message, const char* station = STATION);
+  size_t settingsCurrent(String& out, float ice_kg, float water_kg, float min_w, bool auto_start);
+  /** Adds type/station to a Stats::toJson() document and serializes it */
+  size_t stats(String& out, JsonDocument& stats);
+
+  // ── Decoder ───────────────────────────────────────────────────────────────
+  /**
+   * Parses payload into doc. Returns the "type" field, or nullptr if
+   * the JSON is invalid (err set) or has no type (err == Ok).
+   */
+  const char* decode(const char* payload, size_t length, JsonDocument& doc, DeserializationError& err);
+}
@@ -0,0 +1,45 @@
+// ============================================================
+// Alloc.cpp  —  Heap call counting for the native benchmarks
+//
+// glibc lets the program define malloc & co. and forward to the
+// __libc_* originals, which catches String, ArduinoJson and
+// operator new alike. Elsewhere the counters stay at zero and
+// the report says so.
+// ============================================================
+#include <stddef.h>
+#include <atomic>
+#include "Bench.h"
+
+static std::atomic<uint64_t> s_allocs{0};
+static std::atomic<uint64_t> s_bytes{0};
+
+static inline void count(size_t n) {
+  s_allocs.fetch_add(1, std::memory_order_relaxed);
+  s_bytes.fetch_add(n, std::memory_order_relaxed);
+}
+
+#if defined(__GLIBC__)
+extern "C" {
+  void* __libc_malloc(size_t);
+  void* __libc_calloc(size_t, size_t);
+  void* __libc_realloc(void*, size_t);
+  void  __libc_free(void*);
+
+  void* malloc(size_t n)            { count(n); return __libc_malloc(n); }
+  void* calloc(size_t c, size_t n)  { count(c * n); return __libc_calloc(c, n); }
+  void* realloc(void* p, size_t n)  { count(n); return __libc_realloc(p, n); }
+  void  free(void* p)               { __libc_free(p); }
+}
+#endif
+
+namespace Bench {
+  Heap heap() { return Heap{s_allocs.load(std::memory_order_relaxed), s_bytes.load(std::memory_order_relaxed)}; }
+
+  bool heapCounting() {
+#if defined(__GLIBC__)
+    return true;
+#else
+    return false;
+#endif
+  }
+}
@@ -0,0 +1,84 @@
+#pragma once
+// ============================================================
+// Bench  —  Micro-benchmark harness for env:native
+//
+// Each case is a callable run in batches until it has used at
+// least the minimum time; reported per operation:
+//   ns_per_op      wall time (steady_clock)
+//   allocs_per_op  malloc/calloc/realloc calls (Alloc.cpp)
+//   bytes_per_op   bytes requested from the heap
+// plus an optional case-specific counter (e.g. I2C bytes).
+//
+// The host String shim allocates like arduino-esp32's (SSO up to
+// 11 chars, realloc growth), so allocs/op tracks what the same
+// code does to the ESP32 heap; ns/op is host time, useful run to
+// run, not as an absolute device figure.
+// ============================================================
+#include <stdint.h>
+#include <chrono>
+#include <vector>
+
+namespace Bench {
+
+  // ── Heap counters (Alloc.cpp) ─────────────────────────────────────────────
+  struct Heap {
+    uint64_t allocs;
+    uint64_t bytes;
+  };
+  Heap heap();
+  bool heapCounting();   // false where malloc can't be interposed
+
+  // Keeps a value alive so the optimizer can't drop the work producing it
+  template <class T>
+  inline void keep(const T& v) { asm volatile("" : : "g"(&v) : "memory"); }
+
+  struct Result {
+    const char* name;
+    uint64_t    iters;
+    double      ns_per_op;
+    double      allocs_per_op;
+    double      bytes_per_op;
+    const char* extra_name;    // nullptr if the case has no extra counter
+    double      extra_per_op;
+  };
+
+  /**
+   * Runs fn() in batches (doubling from 1) until one takes min_ms,
+   * then repeats that batch `reps` times and keeps the fastest, which
+   * is what's stable from run to run. extra, if given, is a counter
+   * read around the batch.
+   */
+  template <class F>
+  Result run(const char* name, F&& fn, uint32_t min_ms, uint32_t reps,
+             const char* extra_name = nullptr, const uint32_t* extra = nullptr) {
+    using Clock = std::chrono::steady_clock;
+    fn();   // warm-up: first-call allocations, caches
+
+    Result r{name, 0, 0, 0, 0, extra_name, 0};
+    auto batch = [&](uint64_t n) {
+      const Heap     h0 = heap();
+      const uint32_t e0 = extra ? *extra : 0;
+      const auto     t0 = Clock::now();
+      for (uint64_t i = 0; i < n; i++) fn();
+      const auto     t1 = Clock::now();
+      const Heap     h1 = heap();
+      const uint32_t e1 = extra ? *extra : 0;
+
+      const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+      if (r.iters == 0 || ns / n < r.ns_per_op) r.ns_per_op = ns / n;
+      r.iters         = n;
+      r.allocs_per_op = double(h1.allocs - h0.allocs) / n;
+      r.bytes_per_op  = double(h1.bytes - h0.bytes) / n;
+      r.extra_per_op  = double(uint32_t(e1 - e0)) / n;
+      return ns;
+    };
+
+    uint64_t n = 1;
+    while (batch(n) < min_ms * 1e6 && n < (1ull << 40)) {
+      n *= 2;
+      r.iters = 0;   // only the calibrated size counts
+    }
+    for (uint32_t i = 1; i < reps; i++) batch(n);
+    return r;
+  }
+}
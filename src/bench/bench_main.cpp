@@ -0,0 +1,250 @@
+// ============================================================
+// bench_main.cpp  —  Firmware hot-path micro-benchmarks (host)
+//
+// Cases, by area:
+//   marel/    MarelClient register ⇄ kg conversion
+//   ws/       WebSocket message encode/decode (WsMessages)
+//   web/      GET /settings template rendering
+//   display/  HT_Display drawString() and SSD1306Wire::display()
+//   tote/     one loop pass of the dosing state: read scale via
+//             Hal::Station, step Dosing::Engine
+//
+//   pio run -e native && .pio/build/native/program
+//   .pio/build/native/program --json > bench.json
+//   tools/bench_compare.py base.json bench.json
+// ============================================================
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include <Arduino.h>
+#include <HT_SSD1306Wire.h>
+#include "Bench.h"
+#include "../marel.h"
+#include "../WsMessages.h"
+#include "../hardware/resources/WebTemplates.h"
+#include "../hal/Station.h"
+#include "../core/Dosing.h"
+#include "config.h"
+
+using Bench::Result;
+
+// ── Tote step fixture ─────────────────────────────────────────────────────────
+// The water/ice part of handleToteState() in main.cpp: one pass per
+// loop() reads the scale and steps the engine. The HostScale ramps
+// 20 g per pass while a pump is on; a finished cycle re-tares and
+// starts over, as the next tote would.
+namespace {
+  const uint8_t CH_WATER = 0, CH_ICE = 1;
+
+  struct ToteFixture {
+    typedef Hal::Station<Hal::HostBoard> StationT;
+
+    struct Io {
+      StationT& st;
+      void water(bool on) { st.writeDigitalOutput(CH_WATER, on); }
+      void ice(bool on)   { st.writeDigitalOutput(CH_ICE, on); }
+    };
+
+    StationT                station;
+    Io                      io{station};
+    Dosing::Engine<Io>      engine{io};
+    Dosing::Config          cfg;
+    float                   gross   = 0;
+    float                   initial = 0;
+    uint32_t                cycles  = 0;
+
+    ToteFixture() {
+      cfg.settle_ms = 2000;
+      station.begin();
+      restart();
+    }
+
+    void restart() {
+      gross = 12.0f;   // empty tote
+      station.scale.setGrossKg(gross);
+      station.setTare();
+      initial = station.getWeight();
+      engine.begin(cfg, station.clock.millis());
+      cycles++;
+    }
+
+    void step() {
+      if (station.io.output(CH_WATER) || station.io.output(CH_ICE)) {
+        gross += 0.02f;
+        station.scale.setGrossKg(gross);
+      }
+      station.clock.advanceMs(20);   // loop() period
+      station.task();
+      const float w = station.getWeight();
+      if (engine.step(station.clock.millis(), w - initial) == Dosing::Phase::DONE) restart();
+    }
+  };
+}
+
+// ── Output ───────────────────────────────────────────────────────────────────
+static void printText(const std::vector<Result>& results) {
+  printf("%-32s %12s %12s %10s %10s\n", "case", "iters", "ns/op", "allocs/op", "B/op");
+  for (const Result& r : results) {
+    printf("%-32s %12llu %12.1f %10.2f %10.1f", r.name, (unsigned long long)r.iters,
+           r.ns_per_op, r.allocs_per_op, r.bytes_per_op);
+    if (r.extra_name) printf("   %s/op=%.1f", r.extra_name, r.extra_per_op);
+    printf("\n");
+  }
+  if (!Bench::heapCounting()) printf("\n(allocation counting unavailable on this libc)\n");
+}
+
+static void printJson(const std::vector<Result>& results, uint32_t min_ms, uint32_t reps) {
+  printf("{\n  \"suite\": \"firmware\",\n  \"version\": \"%s\",\n", VERSION);
+  printf("  \"compiler\": \"%s\",\n  \"min_time_ms\": %u,\n  \"repeat\": %u,\n", __VERSION__, min_ms, reps);
+  printf("  \"heap_counting\": %s,\n  \"results\": [\n", Bench::heapCounting() ? "true" : "false");
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result& r = results[i];
+    printf("    {\"name\": \"%s\", \"iters\": %llu, \"ns_per_op\": %.2f, \"allocs_per_op\": %.3f, \"bytes_per_op\": %.1f",
+           r.name, (unsigned long long)r.iters, r.ns_per_op, r.allocs_per_op, r.bytes_per_op);
+    if (r.extra_name) printf(", \"%s_per_op\": %.1f", r.extra_name, r.extra_per_op);
+    printf("}%s\n", i + 1 < results.size() ? "," : "");
+  }
+  printf("  ]\n}\n");
+}
+
+// ── CLI ──────────────────────────────────────────────────────────────────────
+static void usage() {
+  printf("usage: bench [--json] [--filter SUBSTR] [--min-time MS] [--repeat N] [--list]\n");
+}
+
+int main(int argc, char** argv) {
+  bool json = false, list = false;
+  const char* filter = nullptr;
+  uint32_t min_ms = 200, reps = 3;
+
+  for (int i = 1; i < argc; i++) {
+    const char* a = argv[i];
+    const char* v = i + 1 < argc ? argv[i + 1] : nullptr;
+    auto takes = [&](const char* name) { if (strcmp(a, name) || !v) return false; i++; return true; };
+
+    if      (!strcmp(a, "--json"))  json = true;
+    else if (!strcmp(a, "--list"))  list = true;
+    else if (takes("--filter"))     filter = v;
+    else if (takes("--min-time"))   min_ms = strtoul(v, nullptr, 10);
+    else if (takes("--repeat"))     reps = strtoul(v, nullptr, 10);
+    else { usage(); return strcmp(a, "--help") ? 2 : 0; }
+  }
+
+  std::vector<Result> results;
+  auto bench = [&](const char* name, auto&& fn, const char* extra_name = nullptr, const uint32_t* extra = nullptr) {
+    if (filter && !strstr(name, filter)) return;
+    if (list) { printf("%s\n", name); return; }
+    results.push_back(Bench::run(name, fn, min_ms, reps, extra_name, extra));
+  };
+
+  // ── marel/ ──────────────────────────────────────────────────────────────────
+  uint16_t regs[64][2];
+  for (int i = 0; i < 64; i++) MarelClient::floatToRegisters((i - 32) * 137.0f, regs[i][0], regs[i][1]);
+
+  bench("marel/registersToFloat", [&] {
+    static unsigned i = 0;
+    const float kg = MarelClient::registersToFloat(regs[i & 63][0], regs[i & 63][1]);
+    Bench::keep(kg);
+    i++;
+  });
+  bench("marel/floatToRegisters", [&] {
+    static unsigned i = 0;
+    uint16_t r0, r1;
+    MarelClient::floatToRegisters((float)(i++ & 1023), r0, r1);
+    Bench::keep(r0);
+    Bench::keep(r1);
+  });
+
+  // ── ws/ ─────────────────────────────────────────────────────────────────────
+  // Fresh String per op, as every ToteWebSocketClient::send*() does
+  bench("ws/encode_weight", [] {
+    String out;
+    Bench::keep(WsMsg::weightUpdate(out, 76.43f));
+  });
+  bench("ws/encode_state", [] {
+    String out;
+    Bench::keep(WsMsg::stateChange(out, "DISPENSING_ICE"));
+  });
+  bench("ws/encode_tote", [] {
+    String out;
+    Bench::keep(WsMsg::toteEvent(out, "tote_validated", "TOTE-000123"));
+  });
+  bench("ws/encode_settings", [] {
+    String out;
+    Bench::keep(WsMsg::settingsCurrent(out, 2.5f, 1.75f, 0.5f, true));
+  });
+
+  static const char CMD[] = "{\"type\":\"command\",\"command\":\"start\",\"station\":\"outbound\"}";
+  static const char QR[]  = "{\"type\":\"qr_scanned\",\"toteId\":\"TOTE-000123\",\"station\":\"outbound\"}";
+  static const char SET[] = "{\"type\":\"settings_update\",\"ice_kg\":2.5,\"water_kg\":1.75,\"min_w\":0.5}";
+  bench("ws/decode_command", [] {
+    WsMsg::InDoc doc;
+    DeserializationError err;
+    Bench::keep(WsMsg::decode(CMD, sizeof(CMD) - 1, doc, err));
+  });
+  bench("ws/decode_qr", [] {
+    WsMsg::InDoc doc;
+    DeserializationError err;
+    Bench::keep(WsMsg::decode(QR, sizeof(QR) - 1, doc, err));
+  });
+  bench("ws/decode_settings", [] {
+    WsMsg::InDoc doc;
+    DeserializationError err;
+    Bench::keep(WsMsg::decode(SET, sizeof(SET) - 1, doc, err));
+  });
+
+  // ── web/ ────────────────────────────────────────────────────────────────────
+  bench("web/settings_json", [] {
+    Settings::Snapshot settings;
+    settings.dosing.ice_kg   = 2.5f;
+    settings.dosing.water_kg = 1.75f;
+    settings.min_w           = 0.5f;
+    settings.auto_start      = true;
+    char json[384];
+    Bench::keep(renderSettingsJson(json, sizeof(json), settings, "tote-outbound"));
+  });
+
+  // ── display/ ────────────────────────────────────────────────────────────────
+  // ~ScreenDisplay() calls a pure virtual while the buffers exist,
+  // so end() frees them before it runs. Pins are unused on host.
+  static SSD1306Wire oled(0x3c, 500000, -1, -1, GEOMETRY_128_64);
+  oled.init();
+  oled.setFont(ArialMT_Plain_16);
+  const String label("Peso: 76.43 kg");
+
+  bench("display/drawString", [&] {
+    oled.drawString(0, 0, label);
+  });
+  bench("display/drawString_clear", [&] {
+    oled.clear();
+    oled.drawString(0, 0, label);
+  });
+  bench("display/display_line", [&] {
+    // 16 px of changes (2 pages) per frame, like a weight refresh
+    oled.setColor(INVERSE);
+    oled.fillRect(0, 16, 128, 16);
+    oled.setColor(WHITE);
+    oled.display();
+  }, "i2c_bytes", &Wire.bytes);
+  bench("display/display_full", [&] {
+    oled.setColor(INVERSE);
+    oled.fillRect(0, 0, 128, 64);
+    oled.setColor(WHITE);
+    oled.display();
+  }, "i2c_bytes", &Wire.bytes);
+  bench("display/display_idle", [&] {
+    oled.display();
+  }, "i2c_bytes", &Wire.bytes);
+  oled.end();
+
+  // ── tote/ ───────────────────────────────────────────────────────────────────
+  ToteFixture tote;
+  bench("tote/step", [&] { tote.step(); });
+
+  if (list) return 0;
+  if (json) printJson(results, min_ms, reps);
+  else      printText(results);
+  return 0;
+}
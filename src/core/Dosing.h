@@ -0,0 +1,378 @@
+#pragma once
+// ============================================================
+// Dosing  —  Water → ice → settle dosing logic, hardware-free
+//
+// Lane.cpp's onWaterFilling / onIceFilling / onSettlingIce feed
+// this engine the net weight (current − tote.initial_weight) once
+// per loop and act on the returned phase; the engine decides when
+// each pump turns on/off. The host simulator (src/sim) drives the
+// very same engine against a plant model, so a strategy can be
+// benchmarked off the line before it is flashed.
+//
+// Overlap (Config::overlap): water and ice run at the same time in
+// the WATER phase. The scale only sees their sum, so it is split with
+// per-channel flow models (kg/s after a dead time) learned from the
+// sequential cycles; each channel stops when its share reaches its
+// target, the other then runs on to the cumulative target as usual.
+//
+// Io is any type with:
+//   void water(bool on);   // WATER_PUMP
+//   void ice(bool on);     // ICE_PUMP / ICE_STOP pulse pair (ICE_PULSE_MS each)
+// It is a template parameter, so there is no virtual call on device.
+//
+// Plain C++ (no Arduino).
+// ============================================================
+#include <stdint.h>
+#include <math.h>
+
+namespace Dosing {
+
+  // Io::ice() contacts: ICE_PUMP to start the auger, ICE_STOP to stop it
+  static const uint32_t ICE_PULSE_MS = 200;
+
+  enum class Phase : uint8_t {
+    IDLE,
+    WATER,     // DISPENSING_WATER
+    ICE,       // DISPENSING_ICE
+    SETTLE,    // SETTLING_ICE
+    DONE
+  };
+
+  enum class Strategy : uint8_t {
+    SINGLE_SHOT,   // pump until the target is read on the scale, then stop
+    COARSE_FINE,   // ice: full auger to within fine_kg, then shrinking pulses
+    STRATEGY_COUNT
+  };
+
+  inline const char* strategyName(Strategy s) {
+    switch (s) {
+      case Strategy::SINGLE_SHOT: return "single_shot";
+      case Strategy::COARSE_FINE: return "coarse_fine";
+      default:                    return "?";
+    }
+  }
+
+  struct Config {
+    Strategy strategy  = Strategy::SINGLE_SHOT;
+    float    water_kg  = 2.0f;
+    float    ice_kg    = 2.0f;
+    uint32_t settle_ms = 8000;   // pumps off, residual ice still landing
+
+    // ── COARSE_FINE (ice) ────────────────────────────────────────
+    // The auger runs continuously until fine_kg of ice is left, then
+    // in pulses whose on-time scales with what's left:
+    //   on = pulse_max_ms × remaining / fine_kg, clamped to pulse_min_ms
+    // After each pulse it waits pulse_wait_ms for the ice in the chute
+    // to land before reading the scale again. Done within tol_kg.
+    float    fine_kg        = 0.6f;
+    float    tol_kg         = 0.03f;
+    uint32_t pulse_max_ms   = 1500;
+    uint32_t pulse_min_ms   = 400;    // ICE_PUMP + ICE_STOP are 200 ms pulses each
+    uint32_t pulse_wait_ms  = 1200;
+    uint32_t fine_settle_ms = 2000;   // replaces settle_ms: little is left in flight
+    uint8_t  max_pulses     = 20;     // silo empty / auger jammed: stop anyway
+
+    // ── Overlap ──────────────────────────────────────────────────
+    // Needs overlap_min_runs sequential cycles per flow model first;
+    // every overlap_relearn-th cycle then runs sequentially again to
+    // keep the models current (0 = never).
+    bool     overlap          = false;
+    uint8_t  overlap_min_runs = 3;
+    uint8_t  overlap_relearn  = 20;
+  };
+
+  // Flow of one channel as the scale sees it: nothing for lag_ms after
+  // the output turns on (valve/auger start + fall), then kgps.
+  struct FlowModel {
+    float    kgps   = 0;
+    uint32_t lag_ms = 0;
+    uint8_t  runs   = 0;   // sequential cycles averaged in (saturates)
+
+    /** Mass landed after on_ms with the output on. */
+    float landed(uint32_t on_ms) const {
+      return on_ms > lag_ms ? kgps * (on_ms - lag_ms) / 1000.0f : 0.0f;
+    }
+    /** Mass still in flight when the output turns off. */
+    float inFlight() const { return kgps * lag_ms / 1000.0f; }
+  };
+
+  template <class Io>
+  class Engine {
+  public:
+    explicit Engine(Io& io) : _io(io) {}
+
+    /** Starts a cycle: water pump on (and the ice auger when overlapped). */
+    void begin(const Config& cfg, uint32_t now_ms) {
+      _cfg      = cfg;
+      _start    = now_ms;
+      _waterKg  = 0;
+      _iceKg    = 0;
+      _iceBase  = 0;
+      _fine     = Fine::COARSE;
+      _pulses   = 0;
+      _riseMs   = 0;
+      _overlap  = cfg.overlap &&
+                  _waterFlow.runs >= cfg.overlap_min_runs &&
+                  _iceFlow.runs   >= cfg.overlap_min_runs &&
+                  (cfg.overlap_relearn == 0 || _cycles % cfg.overlap_relearn != 0);
+      _cycles++;
+      enter(Phase::WATER, now_ms);
+      _waterOn  = true;
+      _iceOn    = _overlap;
+      _io.water(true);
+      if (_overlap) _io.ice(true);
+    }
+
+    /**
+     * Advances the cycle with the latest net weight (NaN = no reading,
+     * hold). Returns the phase after this step.
+     */
+    Phase step(uint32_t now_ms, float net_kg) {
+      switch (_phase) {
+        case Phase::WATER:
+          if (_overlap) {
+            stepOverlap(now_ms, net_kg);
+            break;
+          }
+          watchRise(now_ms, net_kg, 0.0f, _cfg.water_kg);
+          if (isnan(net_kg) || net_kg < _cfg.water_kg) break;
+          _io.water(false);
+          _waterOn = false;
+          _waterKg = net_kg;
+          learn(_waterFlow, now_ms, net_kg, 0.0f);
+          enter(Phase::ICE, now_ms);
+          _iceBase = _waterKg + _waterFlow.inFlight();
+          _iceOn   = true;
+          _io.ice(true);
+          break;
+
+        case Phase::ICE:
+          if (!_overlap) watchRise(now_ms, net_kg, _iceBase, _cfg.ice_kg);
+          if (_cfg.strategy == Strategy::COARSE_FINE) {
+            stepFine(now_ms, net_kg);
+            break;
+          }
+          // net is cumulative (water + ice), compared against both targets
+          if (isnan(net_kg) || net_kg < _cfg.water_kg + _cfg.ice_kg) break;
+          iceOff(now_ms, net_kg);
+          _iceKg = net_kg - _waterKg;
+          enterSettle(now_ms);
+          break;
+
+        case Phase::SETTLE:
+          if (now_ms - _phaseStart < settleMs()) break;
+          enter(Phase::DONE, now_ms);
+          break;
+
+        case Phase::IDLE:
+        case Phase::DONE:
+          break;
+      }
+      return _phase;
+    }
+
+    /** Stops everything (STOP / cancel). */
+    void abort() {
+      if (_waterOn) _io.water(false);
+      if (_iceOn)   _io.ice(false);
+      _waterOn = _iceOn = false;
+      _phase = Phase::IDLE;
+    }
+
+    Phase         phase()        const { return _phase; }
+    uint32_t      phaseStartMs() const { return _phaseStart; }
+    const Config& config()       const { return _cfg; }
+    float         waterKg()      const { return _waterKg; }  ///< water dispensed (estimate if overlapped)
+    float         iceKg()        const { return _iceKg; }    ///< ice dispensed (estimate if overlapped)
+    uint8_t       pulses()       const { return _pulses; }   ///< COARSE_FINE pulses this cycle
+    uint32_t      settleMs()     const {
+      return _cfg.strategy == Strategy::COARSE_FINE ? _cfg.fine_settle_ms : _cfg.settle_ms;
+    }
+
+    bool             overlapped() const { return _overlap; }    ///< this cycle ran water + ice together
+    const FlowModel& waterFlow()  const { return _waterFlow; }
+    const FlowModel& iceFlow()    const { return _iceFlow; }
+    uint32_t         dosingMs()   const { return _dosingMs; }   ///< begin → last output off, this cycle
+
+    /**
+     * Dosing time this overlapped cycle saved against the average of
+     * the recent sequential ones (0 if sequential / none yet).
+     */
+    int32_t savedMs() const {
+      if (!_overlap || _seqMs <= 0) return 0;
+      return (int32_t)(_seqMs - (float)_dosingMs);
+    }
+
+  private:
+    enum class Fine : uint8_t {
+      COARSE,   // auger on continuously
+      WAIT,     // auger off, ice in the chute landing
+      PULSE     // auger on until _pulseEnd
+    };
+
+    static constexpr float RISE_FRAC  = 0.25f;   // learn from 25 % of the target onwards
+    static constexpr float LEARN_RATE = 0.3f;    // EWMA weight of the newest cycle
+
+    void stepOverlap(uint32_t now_ms, float net_kg) {
+      if (isnan(net_kg)) return;
+      const float total = _cfg.water_kg + _cfg.ice_kg;
+
+      // One channel already done: the other runs on to the cumulative target
+      if (!_iceOn) {
+        if (net_kg < total) return;
+        _io.water(false);
+        _waterOn = false;
+        _waterKg = net_kg - _iceKg;
+        enterSettle(now_ms);   // the Lane still passes through DISPENSING_ICE
+        return;
+      }
+
+      // Both on: split what the scale shows in proportion to the models
+      const uint32_t on = now_ms - _start;
+      const float w = _waterFlow.landed(on);
+      const float i = _iceFlow.landed(on);
+      if (w + i <= 0) return;   // nothing expected on the scale yet
+      const float waterEst = net_kg * w / (w + i);
+      const float iceEst   = net_kg - waterEst;
+
+      if (iceEst >= _cfg.ice_kg) {
+        _io.ice(false);
+        _iceOn = false;
+        _iceKg = iceEst;
+      }
+      if (waterEst >= _cfg.water_kg) {
+        _io.water(false);
+        _waterOn = false;
+        _waterKg = waterEst;
+        _iceBase = waterEst + _waterFlow.inFlight();   // ice so far sits on top of it
+        enter(Phase::ICE, now_ms);
+        // Ice still on: the ICE phase finishes it (single shot against the
+        // cumulative target, coarse/fine against the ice above _iceBase)
+        if (!_iceOn) enterSettle(now_ms);
+      }
+    }
+
+    void stepFine(uint32_t now_ms, float net_kg) {
+      // Against the ice alone: water over- / undershoot is not ice's to
+      // make up (the single shot's cumulative target does exactly that)
+      const float remaining = _iceBase + _cfg.ice_kg - net_kg;   // NaN if no reading
+
+      switch (_fine) {
+        case Fine::COARSE:
+          if (isnan(net_kg) || remaining > _cfg.fine_kg) return;
+          iceOff(now_ms, net_kg);
+          _fine     = Fine::WAIT;
+          _fineMark = now_ms;
+          return;
+
+        case Fine::PULSE: {
+          // A lump can reach the target mid-pulse: cut it short, but not
+          // while ICE_PUMP is still closed nor under pulse_min_ms
+          const uint32_t on    = now_ms - _pulseStart;
+          const bool     minOn = on >= ICE_PULSE_MS && on >= _cfg.pulse_min_ms;
+          const bool     ended = (int32_t)(now_ms - _pulseEnd) >= 0;
+          if (!ended && (!minOn || isnan(net_kg) || remaining > 0)) return;
+          _io.ice(false);
+          _iceOn    = false;
+          _fine     = Fine::WAIT;
+          _fineMark = now_ms;
+          return;
+        }
+
+        case Fine::WAIT:
+          if (now_ms - _fineMark < _cfg.pulse_wait_ms || isnan(net_kg)) return;
+          if (remaining <= _cfg.tol_kg || _pulses >= _cfg.max_pulses) {
+            _iceKg = net_kg - _iceBase;   // the water's tail landed before the ice
+            enterSettle(now_ms);
+            return;
+          }
+          uint32_t on = (uint32_t)(_cfg.pulse_max_ms * (remaining / _cfg.fine_kg));
+          if (on > _cfg.pulse_max_ms) on = _cfg.pulse_max_ms;
+          if (on < _cfg.pulse_min_ms) on = _cfg.pulse_min_ms;
+          _io.ice(true);
+          _iceOn = true;
+          _pulses++;
+          _fine       = Fine::PULSE;
+          _pulseStart = now_ms;
+          _pulseEnd   = now_ms + on;
+          return;
+      }
+    }
+
+    /** Ends the continuous ice run (single shot / coarse); learns the auger if sequential. */
+    void iceOff(uint32_t now_ms, float net_kg) {
+      _io.ice(false);
+      _iceOn = false;
+      if (!_overlap) learn(_iceFlow, now_ms, net_kg, _iceBase);
+    }
+
+    // ── Flow model learning (sequential cycles only) ────────────
+    // Two points on the rise: the first reading past RISE_FRAC of the
+    // target and the reading at switch-off. The slope is the flow, and
+    // extending it back to the phase's starting level gives the lag.
+
+    void watchRise(uint32_t now_ms, float net_kg, float base_kg, float target_kg) {
+      if (_riseMs || isnan(net_kg) || net_kg < base_kg + RISE_FRAC * target_kg) return;
+      _riseMs = now_ms;
+      _riseKg = net_kg;
+    }
+
+    void learn(FlowModel& m, uint32_t now_ms, float net_kg, float base_kg) {
+      const uint32_t riseMs = _riseMs;
+      _riseMs = 0;
+      if (!riseMs || now_ms <= riseMs || net_kg <= _riseKg) return;
+      const float kgps = (net_kg - _riseKg) * 1000.0f / (now_ms - riseMs);
+      const float lag  = (riseMs - _phaseStart) - (_riseKg - base_kg) * 1000.0f / kgps;
+      const float lagMs = lag > 0 ? lag : 0;
+      if (m.runs == 0) {
+        m.kgps   = kgps;
+        m.lag_ms = (uint32_t)lagMs;
+      } else {
+        m.kgps  += LEARN_RATE * (kgps - m.kgps);
+        m.lag_ms = (uint32_t)(m.lag_ms + LEARN_RATE * (lagMs - (float)m.lag_ms));
+      }
+      if (m.runs < UINT8_MAX) m.runs++;
+    }
+
+    void enterSettle(uint32_t now_ms) {
+      _dosingMs = now_ms - _start;
+      if (!_overlap) {
+        _seqMs = _seqMs <= 0 ? (float)_dosingMs
+                             : _seqMs + LEARN_RATE * ((float)_dosingMs - _seqMs);
+      }
+      enter(Phase::SETTLE, now_ms);
+    }
+
+    void enter(Phase p, uint32_t now_ms) {
+      _phase      = p;
+      _phaseStart = now_ms;
+    }
+
+    Io&      _io;
+    Config   _cfg;
+    Phase    _phase      = Phase::IDLE;
+    uint32_t _phaseStart = 0;
+    uint32_t _start      = 0;
+    float    _waterKg    = 0;
+    float    _iceKg      = 0;
+    bool     _waterOn    = false;
+    bool     _iceOn      = false;
+    Fine     _fine       = Fine::COARSE;
+    uint32_t _fineMark   = 0;
+    uint32_t _pulseStart = 0;
+    uint32_t _pulseEnd   = 0;
+    uint8_t  _pulses     = 0;
+
+    // Overlap / flow models (persist across cycles)
+    bool      _overlap   = false;
+    uint32_t  _cycles    = 0;
+    FlowModel _waterFlow;
+    FlowModel _iceFlow;
+    float     _iceBase   = 0;   // net where ice starts landing (water + its tail)
+    uint32_t  _riseMs    = 0;
+    float     _riseKg    = 0;
+    uint32_t  _dosingMs  = 0;
+    float     _seqMs     = 0;   // EWMA of sequential dosing time
+  };
+
+} // namespace Dosing
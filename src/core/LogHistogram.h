@@ -0,0 +1,150 @@
+#pragma once
+// ============================================================
+// LogHistogram  —  Fixed-memory streaming histogram (HDR-style)
+//
+// Values below 8 get an exact bucket; above that every power of
+// two is split into 8 sub-buckets, so any percentile is within
+// ~6 % of the true value. 160 uint16_t counters cover 0 .. 4.2 M
+// (ms → 70 min, g → 4 t); larger values land in the last bucket.
+// When a counter would overflow, all counters are halved: memory
+// stays at ~340 bytes forever and old history slowly fades.
+//
+// Plain C++ (no Arduino) so the host simulator/benchmarks can use it.
+// ============================================================
+#include <stdint.h>
+#include <string.h>
+
+class LogHistogram {
+public:
+  static const uint8_t  SUB_BITS = 3;
+  static const uint8_t  SUB      = 1 << SUB_BITS;
+  static const uint8_t  MAX_EXP  = 22;
+  static const uint16_t BUCKETS  = SUB + (MAX_EXP - SUB_BITS) * SUB;
+
+  LogHistogram() { clear(); }
+
+  void clear() {
+    memset(_counts, 0, sizeof(_counts));
+    _count = 0;
+    _sum   = 0;
+    _min   = UINT32_MAX;
+    _max   = 0;
+  }
+
+  void record(uint32_t v) {
+    const uint16_t i = index(v);
+    if (_counts[i] == UINT16_MAX) decay();
+    _counts[i]++;
+    _count++;
+    _sum += v;
+    if (v < _min) _min = v;
+    if (v > _max) _max = v;
+  }
+
+  uint32_t count() const { return _count; }
+  uint32_t min()   const { return _count ? _min : 0; }
+  uint32_t max()   const { return _max; }
+  uint64_t sum()   const { return _sum; }
+  uint32_t mean()  const { return _count ? (uint32_t)(_sum / _count) : 0; }
+
+  /** Value at 1-based ascending rank (bucket midpoint, clamped to [min, max]). */
+  uint32_t valueAtRank(uint32_t rank) const {
+    uint32_t seen = 0;
+    for (uint16_t i = 0; i < BUCKETS; i++) {
+      seen += _counts[i];
+      if (seen >= rank && _counts[i]) {
+        const uint32_t mid = lowerBound(i) + width(i) / 2;
+        return mid < _min ? _min : (mid > _max ? _max : mid);
+      }
+    }
+    return _max;
+  }
+
+  /** p in [0, 1], e.g. 0.95 for p95. */
+  uint32_t percentile(float p) const {
+    if (_count == 0) return 0;
+    uint32_t rank = (uint32_t)(p * _count + 0.999f);
+    if (rank < 1) rank = 1;
+    if (rank > _count) rank = _count;
+    return valueAtRank(rank);
+  }
+
+  static uint16_t index(uint32_t v) {
+    if (v < SUB) return (uint16_t)v;
+    const uint8_t e = 31 - __builtin_clz(v);
+    if (e >= MAX_EXP) return BUCKETS - 1;
+    const uint32_t mant = (v >> (e - SUB_BITS)) & (SUB - 1);
+    return SUB + (e - SUB_BITS) * SUB + mant;
+  }
+
+  static uint32_t lowerBound(uint16_t i) {
+    if (i < SUB) return i;
+    const uint16_t k = i - SUB;
+    const uint8_t  e = k / SUB + SUB_BITS;
+    return (uint32_t)(SUB + k % SUB) << (e - SUB_BITS);
+  }
+
+  static uint32_t width(uint16_t i) {
+    if (i < SUB) return 1;
+    return 1u << ((i - SUB) / SUB);
+  }
+
+private:
+  void decay() {
+    _count = 0;
+    for (uint16_t i = 0; i < BUCKETS; i++) {
+      _counts[i] >>= 1;
+      _count += _counts[i];
+    }
+    _sum >>= 1;
+  }
+
+  uint16_t _counts[BUCKETS];
+  uint32_t _count;
+  uint64_t _sum;
+  uint32_t _min;
+  uint32_t _max;
+};
+
+// ── Signed variant (overshoot can be negative) ──────────────────
+// Magnitudes go to one LogHistogram per sign, so resolution stays
+// relative to |v| on both sides of zero.
+class SignedLogHistogram {
+public:
+  void clear() { _neg.clear(); _pos.clear(); }
+
+  void record(int32_t v) {
+    if (v < 0) _neg.record((uint32_t)(-(int64_t)v));
+    else       _pos.record((uint32_t)v);
+  }
+
+  uint32_t count() const { return _neg.count() + _pos.count(); }
+
+  int32_t min() const { return _neg.count() ? -(int32_t)_neg.max() : (int32_t)_pos.min(); }
+  int32_t max() const { return _pos.count() ? (int32_t)_pos.max() : -(int32_t)_neg.min(); }
+
+  int32_t mean() const {
+    const uint32_t n = count();
+    if (!n) return 0;
+    const int64_t sum = (int64_t)_pos.sum() - (int64_t)_neg.sum();
+    return (int32_t)(sum / n);
+  }
+
+  int32_t percentile(float p) const {
+    const uint32_t n = count();
+    if (n == 0) return 0;
+    uint32_t rank = (uint32_t)(p * n + 0.999f);
+    if (rank < 1) rank = 1;
+    if (rank > n) rank = n;
+    // Ascending order: most negative first
+    if (rank <= _neg.count()) return -(int32_t)_neg.valueAtRank(_neg.count() - rank + 1);
+    return (int32_t)_pos.valueAtRank(rank - _neg.count());
+  }
+
+  /** Sum of positive values only (e.g. total giveaway). */
+  uint64_t positiveSum() const { return _pos.sum(); }
+
+private:
+  LogHistogram _neg;
+  LogHistogram _pos;
+};
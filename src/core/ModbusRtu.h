@@ -0,0 +1,202 @@
+#pragma once
+// ============================================================
+// ModbusRtu  —  RTU framing for the subset the Marel M2200 uses
+//
+//   0x01 Read Coils              (COIL_WEIGHT_STABLE)
+//   0x03 Read Holding Registers  (REG_GROSS/NET/TARE, 2 regs each)
+//   0x05 Write Single Coil       (COIL_TARE/CLEAR_TARE/ZERO)
+//
+// Frame = slave, function, payload, CRC-16/MODBUS (low byte first).
+// Frames are delimited by ≥ 3.5 character times of silence
+// (fixed 1750 µs above 19200 baud, per the serial line spec).
+//
+// Plain C++ (no Arduino): used by the host ModbusRTU master shim,
+// the device's native RS-485 master (Rs485Modbus), the M2200
+// emulator and the native benchmarks.
+// ============================================================
+#include <stdint.h>
+#include <stddef.h>
+
+namespace ModbusRtu {
+
+  static const uint8_t FC_READ_COILS   = 0x01;
+  static const uint8_t FC_READ_HREGS   = 0x03;
+  static const uint8_t FC_WRITE_COIL   = 0x05;
+  static const uint8_t FC_EXCEPTION    = 0x80;   // OR'ed into the function code
+
+  static const uint8_t EX_ILLEGAL_FUNCTION = 0x01;
+  static const uint8_t EX_ILLEGAL_ADDRESS  = 0x02;
+  static const uint8_t EX_ILLEGAL_VALUE    = 0x03;
+
+  static const uint16_t COIL_ON  = 0xFF00;
+  static const uint16_t COIL_OFF = 0x0000;
+
+  static const size_t MAX_FRAME = 256;
+  static const size_t REQUEST_SIZE = 8;           // every request above is 8 bytes
+
+  // ── CRC-16/MODBUS (poly 0xA001 reflected, init 0xFFFF) ────────────────────
+  inline uint16_t crc16(const uint8_t* data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++) {
+      crc ^= data[i];
+      for (uint8_t b = 0; b < 8; b++)
+        crc = (crc & 1) ? (uint16_t)((crc >> 1) ^ 0xA001) : (uint16_t)(crc >> 1);
+    }
+    return crc;
+  }
+
+  /** Appends the CRC at out[len]; returns the new length. */
+  inline size_t appendCrc(uint8_t* out, size_t len) {
+    const uint16_t crc = crc16(out, len);
+    out[len++] = (uint8_t)(crc & 0xFF);
+    out[len++] = (uint8_t)(crc >> 8);
+    return len;
+  }
+
+  inline bool checkCrc(const uint8_t* frame, size_t len) {
+    if (len < 4) return false;
+    const uint16_t crc = crc16(frame, len - 2);
+    return frame[len - 2] == (uint8_t)(crc & 0xFF) && frame[len - 1] == (uint8_t)(crc >> 8);
+  }
+
+  // ── Timing ─────────────────────────────────────────────────────────────────
+  /** µs on the wire per byte (8N1 = 10 bits). */
+  inline uint32_t charTimeUs(uint32_t baud, uint8_t bitsPerChar = 10) {
+    return (uint32_t)((1000000ULL * bitsPerChar + baud - 1) / baud);
+  }
+
+  /** Minimum silence that ends a frame (t3.5). */
+  inline uint32_t frameGapUs(uint32_t baud) {
+    return baud > 19200 ? 1750 : (charTimeUs(baud) * 7 + 1) / 2;
+  }
+
+  // ── Master side ────────────────────────────────────────────────────────────
+  inline void putU16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)(v >> 8);
+    p[1] = (uint8_t)(v & 0xFF);
+  }
+  inline uint16_t getU16(const uint8_t* p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+  }
+
+  /** 0x01 / 0x03 request. Returns frame length (8). */
+  inline size_t buildRead(uint8_t* out, uint8_t slave, uint8_t fc, uint16_t addr, uint16_t count) {
+    out[0] = slave;
+    out[1] = fc;
+    putU16(out + 2, addr);
+    putU16(out + 4, count);
+    return appendCrc(out, 6);
+  }
+
+  /** 0x05 request. Returns frame length (8). */
+  inline size_t buildWriteCoil(uint8_t* out, uint8_t slave, uint16_t addr, bool on) {
+    out[0] = slave;
+    out[1] = FC_WRITE_COIL;
+    putU16(out + 2, addr);
+    putU16(out + 4, on ? COIL_ON : COIL_OFF);
+    return appendCrc(out, 6);
+  }
+
+  /** Length of a normal reply to (fc, count); exception replies are 5. */
+  inline size_t responseSize(uint8_t fc, uint16_t count) {
+    switch (fc) {
+      case FC_READ_COILS: return 5 + (count + 7) / 8;
+      case FC_READ_HREGS: return 5 + 2 * count;
+      case FC_WRITE_COIL: return 8;
+      default:            return 5;
+    }
+  }
+
+  /** Outcome of decodeReply(): 0 = ok, 1..0x7F = the slave's exception code. */
+  static const uint8_t REPLY_OK         = 0x00;
+  static const uint8_t REPLY_BAD_CRC    = 0xF0;   // keep waiting (retry / timeout)
+  static const uint8_t REPLY_FOREIGN    = 0xF1;   // other slave / function: ignore
+  static const uint8_t REPLY_BAD_LENGTH = 0xF2;   // ends the transaction
+
+  /**
+   * Checks a received frame against the request it answers and, for
+   * reads, unpacks the data into dest (uint16_t[count] for 0x03,
+   * bool[count] for 0x01).
+   */
+  inline uint8_t decodeReply(const uint8_t* req, uint16_t count, const uint8_t* rx, size_t len, void* dest) {
+    if (!checkCrc(rx, len)) return REPLY_BAD_CRC;
+    if (rx[0] != req[0] || (rx[1] & ~FC_EXCEPTION) != req[1]) return REPLY_FOREIGN;
+    if (rx[1] & FC_EXCEPTION) return rx[2];
+    if (len != responseSize(req[1], count)) return REPLY_BAD_LENGTH;
+
+    switch (req[1]) {
+      case FC_READ_HREGS: {
+        uint16_t* regs = (uint16_t*)dest;
+        for (uint16_t i = 0; i < count; i++) regs[i] = getU16(rx + 3 + 2 * i);
+        break;
+      }
+      case FC_READ_COILS: {
+        bool* coils = (bool*)dest;
+        for (uint16_t i = 0; i < count; i++) coils[i] = (rx[3 + i / 8] >> (i % 8)) & 1;
+        break;
+      }
+      default:
+        break;
+    }
+    return REPLY_OK;
+  }
+
+  /** Enough bytes in for a complete reply to req (normal or exception)? */
+  inline bool replyComplete(const uint8_t* req, uint16_t count, const uint8_t* rx, size_t len) {
+    return len >= responseSize(req[1], count) || (len == 5 && (rx[1] & FC_EXCEPTION));
+  }
+
+  // ── Slave side ─────────────────────────────────────────────────────────────
+  struct Request {
+    uint8_t  slave;
+    uint8_t  fc;
+    uint16_t addr;
+    uint16_t value;   // count for reads, COIL_ON/OFF for 0x05
+  };
+
+  /** False on short frame or bad CRC. */
+  inline bool parseRequest(const uint8_t* frame, size_t len, Request& req) {
+    if (len != REQUEST_SIZE || !checkCrc(frame, len)) return false;
+    req.slave = frame[0];
+    req.fc    = frame[1];
+    req.addr  = getU16(frame + 2);
+    req.value = getU16(frame + 4);
+    return true;
+  }
+
+  inline size_t buildException(uint8_t* out, uint8_t slave, uint8_t fc, uint8_t code) {
+    out[0] = slave;
+    out[1] = fc | FC_EXCEPTION;
+    out[2] = code;
+    return appendCrc(out, 3);
+  }
+
+  inline size_t buildRegsReply(uint8_t* out, uint8_t slave, const uint16_t* regs, uint16_t count) {
+    out[0] = slave;
+    out[1] = FC_READ_HREGS;
+    out[2] = (uint8_t)(count * 2);
+    for (uint16_t i = 0; i < count; i++) putU16(out + 3 + 2 * i, regs[i]);
+    return appendCrc(out, 3 + 2 * count);
+  }
+
+  inline size_t buildCoilsReply(uint8_t* out, uint8_t slave, const bool* coils, uint16_t count) {
+    const uint8_t bytes = (uint8_t)((count + 7) / 8);
+    out[0] = slave;
+    out[1] = FC_READ_COILS;
+    out[2] = bytes;
+    for (uint8_t i = 0; i < bytes; i++) out[3 + i] = 0;
+    for (uint16_t i = 0; i < count; i++)
+      if (coils[i]) out[3 + i / 8] |= (uint8_t)(1 << (i % 8));
+    return appendCrc(out, 3 + bytes);
+  }
+
+  /** 0x05 reply echoes the request. */
+  inline size_t buildWriteCoilReply(uint8_t* out, const Request& req) {
+    out[0] = req.slave;
+    out[1] = FC_WRITE_COIL;
+    putU16(out + 2, req.addr);
+    putU16(out + 4, req.value);
+    return appendCrc(out, 6);
+  }
+
+} // namespace ModbusRtu
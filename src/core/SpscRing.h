@@ -0,0 +1,67 @@
+#pragma once
+// ============================================================
+// SpscRing  —  Fixed-size single-producer / single-consumer queue
+//
+// Hands events from a callback context that must not block or
+// allocate (Bluedroid's task for BLEQRClient) to the loop task:
+//
+//   producer (one task)            consumer (one task)
+//   T* e = ring.claim();           const T* e = ring.front();
+//   if (e) { fill *e;              if (e) { use *e;
+//            ring.commit(); }               ring.pop(); }
+//
+// claim()/front() return the slot in place, so neither side copies
+// more than it writes. Lock-free: each index is written by one side
+// only, with release/acquire ordering on the handoff. Full: claim()
+// returns nullptr and the caller counts the drop.
+//
+// N must be a power of two. All N slots are usable: the indices run
+// free (wrapping modulo 2^32) and are masked on access.
+//
+// Plain C++ (no Arduino).
+// ============================================================
+#include <stdint.h>
+#include <atomic>
+
+template <typename T, uint8_t N>
+class SpscRing {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "SpscRing size must be a power of two");
+
+public:
+  // ── Producer ───────────────────────────────────────────────
+  /** Free slot to fill, or nullptr when full. */
+  T* claim() {
+    const uint32_t head = _head.load(std::memory_order_relaxed);
+    if (head - _tail.load(std::memory_order_acquire) >= N) return nullptr;
+    return &_items[head & (N - 1)];
+  }
+
+  /** Publishes the slot returned by claim(). */
+  void commit() { _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+  // ── Consumer ───────────────────────────────────────────────
+  /** Oldest published item, or nullptr when empty. */
+  const T* front() const {
+    const uint32_t tail = _tail.load(std::memory_order_relaxed);
+    if (_head.load(std::memory_order_acquire) == tail) return nullptr;
+    return &_items[tail & (N - 1)];
+  }
+
+  /** Releases the item returned by front() back to the producer. */
+  void pop() { _tail.store(_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+  /** Drops everything published so far (consumer side). */
+  void clear() { _tail.store(_head.load(std::memory_order_acquire), std::memory_order_release); }
+
+  // ── Either side (approximate while the other one runs) ─────
+  uint32_t size() const {
+    return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+  }
+  bool empty() const { return size() == 0; }
+  static constexpr uint8_t capacity() { return N; }
+
+private:
+  T                     _items[N];
+  std::atomic<uint32_t> _head{0};   // next slot to fill (producer)
+  std::atomic<uint32_t> _tail{0};   // next slot to read (consumer)
+};
@@ -0,0 +1,111 @@
+#pragma once
+// ============================================================
+// ToteDetector  —  "A tote was put on the scale" from weight samples
+//
+// Drives the auto-start of a cycle in IDLE (main.cpp onIDLE()).
+// A tote is reported when the weight, coming from an empty scale,
+// steps above the minimum start weight and then stays inside a
+// narrow band for hold_ms:
+//
+//   DISARMED ── w < rearm ──▶ EMPTY ── w ≥ min ──▶ LOADING
+//       ▲                       ▲                    │ spread > band: restart window
+//       │                       └── w < min (REJECTED: someone leaned on it)
+//       └──────────── stable for hold_ms (DETECTED) ─┘
+//
+// A person leaning on the scale never holds still within the band
+// and lets go again (REJECTED); a tote being lowered or fish still
+// sliding keeps restarting the window until it settles. After a
+// detection, or while a cycle runs, the detector stays disarmed
+// until the scale reads (almost) empty, so the tote that was just
+// dosed is never picked up twice.
+//
+// Plain C++ (no Arduino).
+// ============================================================
+#include <stdint.h>
+#include <math.h>
+
+class ToteDetector {
+public:
+  struct Config {
+    float    min_kg      = 5.0f;    // Settings::getMinWeight()
+    float    band_kg     = 0.15f;   // max spread (max − min) while stable
+    uint32_t hold_ms     = 1500;    // stable this long → tote
+    uint8_t  min_samples = 3;       // and at least this many readings
+    float    rearm_frac  = 0.5f;    // empty again below min_kg × this
+  };
+
+  enum class Event : uint8_t { NONE, DETECTED, REJECTED };
+
+  enum class State : uint8_t { DISARMED, EMPTY, LOADING };
+
+  void configure(const Config& cfg) { _cfg = cfg; }
+  const Config& config() const      { return _cfg; }
+
+  /** A cycle started some other way (START, WS): wait for the scale to empty. */
+  void disarm() { _state = State::DISARMED; }
+
+  State state() const { return _state; }
+
+  /** Mean weight over the stable window, valid after DETECTED. */
+  float weightKg() const { return _weight; }
+
+  /** Duration of the last LOADING phase (first step → detected/rejected). */
+  uint32_t loadingMs() const { return _loadingMs; }
+
+  /** Feeds one reading (NaN = no reading; restarts the stable window). */
+  Event sample(uint32_t now_ms, float kg) {
+    switch (_state) {
+      case State::DISARMED:
+        if (!isnan(kg) && kg < _cfg.min_kg * _cfg.rearm_frac) _state = State::EMPTY;
+        return Event::NONE;
+
+      case State::EMPTY:
+        if (isnan(kg) || kg < _cfg.min_kg) return Event::NONE;
+        _state     = State::LOADING;
+        _stepStart = now_ms;
+        window(now_ms, kg);
+        return Event::NONE;
+
+      case State::LOADING:
+        if (isnan(kg)) {
+          _n = 0;   // restart on the next good reading
+          return Event::NONE;
+        }
+        if (kg < _cfg.min_kg) {
+          _state     = State::EMPTY;
+          _loadingMs = now_ms - _stepStart;
+          return Event::REJECTED;
+        }
+        if (_n == 0 || fmaxf(_max, kg) - fminf(_min, kg) > _cfg.band_kg) {
+          window(now_ms, kg);   // still moving
+          return Event::NONE;
+        }
+        if (kg < _min) _min = kg;
+        if (kg > _max) _max = kg;
+        _sum += kg;
+        if (_n < UINT16_MAX) _n++;
+        if (now_ms - _since < _cfg.hold_ms || _n < _cfg.min_samples) return Event::NONE;
+        _weight    = _sum / _n;
+        _loadingMs = now_ms - _stepStart;
+        _state     = State::DISARMED;
+        return Event::DETECTED;
+    }
+    return Event::NONE;
+  }
+
+private:
+  Config   _cfg;
+  State    _state     = State::DISARMED;   // boot with a tote on the scale ≠ new tote
+  uint32_t _stepStart = 0;
+  uint32_t _since     = 0;
+  float    _min = 0, _max = 0, _sum = 0;
+  uint16_t _n         = 0;
+  float    _weight    = NAN;
+  uint32_t _loadingMs = 0;
+
+  void window(uint32_t now_ms, float kg) {
+    _since = now_ms;
+    _min = _max = _sum = kg;
+    _n = 1;
+  }
+};
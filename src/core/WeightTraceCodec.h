@@ -0,0 +1,126 @@
+#pragma once
+// ============================================================
+// WeightTraceCodec  —  Delta + zigzag varint weight curves
+//
+// Stream layout (little overhead, byte oriented):
+//   'W' 'T' <version=1>
+//   per sample: varint(dt_ms) zigzag-varint(dw_g)
+// The first sample is relative to t=0 / 0 g, so it carries the
+// absolute timestamp and weight. A scale sample that moves a few
+// grams ~40 ms after the previous one costs 2 bytes instead of 8.
+//
+// Plain C++ (no Arduino): shared by the firmware, the native
+// benchmarks and mirrored by tools/weight_trace.py.
+// ============================================================
+#include <stdint.h>
+#include <stddef.h>
+
+namespace WeightTraceCodec {
+
+  static const uint8_t MAGIC_0  = 'W';
+  static const uint8_t MAGIC_1  = 'T';
+  static const uint8_t FORMAT   = 1;   // not VERSION: config.h #defines that
+  static const uint8_t HEADER   = 3;
+  static const uint8_t MAX_SAMPLE_BYTES = 10;  // 5 (uint32 varint) + 5 (zigzag int32 varint)
+
+  inline uint32_t zigzag(int32_t v)   { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+  inline int32_t  unzigzag(uint32_t v) { return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+
+  inline size_t putVarint(uint8_t* out, uint32_t v) {
+    size_t n = 0;
+    while (v >= 0x80) {
+      out[n++] = (uint8_t)(v | 0x80);
+      v >>= 7;
+    }
+    out[n++] = (uint8_t)v;
+    return n;
+  }
+
+  /** Returns bytes consumed, 0 on truncated/overlong input. */
+  inline size_t getVarint(const uint8_t* in, size_t len, uint32_t& v) {
+    v = 0;
+    for (size_t i = 0; i < len && i < 5; i++) {
+      v |= (uint32_t)(in[i] & 0x7F) << (7 * i);
+      if (!(in[i] & 0x80)) return i + 1;
+    }
+    return 0;
+  }
+
+  class Encoder {
+  public:
+    Encoder() {}
+    Encoder(uint8_t* buf, size_t cap) { reset(buf, cap); }
+
+    void reset(uint8_t* buf, size_t cap) {
+      _buf = buf;
+      _cap = cap;
+      _len = 0;
+      _count = 0;
+      _lastT = 0;
+      _lastG = 0;
+      if (_cap >= HEADER) {
+        _buf[_len++] = MAGIC_0;
+        _buf[_len++] = MAGIC_1;
+        _buf[_len++] = FORMAT;
+      }
+    }
+
+    /** False (sample dropped) once the buffer is full. */
+    bool add(uint32_t t_ms, int32_t grams) {
+      if (!_buf || _len + MAX_SAMPLE_BYTES > _cap) return false;
+      _len += putVarint(_buf + _len, t_ms - _lastT);
+      _len += putVarint(_buf + _len, zigzag((int32_t)((uint32_t)grams - (uint32_t)_lastG)));
+      _lastT = t_ms;
+      _lastG = grams;
+      _count++;
+      return true;
+    }
+
+    const uint8_t* data()  const { return _buf; }
+    size_t         size()  const { return _len; }
+    uint32_t       count() const { return _count; }
+
+  private:
+    uint8_t* _buf   = nullptr;
+    size_t   _cap   = 0;
+    size_t   _len   = 0;
+    uint32_t _count = 0;
+    uint32_t _lastT = 0;
+    int32_t  _lastG = 0;
+  };
+
+  class Decoder {
+  public:
+    Decoder(const uint8_t* buf, size_t len) : _buf(buf), _len(len) {
+      _ok  = len >= HEADER && buf[0] == MAGIC_0 && buf[1] == MAGIC_1 && buf[2] == FORMAT;
+      _pos = HEADER;
+    }
+
+    bool valid() const { return _ok; }
+
+    bool next(uint32_t& t_ms, int32_t& grams) {
+      if (!_ok || _pos >= _len) return false;
+      uint32_t dt, zz;
+      size_t n = getVarint(_buf + _pos, _len - _pos, dt);
+      if (!n) return _ok = false;
+      _pos += n;
+      n = getVarint(_buf + _pos, _len - _pos, zz);
+      if (!n) return _ok = false;
+      _pos += n;
+      _t += dt;
+      _g = (int32_t)((uint32_t)_g + (uint32_t)unzigzag(zz));
+      t_ms  = _t;
+      grams = _g;
+      return true;
+    }
+
+  private:
+    const uint8_t* _buf;
+    size_t         _len;
+    size_t         _pos;
+    bool           _ok;
+    uint32_t       _t = 0;
+    int32_t        _g = 0;
+  };
+
+} // namespace WeightTraceCodec
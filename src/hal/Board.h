@@ -0,0 +1,31 @@
+#pragma once
+// ============================================================
+// Board  —  Compile-time choice of Hal implementations
+//
+// Device builds get the ESP32 set; native envs pass -DHAL_HOST.
+// Code templated on a Board (or using Hal::Board* directly) has
+// no virtual dispatch in either case.
+// ============================================================
+#ifdef HAL_HOST
+  #include "HostHal.h"
+  namespace Hal {
+    struct HostBoard {
+      typedef HostScale   ScaleT;
+      typedef HostIo      IoT;
+      typedef HostClock   ClockT;
+      typedef HostNetwork NetworkT;
+    };
+    typedef HostBoard Board;
+  }
+#else
+  #include "Esp32Hal.h"
+  namespace Hal {
+    struct Esp32Board {
+      typedef Esp32Scale   ScaleT;
+      typedef Esp32Io      IoT;
+      typedef Esp32Clock   ClockT;
+      typedef Esp32Network NetworkT;
+    };
+    typedef Esp32Board Board;
+  }
+#endif
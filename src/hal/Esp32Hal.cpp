@@ -0,0 +1,19 @@
+// ============================================================
+// Esp32Hal.cpp  —  Out-of-line ESP32 Hal pieces
+// ============================================================
+#include "Esp32Hal.h"
+
+namespace Hal {
+
+  void Esp32Io::setupOutputImpl(uint8_t ch) {
+    gpio_config_t io_conf = {};
+    io_conf.intr_type    = GPIO_INTR_DISABLE;
+    io_conf.mode         = GPIO_MODE_OUTPUT;
+    io_conf.pin_bit_mask = (1ULL << ch);
+    io_conf.pull_down_en = GPIO_PULLDOWN_DISABLE;
+    io_conf.pull_up_en   = GPIO_PULLUP_DISABLE;
+    gpio_config(&io_conf);
+    gpio_set_level((gpio_num_t)ch, LOW);  // Asegura que inicien en LOW
+  }
+
+} // namespace Hal
@@ -0,0 +1,81 @@
+#pragma once
+// ============================================================
+// Esp32Hal  —  Hal implementations for the EdgeBox ESP-100
+// ============================================================
+#include <Arduino.h>
+#include "driver/gpio.h"
+#include "config.h"
+#include "Hal.h"
+#include "../marel.h"
+#include "../ScaleBus.h"
+#include "../hardware/WIFI.h"
+
+namespace Hal {
+
+  class Esp32Scale : public Scale<Esp32Scale> {
+  public:
+    explicit Esp32Scale(uint8_t slaveID = MAREL_SLAVE_ID) : _marel(slaveID, bus()) {}
+
+    void  beginImpl()     { _marel.begin(); }
+    void  pollImpl()      { _marel.task(); }
+    // Polled: ScaleBus's latest read while it is fresh, no bus wait.
+    // Otherwise a read of its own, NAN when it failed (not attached,
+    // line busy, no answer), like HostScale offline: never 0 kg or
+    // the previous registers
+    float netKgImpl() {
+      const MarelClient::Priority p = _marel.priority();
+      if (p != MarelClient::POLL_OFF) {
+        uint32_t age;
+        const WeightReading r = _marel.latest(&age);
+        if (r.ok && age <= (p == MarelClient::POLL_ACTIVE ? SCALE_MAX_AGE_ACTIVE_MS
+                                                          : SCALE_MAX_AGE_IDLE_MS)) return r.kg;
+      }
+      return _marel.getNetWeightKg();
+    }
+    bool  tareImpl()      { return _marel.setTare(); }
+    bool  clearTareImpl() { return _marel.clearTare(); }
+    void  setPollImpl(Poll p) {
+      _marel.setPriority(p == Poll::ACTIVE ? MarelClient::POLL_ACTIVE :
+                         p == Poll::IDLE   ? MarelClient::POLL_IDLE   : MarelClient::POLL_OFF);
+    }
+
+    MarelClient& marel() { return _marel; }   // serial "marel bench"
+
+    /** The RS-485 line every Esp32Scale shares (UART1). */
+    static ScaleBus& bus() {
+      static ScaleBus s_bus(MAREL_RX_PIN, MAREL_TX_PIN, MAREL_DE_RE_PIN);
+      return s_bus;
+    }
+
+  private:
+    MarelClient _marel;
+  };
+
+  class Esp32Io : public DigitalIo<Esp32Io> {
+  public:
+    void setupOutputImpl(uint8_t ch);
+    void writeImpl(uint8_t ch, uint8_t level) { gpio_set_level((gpio_num_t)ch, level); }
+    bool readImpl(uint8_t ch)                 { return gpio_get_level((gpio_num_t)ch); }
+  };
+
+  class Esp32Clock : public Clock<Esp32Clock> {
+  public:
+    uint32_t millisImpl()            { return ::millis(); }
+    uint32_t microsImpl()            { return ::micros(); }
+    void     sleepMsImpl(uint32_t ms) { vTaskDelay(ms / portTICK_PERIOD_MS); }
+  };
+
+  class Esp32Network : public Network<Esp32Network> {
+  public:
+    explicit Esp32Network(WIFI& wifi) : _wifi(wifi) {}
+
+    bool connectedImpl()               { return _wifi.isConnected(); }
+    void reconnectImpl()               { _wifi.reconnect(); }
+    void pollImpl()                    { _wifi.loop(); _wifi.loopWS(); }
+    void broadcastWeightImpl(float kg) { _wifi.broadcastWeight(kg); }
+
+  private:
+    WIFI& _wifi;
+  };
+
+} // namespace Hal
@@ -0,0 +1,88 @@
+#pragma once
+// ============================================================
+// Hal  —  Hardware interfaces the control logic is written against
+//
+//   Scale    net weight, tare / clear tare, bus polling, poll rate
+//   DigitalIo  EdgeBox DI/DO channels
+//   Clock    ms/µs time base and blocking waits
+//   Network  link state, reconnect, weight broadcast to browsers
+//
+// Static polymorphism (CRTP): each interface forwards to the
+// implementation's *Impl() methods at compile time, so on the
+// device Controller calls land directly in the ESP32 code with no
+// vtable and are inlined. Implementations:
+//   hal/Esp32Hal.h  MarelClient, gpio_*, millis/vTaskDelay, WIFI
+//   hal/HostHal.h   in-memory scale and I/O, virtual clock
+// hal/Board.h picks one set at build time (-DHAL_HOST).
+//
+// Plain C++ (no Arduino).
+// ============================================================
+#include <stdint.h>
+
+namespace Hal {
+
+  /** Background reading rate of a scale (Scale::setPoll). */
+  enum class Poll : uint8_t {
+    OFF,      // no background reads: every netKg() is a bus transaction
+    IDLE,     // waiting for a tote, slow
+    ACTIVE    // dosing, as fast as the line allows
+  };
+
+  template <class Impl>
+  class Scale {
+  public:
+    void  begin()     { impl().beginImpl(); }
+    /** Drives the bus (Modbus task). Call every loop pass. */
+    void  poll()      { impl().pollImpl(); }
+    /**
+     * Net weight (gross − tare) in kg, NAN when the scale did not answer
+     * (timeout, error reply, bus busy). Every board: callers tell "no
+     * reading" from an empty scale by this alone.
+     */
+    float netKg()     { return impl().netKgImpl(); }
+    bool  tare()      { return impl().tareImpl(); }
+    bool  clearTare() { return impl().clearTareImpl(); }
+    /**
+     * IDLE / ACTIVE: netKg() answers from the latest background read
+     * while it is recent enough, instead of a transaction of its own.
+     */
+    void  setPoll(Poll p) { impl().setPollImpl(p); }
+  private:
+    Impl& impl() { return static_cast<Impl&>(*this); }
+  };
+
+  template <class Impl>
+  class DigitalIo {
+  public:
+    void setupOutput(uint8_t ch)           { impl().setupOutputImpl(ch); }
+    void write(uint8_t ch, uint8_t level)  { impl().writeImpl(ch, level); }
+    bool read(uint8_t ch)                  { return impl().readImpl(ch); }
+  private:
+    Impl& impl() { return static_cast<Impl&>(*this); }
+  };
+
+  template <class Impl>
+  class Clock {
+  public:
+    uint32_t millis()              { return impl().millisImpl(); }
+    uint32_t micros()              { return impl().microsImpl(); }
+    /** Blocks the calling task (scale command settle times). */
+    void     sleepMs(uint32_t ms)  { impl().sleepMsImpl(ms); }
+  private:
+    Impl& impl() { return static_cast<Impl&>(*this); }
+  };
+
+  template <class Impl>
+  class Network {
+  public:
+    bool connected()                 { return impl().connectedImpl(); }
+    /** Next reconnect attempt when due; must not block. */
+    void reconnect()                 { impl().reconnectImpl(); }
+    /** Link events and web sockets; call every loop pass. */
+    void poll()                      { impl().pollImpl(); }
+    void broadcastWeight(float kg)   { impl().broadcastWeightImpl(kg); }
+  private:
+    Impl& impl() { return static_cast<Impl&>(*this); }
+  };
+
+} // namespace Hal
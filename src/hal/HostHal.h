@@ -0,0 +1,104 @@
+#pragma once
+// ============================================================
+// HostHal  —  Hal implementations for native builds
+//
+// Deterministic and instant: the scale is a settable value, I/O
+// is two arrays, the clock is virtual (sleepMs() advances it
+// instead of blocking), the network records what was sent.
+// Benchmarks and the simulator drive these directly.
+//
+// Plain C++ (no Arduino).
+// ============================================================
+#include <math.h>
+#include <string.h>
+#include <functional>
+#include "Hal.h"
+
+namespace Hal {
+
+  class HostScale : public Scale<HostScale> {
+  public:
+    HostScale() = default;
+    explicit HostScale(uint8_t /* slaveID: one fake per lane */) {}
+
+    // ── Test side ──────────────────────────────────────────────
+    void  setGrossKg(float kg) { _gross = kg; }
+    void  setOnline(bool on)   { _online = on; }
+    float tareKg() const       { return _tare; }
+    uint32_t reads = 0, polls = 0, tares = 0;
+    Poll  pollRate = Poll::OFF;
+    // Gross reading per read (simulator: plant model + bus timing);
+    // replaces setGrossKg(). NAN = no answer
+    std::function<float()> source;
+
+    // ── Hal::Scale ─────────────────────────────────────────────
+    void  beginImpl()     {}
+    void  pollImpl()      { polls++; }
+    float netKgImpl() {
+      reads++;
+      if (!_online) return NAN;
+      return (source ? source() : _gross) - _tare;
+    }
+    bool  tareImpl()      { tares++; if (_online) _tare = source ? source() : _gross; return _online; }
+    bool  clearTareImpl() { if (_online) _tare = 0; return _online; }
+    void  setPollImpl(Poll p) { pollRate = p; }
+
+  private:
+    float _gross  = 0;
+    float _tare   = 0;
+    bool  _online = true;
+  };
+
+  class HostIo : public DigitalIo<HostIo> {
+  public:
+    static const uint8_t CHANNELS = 16;
+
+    // ── Test side ──────────────────────────────────────────────
+    uint8_t output(uint8_t ch) const   { return ch < CHANNELS ? _out[ch] : 0; }
+    void    setInput(uint8_t ch, bool v) { if (ch < CHANNELS) _in[ch] = v; }
+    uint32_t writes = 0;
+
+    // ── Hal::DigitalIo ─────────────────────────────────────────
+    void setupOutputImpl(uint8_t ch)          { writeImpl(ch, 0); }
+    void writeImpl(uint8_t ch, uint8_t level) { writes++; if (ch < CHANNELS) _out[ch] = level; }
+    bool readImpl(uint8_t ch)                 { return ch < CHANNELS && _in[ch]; }
+
+  private:
+    uint8_t _out[CHANNELS] = {};
+    bool    _in[CHANNELS]  = {};
+  };
+
+  class HostClock : public Clock<HostClock> {
+  public:
+    // ── Test side ──────────────────────────────────────────────
+    void     advanceMs(uint32_t ms) { _us += (uint64_t)ms * 1000; }
+    void     advanceUs(uint32_t us) { _us += us; }
+    uint64_t nowUs() const          { return _us; }
+
+    // ── Hal::Clock ─────────────────────────────────────────────
+    uint32_t millisImpl()             { return (uint32_t)(_us / 1000); }
+    uint32_t microsImpl()             { return (uint32_t)_us; }
+    void     sleepMsImpl(uint32_t ms) { advanceMs(ms); }
+
+  private:
+    uint64_t _us = 0;
+  };
+
+  class HostNetwork : public Network<HostNetwork> {
+  public:
+    // ── Test side ──────────────────────────────────────────────
+    void  setConnected(bool up) { _up = up; }
+    float lastBroadcastKg = NAN;
+    uint32_t broadcasts = 0, reconnects = 0;
+
+    // ── Hal::Network ───────────────────────────────────────────
+    bool connectedImpl()               { return _up; }
+    void reconnectImpl()               { reconnects++; _up = true; }
+    void pollImpl()                    {}
+    void broadcastWeightImpl(float kg) { lastBroadcastKg = kg; broadcasts++; }
+
+  private:
+    bool _up = true;
+  };
+
+} // namespace Hal
@@ -0,0 +1,109 @@
+#pragma once
+// ============================================================
+// Station  —  Scale, I/O and clock of one station, on any Board
+//
+// The part of Controller the tote state machine actually touches
+// (weight, tare, pumps, buttons), written once against the Hal
+// interfaces. Each Lane holds a Station<Hal::Board>; native
+// benchmarks and tests build Station<Hal::HostBoard>.
+// ============================================================
+#include <Arduino.h>   // Serial for LOG_* (host: src/host/shim)
+#include <math.h>
+#include "Board.h"
+#include "../Debug.h"
+
+namespace Hal {
+
+  template <class B>
+  class Station {
+  public:
+    typename B::ScaleT scale;
+    typename B::IoT    io;
+    typename B::ClockT clock;
+
+    // The M2200 needs this long after a tare command before the
+    // net weight reflects it (hardwareTare / hardwareClearTare only)
+    static const uint32_t TARE_SETTLE_MS = 500;
+
+    Station() = default;
+    /** Scale handle for one slave on the shared line (one Station per Lane). */
+    explicit Station(uint8_t slaveID) : scale(slaveID) {}
+
+    void begin() { scale.begin(); }
+
+    void setUpOutputs(const uint8_t* outputs, uint8_t count) {
+      for (uint8_t i = 0; i < count; i++) io.setupOutput(outputs[i]);
+    }
+
+    /** Indicator reading minus the software tare; NAN when the scale did not answer. */
+    float getWeight() {
+      const float weight = getScaleWeight();
+      return isnan(weight) ? NAN : weight - _tareKg;
+    }
+
+    /** What the indicator shows (its own net: gross − hardware tare). */
+    float getScaleWeight() {
+      const float weight = scale.netKg();  // p.ej. "0.00" o "76.4" (peso neto = bruto - tara)
+      LOG_CTRL_V("Raw Weight: %.2f\n", weight);
+
+      if (isnan(weight)) {
+        LOG_CTRL("Failed to get weight from Marel\n");
+        return NAN;
+      }
+
+      // Muestra con 2 decimales sí o sí
+      LOG_CTRL_V("Parsed Weight: %.2f\n", weight);
+      return weight;
+    }
+
+    // ── Software tare ────────────────────────────────────────────
+    // The baseline is kept here and subtracted from every reading, so
+    // taring costs no Modbus command and no settle wait, and cannot be
+    // lost by an indicator that ignored the coil write.
+
+    /** Tare at the current reading. False (tare unchanged) if the scale did not answer. */
+    bool setTare() {
+      const float weight = getScaleWeight();
+      if (isnan(weight)) return false;
+      setTare(weight);
+      return true;
+    }
+
+    /** Tare at a reading the caller already has (no bus traffic). */
+    void setTare(float scale_kg) {
+      _tareKg = scale_kg;
+      LOG_CTRL_V("Software tare: %.2f kg\n", _tareKg);
+    }
+
+    void  clearTare()      { _tareKg = 0; }
+    float tareKg() const   { return _tareKg; }
+
+    // ── Hardware tare (explicit request only) ────────────────────
+    // Coil write to the indicator plus its settle wait: blocks the
+    // loop for TARE_SETTLE_MS. Drops the software tare, since the
+    // indicator's zero has moved.
+
+    bool hardwareTare() {
+      const bool ok = scale.tare();
+      // espérese 500ms para que la báscula procese el comando de tara antes de intentar leer el peso
+      clock.sleepMs(TARE_SETTLE_MS);
+      _tareKg = 0;
+      return ok;
+    }
+
+    bool hardwareClearTare() {
+      const bool ok = scale.clearTare();
+      clock.sleepMs(TARE_SETTLE_MS);
+      _tareKg = 0;
+      return ok;
+    }
+
+    void task()                                 { scale.poll(); }
+    bool readDigitalInput(uint8_t input)        { return io.read(input); }
+    void writeDigitalOutput(uint8_t output, uint8_t value) { io.write(output, value); }
+
+  private:
+    float _tareKg = 0;
+  };
+
+} // namespace Hal
@@ -1,10 +1,9 @@
 #include "Controller.h"
 #include "../Debug.h"
 
-// Configuración Modbus RTU para RS-485
+// Modbus RTU (Marel M2200 por RS-485): ver Hal::Esp32Scale en src/hal/Esp32Hal.h
 // Pines: RX=IO18 (U1RXD), TX=IO17 (U1TXD), DE/RE=IO8 (RS485_RTS)
-// Slave ID = 1 (según el simulador)
-MarelClient marel(1, 18, 17, 8);
+// Una báscula por Lane (slave ID en LANE_TABLE, config.h)
 
 
 void Controller::init(){
@@ -33,14 +32,6 @@ void Controller::setupPinMode( uint8_t pin, gpio_mode_t mode){
   gpio_config(&io_conf);
 }
 
-void Controller::task() {
-  marel.task();  // Procesar comunicación Modbus
-}
-
-void Controller::setUpIOS(){
-  setUpDigitalOutputs();
-}
-
 void Controller::setUpI2C(){
 
 }
@@ -50,20 +41,16 @@ void Controller::loopOTA() {
 }
 
 void Controller::WiFiLoop() {
-  wifi.loopWS();
-  if (!isWiFiConnected()) {
-    reconnectWiFi();
-    vTaskDelay(500 / portTICK_PERIOD_MS);
-    return;
-  }
+  net.poll();
+  if (!isWiFiConnected()) reconnectWiFi();  // no bloquea: lanza el siguiente intento si toca
 }
 
 void Controller::reconnectWiFi() {
-  wifi.reconnect();
+  net.reconnect();
 }
 
 bool Controller::isWiFiConnected() {
-  return wifi.isConnected();
+  return net.connected();
 }
 
 void Controller::setUpWiFi(const char* ssid, const char* password, const char* hostname) {
@@ -76,9 +63,12 @@ void Controller::connectToWiFi(bool web_server, bool web_serial, bool OTA) {
   if(web_server) wifi.setUpWebServer(web_serial);
 }
 
+void Controller::setUpWebServer(bool web_serial) {
+  wifi.setUpWebServer(web_serial);
+}
+
 void Controller::setState(ControllerState state){
   this->state = state;
-  toteState = ToteState::DISPENSING_ICE;
   
   LOG_CTRL("State changed from %d to %d\n", (int)state, (int)this->state);
 }
@@ -88,42 +78,7 @@ ControllerState Controller::getState(){
 }
 
 void Controller::setUpDevice(){
-  marel.begin();
-}
-
-bool Controller::setTare(){
-  marel.setTare();
-  // espérese 500ms para que la báscula procese el comando de tara antes de intentar leer el peso
-  vTaskDelay(500 / portTICK_PERIOD_MS);
-  return true;
-}
-
-void Controller::clearTare(){
-  marel.clearTare();
-  vTaskDelay(500 / portTICK_PERIOD_MS);
-}
-
-float Controller::getWeight(){
-  float weight = marel.getNetWeightKg(); // p.ej. "0.00" o "76.4" (peso neto = bruto - tara)
-  LOG_CTRL("Raw Weight: %.2f\n", weight);
-
-  if (isnan(weight)) {
-    LOG_CTRL("Failed to get weight from Marel\n");
-    return NAN;
-  }
-
-  // Muestra con 2 decimales sí o sí
-  LOG_CTRL("Parsed Weight: %.2f\n", weight); // o Serial.println(val, 2);
-  return weight;
-
-}
-
-
-void Controller::setUpDigitalOutputs() {
-    for (auto &output : outputs) {
-        setupPinMode(output, GPIO_MODE_OUTPUT);
-        gpio_set_level((gpio_num_t)output, LOW); // Asegura que inicien en LOW
-    }
+  // Básculas: Lane::begin() (comparten la línea RS-485, ver ScaleBus)
 }
 
 void Controller::setUpRTC(){
@@ -135,15 +90,15 @@ bool Controller::isRTCConnected(){
 }
 
 bool Controller::readDigitalInput(uint8_t input){
-  return gpio_get_level((gpio_num_t)input);
+  return io.read(input);
 }
 
 void Controller::writeDigitalOutput(uint8_t output, uint8_t value){
-  gpio_set_level((gpio_num_t)output, value);
+  io.write(output, value);
 }
 
 void Controller::broadcastWeight(float weight){
-  wifi.broadcastWeight(weight);
+  net.broadcastWeight(weight);
 }
 
 bool Controller::hasIntervalPassed(uint32_t &previousMillis, uint32_t interval, bool to_min) {
@@ -12,6 +12,7 @@
 #include "driver/gpio.h"
 #include <Preferences.h>
 #include "EdgeBox_ESP_100.h"
+#include "../hal/Board.h"
 
 enum ControllerState {
     IDLE,
@@ -21,17 +22,6 @@ enum ControllerState {
     TOTE_READY
 };
 
-enum class ToteState {
-  IDLE,
-  DISPENSING_ICE,
-  SETTLING_ICE,       // 5 s pause after ice: pumps off, scale settles
-  DISPENSING_WATER,
-  WAITING_TOTE_ID,
-  COMPLETED,
-  CANCELED,
-  ERROR
-};
-
 struct ToteContext {
   String toteId;        // lo captura operador después
   String lotNo;         // lo puedes pasar desde UI
@@ -47,7 +37,6 @@ struct ToteContext {
 };
 
 extern tote_data currentTote;
-static ToteState toteState = ToteState::IDLE;
 
 
 class Controller {
@@ -55,31 +44,28 @@ private:
     EdgeBox_ESP_100 edgebox;
     ControllerState state = IDLE;
 
-    const uint8_t outputs[3] = {WATER_PUMP, ICE_PUMP, ICE_STOP};
+    // DI/DO detrás de la HAL (src/hal); báscula y bombas de cada
+    // posición de llenado: Lane (src/Lane.h)
+    Hal::Board::IoT io;
 
     void setUpI2C();    
     void resetStrapedpins();
     void setUpDevice();
     void setUpDigitalInputs();
-    void setUpDigitalOutputs();
     
     public:
     // ~Controller();
     // Controller(/* args */);
     WIFI wifi;
+    Hal::Board::NetworkT net{wifi};
     
     void init();
-    void task();  // Procesar tareas del Modbus
-    bool setTare();
-    void clearTare();
     void setUpRTC();
-    void setUpIOS();
     
     void loopOTA();
     void WiFiLoop();
     void reconnectWiFi();
     bool isWiFiConnected();
-    float getWeight();
     bool isRTCConnected();
     ControllerState getState();
     void setState(ControllerState state);
@@ -87,6 +73,7 @@ private:
     void setupPinMode( uint8_t pin, gpio_mode_t mode);
     void writeDigitalOutput(uint8_t output, uint8_t value);
     void connectToWiFi(bool web_server, bool web_serial, bool OTA);
+    void setUpWebServer(bool web_serial);
     void setUpWiFi(const char* ssid, const char* password, const char* hostname);
     bool hasIntervalPassed(uint32_t &previousMillis, uint32_t interval, bool to_min);
     void broadcastWeight(float weight);
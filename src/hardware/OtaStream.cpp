@@ -0,0 +1,237 @@
+#include "OtaStream.h"
+#include <Update.h>
+#include "rom/miniz.h"      // tinfl in ROM: no inflate code in the image
+#include "esp_rom_crc.h"
+#include "../Debug.h"
+#include "../Metrics.h"
+
+// gzip (RFC 1952)
+static const uint8_t GZ_FHCRC    = 0x02;
+static const uint8_t GZ_FEXTRA   = 0x04;
+static const uint8_t GZ_FNAME    = 0x08;
+static const uint8_t GZ_FCOMMENT = 0x10;
+static const uint8_t GZ_DEFLATE  = 8;
+
+static int hexDigit(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+static uint32_t le32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// ── Upload ────────────────────────────────────────────────────────────────────
+
+bool OtaStream::begin(int cmd, size_t contentLen, const char* sha256Hex) {
+  if (_updating) Update.abort();  // upload anterior cortado a medias
+  _updating   = false;
+  release();
+  _cmd        = cmd;
+  _contentLen = contentLen;
+  _phase      = DETECT;
+  _gzip       = false;
+  _error      = nullptr;
+  _in = _out  = 0;
+  _crc        = 0;
+  _startMs    = _endMs = millis();
+
+  _checkSha = sha256Hex && *sha256Hex;
+  if (_checkSha) {
+    if (strlen(sha256Hex) != 64) { abort("sha256: expected 64 hex digits"); return false; }
+    for (uint8_t i = 0; i < 32; i++) {
+      const int hi = hexDigit(sha256Hex[2 * i]), lo = hexDigit(sha256Hex[2 * i + 1]);
+      if (hi < 0 || lo < 0) { abort("sha256: not hex"); return false; }
+      _expected[i] = (uint8_t)(hi << 4 | lo);
+    }
+  }
+  mbedtls_sha256_init(&_sha);
+  mbedtls_sha256_starts_ret(&_sha, /*is224=*/0);
+  return true;
+}
+
+bool OtaStream::write(const uint8_t* data, size_t len) {
+  if (failed()) return false;
+  _in += len;
+
+  if (_phase == DETECT) {
+    _gzip = len >= 2 && data[0] == 0x1f && data[1] == 0x8b;
+    // Comprimido: tamaño final desconocido hasta el trailer
+    const size_t size = _gzip || _contentLen == 0 ? UPDATE_SIZE_UNKNOWN : _contentLen;
+    if (!Update.begin(size, _cmd)) { abort(Update.errorString()); return false; }
+    _updating = true;
+    if (_gzip && !startGzip()) return false;
+    _phase = _gzip ? HEADER : RAW;
+  }
+
+  size_t used = 0;
+  while (used < len && !failed()) {
+    switch (_phase) {
+      case RAW:     return emit(data, len);
+      case HEADER:  used += parseHeader(data + used, len - used); break;
+      case INFLATE: used += inflate(data + used, len - used);     break;
+      case TRAILER: used += readTrailer(data + used, len - used); break;
+      default:      used = len; break;  // bytes after the gzip member: ignored
+    }
+  }
+  return !failed();
+}
+
+bool OtaStream::end() {
+  _endMs = millis();
+  if (failed()) return false;
+
+  if (_phase == DETECT)        { abort("empty upload"); return false; }
+  if (_gzip && _phase != DONE) { abort("gzip: truncated"); return false; }
+  if (_gzip && le32(_trailer) != _crc)     { abort("gzip: CRC-32 mismatch"); return false; }
+  if (_gzip && le32(_trailer + 4) != _out) { abort("gzip: length mismatch"); return false; }
+
+  uint8_t digest[32];
+  mbedtls_sha256_finish_ret(&_sha, digest);
+  if (_checkSha && memcmp(digest, _expected, sizeof(digest)) != 0) {
+    abort("sha256 mismatch");
+    return false;
+  }
+
+  release();
+  _phase    = DONE;
+  _updating = false;
+  if (!Update.end(true)) {  // valida la imagen y cambia la partición de arranque
+    _error = Update.errorString();
+    Metrics::inc(Metrics::OTA_FAILURES);
+    LOG_ERR("OTA failed: %s\n", _error);
+    return false;
+  }
+
+  const uint32_t ms = elapsedMs() ? elapsedMs() : 1;
+  Metrics::inc(Metrics::OTA_UPDATES);
+  Metrics::set(Metrics::OTA_THROUGHPUT, (int32_t)((uint64_t)_in * 1000 / ms));
+  LOG_WIFI("OTA %s: %u bytes received, %u written, %lu ms (%lu KB/s on the wire)%s\n",
+           _gzip ? "gzip" : "raw", _in, _out, (unsigned long)ms,
+           (unsigned long)((uint64_t)_in * 1000 / ms / 1024), _checkSha ? ", sha256 OK" : "");
+  return true;
+}
+
+void OtaStream::abort(const char* why) {
+  if (!failed()) Metrics::inc(Metrics::OTA_FAILURES);
+  _error = why;
+  _endMs = millis();
+  if (_updating) Update.abort();
+  _updating = false;
+  _phase    = DONE;
+  release();
+  LOG_ERR("OTA aborted: %s (%u bytes received)\n", why, _in);
+}
+
+// ── Passthrough / inflate output ─────────────────────────────────────────────
+
+bool OtaStream::emit(const uint8_t* p, size_t n) {
+  if (Update.write(const_cast<uint8_t*>(p), n) != n) {
+    abort(Update.errorString());
+    return false;
+  }
+  mbedtls_sha256_update_ret(&_sha, p, n);
+  if (_gzip) _crc = esp_rom_crc32_le(_crc, p, n);
+  _out += n;
+  return true;
+}
+
+// ── gzip ──────────────────────────────────────────────────────────────────────
+
+bool OtaStream::startGzip() {
+  _inf  = (tinfl_decompressor_tag*)malloc(sizeof(tinfl_decompressor));
+  _dict = (uint8_t*)malloc(TINFL_LZ_DICT_SIZE);
+  if (!_inf || !_dict) {
+    abort("gzip: no memory for the inflate window");
+    return false;
+  }
+  tinfl_init(_inf);
+  _dictOfs = 0;
+  _field   = F_FIXED;
+  _flags   = 0;
+  _pos     = 0;
+  return true;
+}
+
+// Header fields in RFC order; called when the current one is complete
+void OtaStream::nextField() {
+  _pos = 0;
+  if (_flags & GZ_FEXTRA)   { _flags &= ~GZ_FEXTRA;   _field = F_XLEN; _need = 0; return; }
+  if (_flags & GZ_FNAME)    { _flags &= ~GZ_FNAME;    _field = F_ZSTR; return; }
+  if (_flags & GZ_FCOMMENT) { _flags &= ~GZ_FCOMMENT; _field = F_ZSTR; return; }
+  if (_flags & GZ_FHCRC)    { _flags &= ~GZ_FHCRC;    _field = F_SKIP; _need = 2; return; }
+  _phase = INFLATE;
+}
+
+size_t OtaStream::parseHeader(const uint8_t* p, size_t n) {
+  size_t i = 0;
+  while (i < n && _phase == HEADER) {
+    const uint8_t b = p[i++];
+    switch (_field) {
+      case F_FIXED:  // magic, method, flags, mtime, xfl, os
+        if (_pos == 2 && b != GZ_DEFLATE) { abort("gzip: not deflate"); return n; }
+        if (_pos == 3) _flags = b;
+        if (++_pos == 10) nextField();
+        break;
+      case F_XLEN:
+        _need |= (uint16_t)b << (8 * _pos);
+        if (++_pos == 2) {
+          _field = F_SKIP;
+          _pos   = 0;
+          if (_need == 0) nextField();
+        }
+        break;
+      case F_ZSTR:   // file name / comment, zero-terminated
+        if (b == 0) nextField();
+        break;
+      case F_SKIP:
+        if (++_pos == _need) nextField();
+        break;
+    }
+  }
+  return i;
+}
+
+// Inflated bytes land in _dict at _dictOfs (tinfl wraps the ring and
+// uses it as the 32 KB history) and go to flash from there
+size_t OtaStream::inflate(const uint8_t* p, size_t n) {
+  size_t used = 0;
+  for (;;) {
+    size_t inBytes  = n - used;
+    size_t outBytes = TINFL_LZ_DICT_SIZE - _dictOfs;
+    const tinfl_status st = tinfl_decompress(_inf, p + used, &inBytes, _dict, _dict + _dictOfs,
+                                             &outBytes, TINFL_FLAG_HAS_MORE_INPUT);
+    used += inBytes;
+    if (outBytes && !emit(_dict + _dictOfs, outBytes)) return n;
+    _dictOfs = (_dictOfs + outBytes) & (TINFL_LZ_DICT_SIZE - 1);
+
+    if (st == TINFL_STATUS_DONE) {
+      _phase = TRAILER;
+      _pos   = 0;
+      return used;
+    }
+    if (st < 0) {
+      abort("gzip: corrupt deflate data");
+      return n;
+    }
+    if (st == TINFL_STATUS_NEEDS_MORE_INPUT) return used;  // all of p consumed
+    // TINFL_STATUS_HAS_MORE_OUTPUT: the ring filled up, go around
+  }
+}
+
+size_t OtaStream::readTrailer(const uint8_t* p, size_t n) {
+  size_t i = 0;
+  while (i < n && _pos < sizeof(_trailer)) _trailer[_pos++] = p[i++];
+  if (_pos == sizeof(_trailer)) _phase = DONE;
+  return i;
+}
+
+void OtaStream::release() {
+  free(_inf);
+  free(_dict);
+  _inf  = nullptr;
+  _dict = nullptr;
+  mbedtls_sha256_free(&_sha);
+}
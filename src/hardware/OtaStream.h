@@ -0,0 +1,90 @@
+#ifndef OTA_STREAM_H
+#define OTA_STREAM_H
+// ============================================================
+// OtaStream  —  /update upload → flash, gzip inflated on the fly
+//
+// The upload arrives in TCP-sized chunks (AsyncWebServer upload
+// callback). A gzip image (magic 1f 8b) is inflated with the ROM's
+// tinfl into a fixed 32 KB ring, the deflate window, and every run
+// of inflated bytes goes straight to Update.write(). A plain .bin
+// passes through unchanged. Buffers (~43 KB) are allocated only for
+// a gzip upload and freed by end() / abort().
+//
+// Integrity: SHA-256 of the bytes written to flash (= sha256sum of
+// the uncompressed firmware.bin) against the digest given with the
+// upload, plus gzip's CRC-32 / length trailer. A mismatch aborts
+// before the boot partition is switched.
+//
+// One update at a time; AsyncTCP task only.
+// ============================================================
+#include <Arduino.h>
+#include <mbedtls/sha256.h>
+
+struct tinfl_decompressor_tag;
+
+class OtaStream {
+public:
+  /**
+   * New update (first chunk). cmd: U_FLASH / U_SPIFFS. sha256Hex:
+   * 64 hex digits of the uncompressed image, or nullptr to skip the
+   * check. Update.begin() runs on the first write(), once the data
+   * says whether it is compressed.
+   */
+  bool begin(int cmd, size_t contentLen, const char* sha256Hex);
+
+  /** Next chunk of the upload. False once the update has failed. */
+  bool write(const uint8_t* data, size_t len);
+
+  /** After the last chunk: trailer / digest checks, then Update.end(). */
+  bool end();
+
+  /** Drops the update (Update.abort()), keeps why for error(). */
+  void abort(const char* why);
+
+  bool        failed() const     { return _error != nullptr; }
+  const char* error() const      { return _error ? _error : ""; }
+  bool        compressed() const { return _gzip; }
+  uint32_t    bytesIn() const    { return _in; }    // upload (compressed) bytes
+  uint32_t    bytesOut() const   { return _out; }   // bytes written to flash
+  uint32_t    elapsedMs() const  { return _endMs - _startMs; }
+
+private:
+  enum Phase : uint8_t { DETECT, HEADER, INFLATE, TRAILER, RAW, DONE };
+  enum Field : uint8_t { F_FIXED, F_XLEN, F_ZSTR, F_SKIP };
+
+  bool   startGzip();
+  size_t parseHeader(const uint8_t* p, size_t n);
+  void   nextField();
+  size_t inflate(const uint8_t* p, size_t n);
+  size_t readTrailer(const uint8_t* p, size_t n);
+  bool   emit(const uint8_t* p, size_t n);
+  void   release();
+
+  int         _cmd      = 0;
+  size_t      _contentLen = 0;
+  Phase       _phase    = DONE;
+  bool        _gzip     = false;
+  const char* _error    = nullptr;
+  bool        _updating = false;   // Update.begin() done, not ended / aborted
+
+  // gzip header: fixed 10 bytes, then the fields its flags announce
+  Field    _field = F_FIXED;
+  uint8_t  _flags = 0;
+  uint16_t _pos   = 0;
+  uint16_t _need  = 0;
+
+  tinfl_decompressor_tag* _inf  = nullptr;
+  uint8_t*                _dict = nullptr;   // TINFL_LZ_DICT_SIZE ring
+  uint32_t                _dictOfs = 0;
+
+  uint8_t  _trailer[8];                      // CRC-32, ISIZE (little endian)
+  uint32_t _crc = 0;
+
+  mbedtls_sha256_context _sha;
+  bool     _checkSha = false;
+  uint8_t  _expected[32];
+
+  uint32_t _in = 0, _out = 0;
+  uint32_t _startMs = 0, _endMs = 0;
+};
+#endif
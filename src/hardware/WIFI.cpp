@@ -2,55 +2,52 @@
 #include "WIFI.h"
 #include "../Settings.h"
 #include "../Debug.h"
+#include "../Metrics.h"
+#include "../ToteTrace.h"
+#include "../Stats.h"
+#include "../WeightRecorder.h"
+#include "OtaStream.h"
+#include <Preferences.h>
 
 AsyncWebServer server(80);
 
-static void handle_update_progress_cb(AsyncWebServerRequest *request, String filename, size_t index, uint8_t *data, size_t len, bool final) {
-  static bool updateOk = false;
+// Upload de /update: OtaStream descomprime (si viene en gzip), verifica
+// el sha256 opcional (?sha256=<hex del .bin sin comprimir>) y graba
+static OtaStream s_ota;
 
+static void handle_update_progress_cb(AsyncWebServerRequest *request, String filename, size_t index, uint8_t *data, size_t len, bool final) {
   if (!index) {
-    updateOk = false;
     int cmd = (filename.indexOf("spiffs") > -1) ? U_SPIFFS : U_FLASH;
-    size_t contentLen = request->contentLength();
-    if (!Update.begin(contentLen > 0 ? contentLen : UPDATE_SIZE_UNKNOWN, cmd)) {
-      Update.printError(Serial);
-      return;
-    }
-    updateOk = true;
-    LOG_WIFI("OTA update started: %s (%u bytes)\n", filename.c_str(), contentLen);
+    // ?sha256= en la URL, o campo de formulario antes del archivo
+    const AsyncWebParameter* p = request->hasParam("sha256") ? request->getParam("sha256")
+                               : request->getParam("sha256", true);
+    const char* sha = p ? p->value().c_str() : nullptr;
+    if (!s_ota.begin(cmd, request->contentLength(), sha)) return;
+    LOG_WIFI("OTA update started: %s (%u bytes)\n", filename.c_str(), request->contentLength());
   }
 
-  if (!updateOk) return;
+  if (!s_ota.write(data, len)) return;
+  if (final) s_ota.end();
+}
 
-  if (Update.write(data, len) != len) {
-    Update.printError(Serial);
-    updateOk = false;
+// Página comprimida de flash (WebFiles.h). Con el ETag que el navegador
+// ya tiene: 304 sin cuerpo. no-cache = puede guardarla pero revalida
+// cada vez, así un firmware nuevo nunca sirve la página vieja
+static void sendAsset(AsyncWebServerRequest *request, const WebAsset& asset) {
+  if (request->hasHeader("If-None-Match") && request->header("If-None-Match") == asset.etag) {
+    AsyncWebServerResponse *response = request->beginResponse(304);
+    response->addHeader("ETag", asset.etag);
+    response->addHeader("Cache-Control", "private, no-cache");
+    request->send(response);
     return;
   }
-
-  if (final) {
-    if (!Update.end(true)) {
-      Update.printError(Serial);
-      updateOk = false;
-    } else {
-      LOG_WIFI("OTA update complete: %u bytes\n", index + len);
-    }
-  }
+  AsyncWebServerResponse *response = request->beginResponse_P(200, asset.type, asset.gz, asset.len);
+  response->addHeader("Content-Encoding", "gzip");
+  response->addHeader("ETag", asset.etag);
+  response->addHeader("Cache-Control", "private, no-cache");
+  request->send(response);
 }
 
-  String WIFI::setLayOutInfo(const char* site, String extra_prop, String value){ 
-    String html = site;
-
-    if (extra_prop != "" && value != "") html.replace(extra_prop, value);
-    
-
-    html.replace("{{LOCATION}}", String(hostname));
-    html.replace("{{VERSION}}", String(VERSION));
-
-    return html;
-  };
-
-
 /* Message callback of WebSerial */
 static void recvMsg(uint8_t *data, size_t len){
   // WebSerial.println("Received Data...");
@@ -76,28 +73,28 @@ void WIFI::init(const char* ssid, const char* password, const char* hostname, co
   // this->static_ip[sizeof(this->static_ip) - 1] = '\0';  // Asegurarse de que esté terminado con '\0'
 }
 
-void WIFI::setUpWebServer(bool brigeSerial){
-  /*use mdns for host name resolution*/
-  while (!MDNS.begin(hostname)){ // http://esp32.local
-    DEBUG("Error setting up MDNS responder!");
-    vTaskDelay(1000 / portTICK_PERIOD_MS);
+// Autenticación básica en todas las rutas
+bool WIFI::checkAuth(AsyncWebServerRequest *request) {
+  if (!request->authenticate(www_username, www_password)) {
+    request->requestAuthentication();
+    return false;
   }
-  
-  DEBUG("mDNS responder started Pinche Hugo");
+  return true;
+}
 
-  // Función para autenticación básica en todas las rutas
-  auto checkAuth = [&](AsyncWebServerRequest *request) {
-    if (!request->authenticate(www_username, www_password)) {
-      request->requestAuthentication();
-      return false;
-    }
-    return true;
-  };
+void WIFI::setUpWebServer(bool brigeSerial){
+  /*use mdns for host name resolution*/
+  // Un intento; si falla, onConnected() lo reintenta (nunca bloquear el arranque)
+  mdnsStarted = MDNS.begin(hostname); // http://esp32.local
+  if (mdnsStarted) DEBUG("mDNS responder started Pinche Hugo");
+  else             DEBUG("Error setting up MDNS responder, retrying on connect");
 
+  // Los handlers viven más que esta función (corre en una task de
+  // Boot que se borra al acabar): capturan solo this, nada del stack
 
   // ======================== Static Files ========================
 
-  // server.on("/style.css", HTTP_GET, [&checkAuth](AsyncWebServerRequest *request){
+  // server.on("/style.css", HTTP_GET, [this](AsyncWebServerRequest *request){
   //   if(!checkAuth(request)) return;
   //   request->send(200, "text/css", STYLE_CSS);
   // });
@@ -107,13 +104,12 @@ void WIFI::setUpWebServer(bool brigeSerial){
 // ======================== Routes ========================
 
     /*return index page which is stored in serverIndex */
-  server.on("/", HTTP_GET, [&](AsyncWebServerRequest *request) {
+  server.on("/", HTTP_GET, [this](AsyncWebServerRequest *request) {
     if(!checkAuth(request)) return;
-    const String doc = setLayOutInfo(SERVER_INDEX_HTML);
-    request->send(200, "text/html", doc);
+    sendAsset(request, INDEX_PAGE);
   });
 
-  server.on("/register_pallet", HTTP_POST, [&](AsyncWebServerRequest *request) {
+  server.on("/register_pallet", HTTP_POST, [this](AsyncWebServerRequest *request) {
     if(!checkAuth(request)) return;
 
     if (!request->hasParam("id", true)) {
@@ -137,18 +133,22 @@ void WIFI::setUpWebServer(bool brigeSerial){
 
   // ======================== Settings ========================
 
-  server.on("/settings", HTTP_GET, [&](AsyncWebServerRequest *request) {
+  server.on("/settings", HTTP_GET, [this](AsyncWebServerRequest *request) {
     if (!checkAuth(request)) return;
-    String html = String(SETTINGS_HTML);
-    html.replace("{{ICE_KG}}",    String(Settings::getTargetIceKg(),   2));
-    html.replace("{{WATER_KG}}",  String(Settings::getTargetWaterKg(), 2));
-    html.replace("{{MIN_WEIGHT}}",String(Settings::getMinWeight(),     2));
-    html.replace("{{LOCATION}}",  String(hostname));
-    html.replace("{{VERSION}}",   String(VERSION));
-    request->send(200, "text/html", html);
+    sendAsset(request, SETTINGS_PAGE);
   });
 
-  server.on("/update_settings", HTTP_POST, [&](AsyncWebServerRequest *request) {
+  // Valores actuales para la página de /settings (estática)
+  server.on("/settings.json", HTTP_GET, [this](AsyncWebServerRequest *request) {
+    if (!checkAuth(request)) return;
+    char json[384];
+    renderSettingsJson(json, sizeof(json), Settings::snapshot(), hostname);
+    AsyncWebServerResponse *response = request->beginResponse(200, "application/json", json);
+    response->addHeader("Cache-Control", "no-store");
+    request->send(response);
+  });
+
+  server.on("/update_settings", HTTP_POST, [this](AsyncWebServerRequest *request) {
     if (!checkAuth(request)) return;
     if (!request->hasParam("ice_kg",   true) ||
         !request->hasParam("water_kg", true) ||
@@ -159,10 +159,124 @@ void WIFI::setUpWebServer(bool brigeSerial){
     const float ice   = request->getParam("ice_kg",   true)->value().toFloat();
     const float water = request->getParam("water_kg", true)->value().toFloat();
     const float minW  = request->getParam("min_w",    true)->value().toFloat();
-    Settings::save(ice, water, minW);
+    // Ice dosing: optional as a whole (older clients only send the targets)
+    const bool hasIce = request->hasParam("ice_cf", true);
+    Dosing::Config dosing = Settings::dosingConfig();
+    if (hasIce) {
+      auto param = [&](const char* name) -> String {
+        return request->hasParam(name, true) ? request->getParam(name, true)->value() : String();
+      };
+      dosing.strategy = param("ice_cf") == "1" ? Dosing::Strategy::COARSE_FINE
+                                               : Dosing::Strategy::SINGLE_SHOT;
+      if (param("fine_kg").length())       dosing.fine_kg       = param("fine_kg").toFloat();
+      if (param("tol_kg").length())        dosing.tol_kg        = param("tol_kg").toFloat();
+      if (param("pulse_max_ms").length())  dosing.pulse_max_ms  = param("pulse_max_ms").toInt();
+      if (param("pulse_min_ms").length())  dosing.pulse_min_ms  = param("pulse_min_ms").toInt();
+      if (param("pulse_wait_ms").length()) dosing.pulse_wait_ms = param("pulse_wait_ms").toInt();
+      if (param("overlap").length())       dosing.overlap       = param("overlap") == "1";
+      // Below 400 ms the ICE_STOP pulse lands before the auger has started
+      if (dosing.fine_kg <= 0 || dosing.tol_kg < 0 || dosing.pulse_min_ms < 400 ||
+          dosing.pulse_max_ms < dosing.pulse_min_ms || dosing.pulse_max_ms > 10000 ||
+          dosing.pulse_wait_ms > 10000) {
+        request->send(400, "text/plain", "Invalid ice dosing parameters");
+        return;
+      }
+    }
+    const bool hasAuto = request->hasParam("auto_start", true);
+    const bool autoStart = hasAuto && request->getParam("auto_start", true)->value() == "1";
+    // One snapshot version for the whole form (Settings.h)
+    Settings::update([&](Settings::Snapshot& s) {
+      s.dosing.ice_kg   = ice;
+      s.dosing.water_kg = water;
+      s.min_w           = minW;
+      if (hasAuto) s.auto_start = autoStart;
+      if (hasIce) {
+        s.dosing.strategy      = dosing.strategy;
+        s.dosing.fine_kg       = dosing.fine_kg;
+        s.dosing.tol_kg        = dosing.tol_kg;
+        s.dosing.pulse_max_ms  = dosing.pulse_max_ms;
+        s.dosing.pulse_min_ms  = dosing.pulse_min_ms;
+        s.dosing.pulse_wait_ms = dosing.pulse_wait_ms;
+        s.dosing.overlap       = dosing.overlap;
+      }
+    });
     request->send(200, "text/plain", "Settings saved successfully.");
   });
 
+  // ======================== Log levels ========================
+
+  server.on("/log_levels", HTTP_GET, [this](AsyncWebServerRequest *request) {
+    if (!checkAuth(request)) return;
+    char json[256];
+    Log::toJson(json, sizeof(json));
+    request->send(200, "application/json", json);
+  });
+
+  server.on("/log_levels", HTTP_POST, [this](AsyncWebServerRequest *request) {
+    if (!checkAuth(request)) return;
+    if (!request->hasParam("module", true) || !request->hasParam("level", true)) {
+      request->send(400, "text/plain", "Missing parameters");
+      return;
+    }
+    const String module = request->getParam("module", true)->value();
+    const long   level  = request->getParam("level",  true)->value().toInt();
+    if (level < 0 || !Log::setLevel(module.c_str(), (uint8_t)level)) {
+      request->send(400, "text/plain", "Invalid module or level");
+      return;
+    }
+    request->send(200, "text/plain", "Log level saved.");
+  });
+
+
+  // ======================== Metrics ========================
+
+  server.on("/metrics", HTTP_GET, [this](AsyncWebServerRequest *request) {
+    if (!checkAuth(request)) return;
+    AsyncResponseStream *response = request->beginResponseStream("text/plain; version=0.0.4");
+    Metrics::render(*response);
+    request->send(response);
+  });
+
+  server.on("/stats", HTTP_GET, [this](AsyncWebServerRequest *request) {
+    if (!checkAuth(request)) return;
+    DynamicJsonDocument doc(STATS_JSON_SIZE);
+    Stats::toJson(doc.to<JsonObject>());
+    AsyncResponseStream *response = request->beginResponseStream("application/json");
+    serializeJson(doc, *response);
+    request->send(response);
+  });
+
+  // Last TRACE_HISTORY tote cycles, open in chrome://tracing or ui.perfetto.dev
+  server.on("/trace.json", HTTP_GET, [this](AsyncWebServerRequest *request) {
+    if (!checkAuth(request)) return;
+    AsyncResponseStream *response = request->beginResponseStream("application/json");
+    Trace::writeChromeJson(*response);
+    request->send(response);
+  });
+
+  // Compressed weight curve, i=0 → latest. Decode: tools/weight_trace.py decode <file>
+  server.on("/weight_trace", HTTP_GET, [this](AsyncWebServerRequest *request) {
+    if (!checkAuth(request)) return;
+    const long i = request->hasParam("i") ? request->getParam("i")->value().toInt() : 0;
+    // A copy: the lane may start a new trace in that slot mid-send
+    uint8_t* buf = (uint8_t*)malloc(WEIGHT_TRACE_BYTES);
+    if (!buf) {
+      request->send(503, "text/plain", "Out of memory");
+      return;
+    }
+    WeightRecorder::View wt;
+    if (i < 0 || !WeightRecorder::get((uint8_t)i, buf, wt)) {
+      free(buf);
+      request->send(404, "text/plain", "No weight trace");
+      return;
+    }
+    AsyncResponseStream *response = request->beginResponseStream("application/octet-stream");
+    response->addHeader("X-Tote-Id", wt.toteId);
+    response->addHeader("X-Samples", String(wt.samples));
+    response->write(wt.data, wt.size);
+    free(buf);
+    request->send(response);
+  });
 
   server.onNotFound([](AsyncWebServerRequest *request) {
       // request->send(SPIFFS, request->url(), String(), false); <------ Buen pishi hack!
@@ -171,32 +285,42 @@ void WIFI::setUpWebServer(bool brigeSerial){
 
   // ======================== SERVER PROCESES ========================
   
-  server.on("/reset", HTTP_POST, [&checkAuth](AsyncWebServerRequest *request) {
+  server.on("/reset", HTTP_POST, [this](AsyncWebServerRequest *request) {
     if(!checkAuth(request)) return;
     request->send(200, "text/plain", "Resetting...");
+    Settings::flush();
     ESP.restart();
   });
 
-  server.on("/update", HTTP_POST, [&checkAuth]( AsyncWebServerRequest *request) {
+  server.on("/update", HTTP_POST, [this](AsyncWebServerRequest *request) {
     if(!checkAuth(request)) return;
-    bool hasError = Update.hasError();
-    AsyncWebServerResponse *response = request->beginResponse(200, "text/plain", hasError ? "FAIL" : "OK");
+    bool hasError = s_ota.failed() || Update.hasError();
+    String msg = hasError ? String("FAIL: ") + s_ota.error()
+                          : "OK " + String(s_ota.bytesOut()) + " bytes" + (s_ota.compressed() ? " (gzip)" : "") +
+                            " in " + String(s_ota.elapsedMs()) + " ms";
+    AsyncWebServerResponse *response = request->beginResponse(200, "text/plain", msg);
     response->addHeader("Connection", "close");
     request->send(response);
     if (!hasError) {
       request->onDisconnect([]() {
         vTaskDelay(200 / portTICK_PERIOD_MS);
+        Settings::flush();
         ESP.restart();
       });
     }
   }, handle_update_progress_cb);
 
+  // Gauge de clientes llevado aquí (task de AsyncTCP): la lista de
+  // clientes de ws no se puede recorrer desde communicationTask
   ws.onEvent([](AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType type,
                 void *arg, uint8_t *data, size_t len) {
+    static int32_t clients = 0;
     if (type == WS_EVT_CONNECT) {
       LOG_WIFI("WebSocket client connected\n");
+      Metrics::set(Metrics::WS_CLIENTS, ++clients);
     } else if (type == WS_EVT_DISCONNECT) {
       LOG_WIFI("WebSocket client disconnected\n");
+      if (clients > 0) Metrics::set(Metrics::WS_CLIENTS, --clients);
     }
   });
 
@@ -211,68 +335,152 @@ String WIFI::getIP(){
 }
 
 void WIFI::connectToWiFi(){
-  // Set static IP if provided
-  
+  WiFi.persistent(false);        // credenciales de config.h: no reescribir el NVS del driver en cada begin()
+  WiFi.setAutoReconnect(false);  // los reintentos los lleva reconnect()
+  WiFi.mode(WIFI_STA);
+  WiFi.onEvent([this](arduino_event_id_t event, arduino_event_info_t) {
+    // Task de eventos de Wi-Fi: solo marcar, loop() hace el resto
+    if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP)            events.fetch_or(EV_GOT_IP);
+    else if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) events.fetch_or(EV_LOST);
+  });
+
+  loadApCache();
+  link = LINK_DOWN;
+  beginAttempt(millis());  // sin esperar: el dosificado arranca offline si hace falta
+}
+
+void WIFI::loop(){
+  if (link == LINK_OFF) return;
+  const uint32_t now = millis();
+  const uint8_t  ev  = events.exchange(0);
+
+  if ((ev & EV_LOST) && link == LINK_UP) {
+    ERROR(LOST_CONNECTION);
+    link      = LINK_DOWN;
+    lostMs    = now;
+    retryAtMs = now;      // primer reintento ya, con la cache
+    failures  = 0;
+    triedFast = false;
+  }
+  if ((ev & EV_GOT_IP) && link != LINK_UP && isConnected()) {
+    onConnected(now);
+  }
+  // Un intento fallido se detecta por timeout: un DISCONNECTED durante
+  // el intento puede ser del anterior, que begin() abortó
+  if (link == LINK_CONNECTING &&
+      now - attemptMs >= (uint32_t)(fast ? WIFI_FAST_TIMEOUT_MS : WIFI_SCAN_TIMEOUT_MS)) {
+    attemptFailed(now);
+  }
+
+  if (otaWanted && !otaStarted && link == LINK_UP) startOTA();
+}
+
+void WIFI::beginAttempt(uint32_t now){
+  fast = apValid && !triedFast;
+  if (fast) triedFast = true;
+  if (everUp) Metrics::inc(Metrics::WIFI_RECONNECTS);
+
   #ifdef HAS_STATIC_IP
   WiFi.config(IP_ADDRESS, GATEWAY_ADDRESS, SUBNET_ADDRESS, IPAddress(8, 8, 8, 8));
+  #else
+  // DHCP también en el intento rápido: la cache solo ahorra el scan
+  WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE);
   #endif
 
   // Si la contraseña está vacía, conectar a red abierta (sin contraseña)
-  if (strlen(password) == 0) {
-    DEBUG("Connecting to open WiFi network (no password)");
-    WiFi.begin(ssid);
+  const char* pass = strlen(password) > 0 ? password : nullptr;
+  if (fast) {
+    LOG_WIFI("Connecting to %s (cached AP, channel %u)...\n", ssid, ap.channel);
+    WiFi.begin(ssid, pass, ap.channel, ap.bssid);
   } else {
-    WiFi.begin(ssid, password);
+    LOG_WIFI("Connecting to %s (scan)...\n", ssid);
+    WiFi.begin(ssid, pass);
   }
-  uint32_t notConnectedCounter = 0;
-  EEPROM.begin(32);
-  while (WiFi.status() != WL_CONNECTED) {
-    vTaskDelay(2000 / portTICK_PERIOD_MS);
-    DEBUG("Wifi connecting...");
-      
-    notConnectedCounter++;
-    if(notConnectedCounter > 7) { // Reset board if not connected after 5s
-      DEBUG("Resetting due to Wifi not connecting...");
-      const uint8_t num_of_tries = EEPROM.readInt(1);
-      if (num_of_tries == 3) break;          
-      else {
-        EEPROM.writeInt(1, num_of_tries + 1);
-        EEPROM.commit();
-        EEPROM.end();
-        ESP.restart();          
-      }
-    }
+  link      = LINK_CONNECTING;
+  attemptMs = now;
+}
+
+void WIFI::attemptFailed(uint32_t now){
+  WiFi.disconnect();  // corta el intento del driver; su DISCONNECTED llega con link DOWN y se ignora
+  link = LINK_DOWN;
+  if (fast) {
+    DEBUG("Cached AP did not answer, scanning");
+    retryAtMs = now;  // enseguida, con scan completo
+    return;
   }
+  if (failures < 5) failures++;
+  const uint32_t backoff = min((uint32_t)WIFI_RETRY_MIN_MS << (failures - 1), (uint32_t)WIFI_RETRY_MAX_MS);
+  retryAtMs = now + backoff;
+  LOG_WIFI("WiFi connect failed, retrying in %lu ms\n", (unsigned long)backoff);
+}
 
-  EEPROM.writeInt(1, 0);
-  EEPROM.commit();
-  EEPROM.end();
+void WIFI::onConnected(uint32_t now){
+  link     = LINK_UP;
+  failures = 0;
+  if (fast) Metrics::inc(Metrics::WIFI_FAST_CONNECTS);
+
+  // Arranque → primera IP, o caída → IP otra vez
+  const uint32_t ms = everUp ? now - lostMs : now;
+  Metrics::observe(everUp ? Metrics::WIFI_RECONNECT_US : Metrics::WIFI_BOOT_CONNECT_US,
+                   ms < UINT32_MAX / 1000 ? ms * 1000 : UINT32_MAX);
+  everUp = true;
+
+  LOG_WIFI("Connected to %s (%s, channel %d) in %lu ms, IP %s\n", WiFi.BSSIDstr().c_str(),
+           fast ? "cached" : "scan", WiFi.channel(), (unsigned long)ms, WiFi.localIP().toString().c_str());
+  saveApCache();
+  if (!mdnsStarted) mdnsStarted = MDNS.begin(hostname);
+}
 
-  DEBUG(("IP address: " + WiFi.localIP().toString()).c_str());
+void WIFI::loadApCache(){
+  Preferences prefs;
+  prefs.begin("tote_cfg", /*readOnly=*/true);
+  apValid = prefs.getBytes("wifi_ap", &ap, sizeof(ap)) == sizeof(ap) &&
+            strncmp(ap.ssid, ssid, sizeof(ap.ssid)) == 0 && ap.channel != 0;
+  prefs.end();
+}
+
+// Solo escribe si algo cambió: reconectar al mismo AP no gasta flash
+void WIFI::saveApCache(){
+  ApCache cur = {};
+  strncpy(cur.ssid, ssid, sizeof(cur.ssid) - 1);
+  memcpy(cur.bssid, WiFi.BSSID(), sizeof(cur.bssid));
+  cur.channel = WiFi.channel();
+  if (apValid && memcmp(&cur, &ap, sizeof(ap)) == 0) return;
+
+  ap      = cur;
+  apValid = true;
+  Preferences prefs;
+  prefs.begin("tote_cfg", /*readOnly=*/false);
+  prefs.putBytes("wifi_ap", &ap, sizeof(ap));
+  prefs.end();
 }
 
 void WIFI::setUpOTA(){
-  if(isConnected()){
-    ArduinoOTA.setHostname(hostname);
-    ArduinoOTA.onStart([]() {
+  otaWanted = true;  // si aún no hay IP, loop() lo arranca al conectar
+  if (isConnected()) startOTA();
+}
+
+void WIFI::startOTA(){
+  otaStarted = true;
+  ArduinoOTA.setHostname(hostname);
+  ArduinoOTA.onStart([]() {
     String type;
     type = ArduinoOTA.getCommand() == U_FLASH ? "sketch" : "filesystem";
-      // NOTE: if updating SPIFFS this would be the place to unmount SPIFFS using SPIFFS.end()
+    // NOTE: if updating SPIFFS this would be the place to unmount SPIFFS using SPIFFS.end()
     logger.println("Start updating " + type);
-    }).onEnd([]() {
-      logger.println("\nEnd");
-    }).onProgress([](unsigned int progress, unsigned int total) {
-      LOG_WIFI("Progress: %u%%\r", (progress / (total / 100)));
-    }).onError([](ota_error_t error) {
-      LOG_ERR("Error[%u]: ", error);
-      if (error == OTA_AUTH_ERROR) logger.println("Auth Failed");
-      else if (error == OTA_BEGIN_ERROR) logger.println("Begin Failed");
-      else if (error == OTA_CONNECT_ERROR) logger.println("Connect Failed");
-      else if (error == OTA_RECEIVE_ERROR) logger.println("Receive Failed");
-      else if (error == OTA_END_ERROR) logger.println("End Failed");
-    });
-    ArduinoOTA.begin();
-  }
+  }).onEnd([]() {
+    logger.println("\nEnd");
+  }).onProgress([](unsigned int progress, unsigned int total) {
+    LOG_WIFI("Progress: %u%%\r", (progress / (total / 100)));
+  }).onError([](ota_error_t error) {
+    LOG_ERR("Error[%u]: ", error);
+    if (error == OTA_AUTH_ERROR) logger.println("Auth Failed");
+    else if (error == OTA_BEGIN_ERROR) logger.println("Begin Failed");
+    else if (error == OTA_CONNECT_ERROR) logger.println("Connect Failed");
+    else if (error == OTA_RECEIVE_ERROR) logger.println("Receive Failed");
+    else if (error == OTA_END_ERROR) logger.println("End Failed");
+  });
+  ArduinoOTA.begin();
 }
 
 void WIFI::loopOTA(){
@@ -297,25 +505,13 @@ bool WIFI::isConnected(){
 }
 
 void WIFI::reconnect(){
-  // Si la contraseña está vacía, conectar a red abierta (sin contraseña)
-  if (strlen(password) == 0) {
-    DEBUG("Reconnecting to open WiFi network (no password)");
-    WiFi.begin(ssid);
-  } else {
-    WiFi.begin(ssid, password);
-  }
-  uint8_t timeout = 0;
-  vTaskDelay(2000 / portTICK_PERIOD_MS);
-  while ( WiFi.status() != WL_CONNECTED ){
-    vTaskDelay(2000 / portTICK_PERIOD_MS);
-    log_i(" waiting on wifi connection" );
-    timeout++;
-    if (timeout == 2) return;
-  }
+  if (link != LINK_DOWN) return;                    // sin arrancar, intentando o conectado
+  if ((int32_t)(millis() - retryAtMs) < 0) return;  // backoff
+  beginAttempt(millis());
 }
 
 void WIFI::DEBUG(const char *message){
-  if (!DEBUG_WIFI) return;
+  if (!LOG_ENABLED(WIFI, LOG_LVL_INFO)) return;
   char buffer[100];
   snprintf(buffer, sizeof(buffer), "[WIFI]: %s", message);
   logger.println(buffer);
@@ -329,6 +525,7 @@ void WIFI::ERROR(ErrorType error){
 
 void WIFI::loopWS(){
   ws.cleanupClients();
+  Metrics::set(Metrics::WIFI_RSSI, isConnected() ? WiFi.RSSI() : 0);
 }
 
 void WIFI::broadcastWeight(float weight){
@@ -1,6 +1,5 @@
 #ifndef MY_WIFI_H
 #define MY_WIFI_H
-#include "EEPROM.h"
 #include <Update.h>
 #include <SPIFFS.h>
 #include "config.h"
@@ -10,12 +9,26 @@
 #include <WiFiClient.h>
 #include <ArduinoOTA.h>
 #include <ArduinoJson.h>
+#include <atomic>
 #include "resources/WebFiles.h"
+#include "resources/WebTemplates.h"
 
 // ERROR MESSAGES
 #define ERR_WRONG_CREDENTIALS "Wrong credentials"
 #define ERR_LOST_CONNECTION "Lost connection"
 
+// ── Connection manager ──────────────────────────────────────────────────────
+// connectToWiFi() y reconnect() solo lanzan intentos; los eventos del
+// driver y los timeouts los resuelve loop() (communicationTask). El
+// setup() y el dosificado nunca esperan a la red.
+// Primer intento de cada caída: BSSID + canal del último AP bueno,
+// guardados en NVS ("wifi_ap"): sin scan de canales. La IP sigue
+// viniendo del DHCP (o la estática). Si falla, scan completo con backoff.
+#define WIFI_FAST_TIMEOUT_MS  3000    // intento con BSSID/canal en cache
+#define WIFI_SCAN_TIMEOUT_MS  10000   // intento con scan completo
+#define WIFI_RETRY_MIN_MS     1000    // backoff tras un scan fallido (x2 por fallo)
+#define WIFI_RETRY_MAX_MS     30000
+
 #define logger Serial
 
 #ifdef WebSerial
@@ -32,10 +45,14 @@ class WIFI {
     void loopOTA();
     String getIP();
     void setUpOTA();
+    /** Next connection attempt when due (backoff); never waits. Call while disconnected. */
     void reconnect();
     bool isConnected();
     
+    /** Starts connecting and returns; loop() finishes the job. */
     void connectToWiFi();
+    /** Wi-Fi events, attempt timeouts, OTA start (communicationTask). */
+    void loop();
     bool refreshWiFiStatus();
     bool getConnectionStatus();
     void setUpWebServer(bool brigeSerial = false);
@@ -67,9 +84,44 @@ class WIFI {
 
     bool (*toteIDCallback)(const String&) = NULL;
     bool last_connection_state = false;
+
+    // ── Connection manager ──────────────────────────────────────
+    enum Link : uint8_t { LINK_OFF, LINK_DOWN, LINK_CONNECTING, LINK_UP };
+    enum : uint8_t { EV_GOT_IP = 1, EV_LOST = 2 };
+
+    // Último AP bueno (NVS "wifi_ap"), válido solo para el mismo SSID.
+    // Sin IP: la dirección sigue siendo del DHCP, que la renueva
+    struct ApCache {
+      char     ssid[SSID_SIZE];
+      uint8_t  bssid[6];
+      uint8_t  channel;
+    };
+
+    void beginAttempt(uint32_t now);
+    void attemptFailed(uint32_t now);
+    void onConnected(uint32_t now);
+    void loadApCache();
+    void saveApCache();
+    void startOTA();
+    bool checkAuth(AsyncWebServerRequest *request);
+
+    std::atomic<uint8_t> events{0};   // EV_* desde la task de eventos de Wi-Fi
+    Link     link        = LINK_OFF;
+    bool     fast        = false;     // intento en curso con BSSID/canal
+    bool     triedFast   = false;     // ya se usó la cache en esta caída
+    bool     everUp      = false;
+    uint8_t  failures    = 0;         // scans fallidos seguidos
+    uint32_t attemptMs   = 0;
+    uint32_t retryAtMs   = 0;
+    uint32_t lostMs      = 0;
+    ApCache  ap          = {};
+    bool     apValid     = false;
+    bool     otaWanted   = false;
+    bool     otaStarted  = false;
+    bool     mdnsStarted = false;
+
     void DEBUG(const char *message);
     void ERROR(ErrorType error);
-    String setLayOutInfo(const char* site, String extra_prop = "", String value = "");
     AsyncWebSocket ws = AsyncWebSocket("/ws");
 
 };
@@ -1,353 +1,367 @@
-const char* INDEX_HTML = R"rawliteral(
-    <!DOCTYPE html>
-    <html lang="es">
-    <head>
-      <meta charset="UTF-8" />
-      <meta name="viewport" content="width=device-width,initial-scale=1.0"/>
-      <title>Revisión de Palet - Loadcell</title>
-      <style>
-        body {
-          margin: 0;
-          padding: 0;
-          font-family: 'Segoe UI', 'Arial', sans-serif;
-          background: #f4f6fa;
-          min-height: 100vh;
-          display: flex;
-        }
-        .sidebar {
-          width: 56px;
-          background: #fff;
-          box-shadow: 2px 0 6px #0001;
-          display: flex;
-          flex-direction: column;
-          align-items: center;
-          padding: 30px 0;
-        }
-        .sidebar .icon {
-          font-size: 2rem;
-          color: #2563eb;
-          margin-bottom: 1rem;
-        }
-        .container {
-          flex: 1;
-          display: flex;
-          align-items: center;
-          justify-content: center;
-        }
-        .card {
-          background: #fff;
-          border-radius: 20px;
-          box-shadow: 0 4px 24px #0001;
-          padding: 2rem 2.5rem 2.5rem 2.5rem;
-          min-width: 320px;
-          max-width: 380px;
-          width: 100%;
-        }
-        .title {
-          font-size: 2rem;
-          color: #1a202c;
-          text-align: center;
-          margin-bottom: 1.5rem;
-          font-weight: 600;
-        }
-        .weight-label {
-          color: #64748b;
-          text-align: center;
-          margin-bottom: 0.5rem;
-          font-size: 1rem;
-        }
-        .weight-value {
-          text-align: center;
-          font-size: 3.5rem;
-          font-weight: bold;
-          color: #2563eb;
-          margin-bottom: 1.5rem;
-          letter-spacing: -2px;
-        }
-        .form-label {
-          color: #1e293b;
-          font-weight: 500;
-          margin-bottom: 0.4rem;
-          display: block;
-        }
-        .input {
-          width: 100%;
-          font-size: 1.15rem;
-          border-radius: 8px;
-          border: 1px solid #d1d5db;
-          padding: 0.6rem 1rem;
-          margin-bottom: 1.2rem;
-          outline: none;
-          box-sizing: border-box;
-          transition: border 0.2s;
-        }
-        .input:focus {
-          border: 1.7px solid #2563eb;
-        }
-        .button {
-          width: 100%;
-          background: #2563eb;
-          color: #fff;
-          border: none;
-          border-radius: 8px;
-          font-size: 1.15rem;
-          font-weight: 600;
-          padding: 0.75rem 0;
-          cursor: pointer;
-          transition: background 0.18s;
-          box-shadow: 0 2px 8px #2563eb22;
-        }
-        .button:active {
-          background: #1740b6;
-        }
-        .status {
-          margin-top: 1rem;
-          padding: 0.7rem 0.5rem;
-          text-align: center;
-          border-radius: 8px;
-          font-weight: 500;
-          font-size: 1.05rem;
-        }
-        .status-success {
-          background: #bbf7d0;
-          color: #166534;
-          border: 1.2px solid #16653444;
-        }
-        .status-error {
-          background: #fecaca;
-          color: #991b1b;
-          border: 1.2px solid #991b1b44;
-        }
-        .socket-bar {
-          position: fixed;
-          bottom: 0;
-          left: 0;
-          width: 100%;
-          text-align: center;
-          padding: 0.5rem 0;
-          font-weight: 500;
-        }
-        .socket-bar.connected {
-          background: #bbf7d0;
-          color: #166534;
-        }
-        .socket-bar.disconnected {
-          background: #fecaca;
-          color: #991b1b;
-        }
-      </style>
-    </head>
-    <body>
-      <div class="sidebar">
-        <div class="icon">⚖️</div>
-        <a href="/settings" style="color:#2563eb;font-size:1.5rem;text-decoration:none;margin-top:0.5rem;" title="Settings">⚙️</a>
-      </div>
-      <div class="container">
-        <div class="card">
-          <div class="title">Ice and Water</div>
-          <div class="weight-label">Actual weight (kg)</div>
-          <div id="weight" class="weight-value">{{WEIGHT}}</div>
-          <form id="palletForm" autocomplete="off">
-            <label class="form-label" for="palletId">Tote ID</label>
-            <input id="palletId" class="input" type="text" required maxlength="32" placeholder="Ex. 124A09" />
-            <button type="submit" class="button">Enter Tote ID</button>
-          </form>
-          <div id="statusMsg"></div>
-          <div id="recentContainer">
-            <div class="weight-label" style="margin-top:1rem;">Last IDs</div>
-            <ul id="recentIds" style="list-style:none;padding-left:0;margin-top:0.5rem;"></ul>
-          </div>
-        </div>
-      </div>
-      <div id="socketStatus" class="socket-bar disconnected">Socket: disconnected</div>
-      <script>
-        // === WebSocket para peso en tiempo real con reconexión ===
-        let ws;
-        let reconnectDelay = 1000;
-        function updateSocketStatus(isConnected) {
-          const el = document.getElementById('socketStatus');
-          if (isConnected) {
-            el.textContent = 'Socket: connected';
-            el.className = 'socket-bar connected';
-          } else {
-            el.textContent = 'Socket: disconnected';
-            el.className = 'socket-bar disconnected';
-          }
-        }
-        function connectWS() {
-          ws = new WebSocket(`ws://${location.host}/ws`);
-          ws.onopen = () => {
-            reconnectDelay = 1000;
-            updateSocketStatus(true);
-          };
-          ws.onmessage = (event) => {
-            document.getElementById('weight').textContent = event.data || '-';
-            console.log("Weight updated:", event.data);
-          };
-          ws.onclose = () => {
-            document.getElementById('weight').textContent = '-';
-            updateSocketStatus(false);
-            setTimeout(connectWS, reconnectDelay);
-            reconnectDelay = Math.min(reconnectDelay * 2, 10000);
-          };
-          ws.onerror = () => {
-            ws.close();
-          };
-        }
-        connectWS();
-    
-        // === Formulario Tote ID ===
-        document.getElementById('palletForm').addEventListener('submit', function(e) {
-          e.preventDefault();
-          const palletId = document.getElementById('palletId').value.trim();
-          const statusMsg = document.getElementById('statusMsg');
-          statusMsg.textContent = '';
-          statusMsg.className = '';
-          fetch('/register_pallet', {
-          method: 'POST',
-            headers: { 'Content-Type': 'application/x-www-form-urlencoded' },
-            body: new URLSearchParams({ id: palletId })
-          })
-          .then(async res => {
-            const text = await res.text();
-            if (!res.ok) throw new Error(text || 'Error registering Tote.');
-            return text || 'Tote registered successfully.';
-          })
-          .then(msg => {
-            statusMsg.textContent = msg;
-            statusMsg.className = 'status status-success';
-            document.getElementById('palletForm').reset();
-            addRecentId(palletId);
-          })
-          .catch(err => {
-            statusMsg.textContent = err.message || 'Error registering Tote.';
-            statusMsg.className = 'status status-error';
-          });
-        });
-
-        const recentIds = [];
-        const maxIds = 5;
-        function addRecentId(id) {
-          recentIds.unshift(id);
-          if (recentIds.length > maxIds) recentIds.pop();
-          const list = document.getElementById('recentIds');
-          list.innerHTML = '';
-          recentIds.forEach(i => {
-            const li = document.createElement('li');
-            li.textContent = i;
-            list.appendChild(li);
-          });
-        }
-      </script>
-    </body>
-    </html>
-    )rawliteral";
-
 // ============================================================
-// Settings page — served at GET /settings
-// Placeholders: {{LOCATION}} {{VERSION}} {{ICE_KG}} {{WATER_KG}} {{MIN_WEIGHT}}
+// WebFiles.cpp  —  GENERATED by tools/web_assets.py, do not edit.
+// Sources: src/hardware/resources/web/. Gzip in flash, see WebFiles.h
 // ============================================================
-const char* SETTINGS_HTML = R"rawliteral(
-    <!DOCTYPE html>
-    <html lang="es">
-    <head>
-      <meta charset="UTF-8" />
-      <meta name="viewport" content="width=device-width,initial-scale=1.0"/>
-      <title>Settings — {{LOCATION}}</title>
-      <style>
-        body {
-          margin: 0; padding: 0;
-          font-family: 'Segoe UI', 'Arial', sans-serif;
-          background: #f4f6fa;
-          min-height: 100vh;
-          display: flex;
-          align-items: center;
-          justify-content: center;
-        }
-        .card {
-          background: #fff;
-          border-radius: 20px;
-          box-shadow: 0 4px 24px #0001;
-          padding: 2rem 2.5rem 2.5rem 2.5rem;
-          min-width: 320px;
-          max-width: 400px;
-          width: 100%;
-        }
-        .title  { font-size: 1.6rem; color: #1a202c; text-align: center; margin-bottom: 0.3rem; font-weight: 600; }
-        .subtitle { color: #64748b; text-align: center; font-size: 0.9rem; margin-bottom: 1.5rem; }
-        .form-label { color: #1e293b; font-weight: 500; margin-bottom: 0.4rem; display: block; }
-        .input {
-          width: 100%; font-size: 1.1rem; border-radius: 8px;
-          border: 1px solid #d1d5db; padding: 0.6rem 1rem;
-          margin-bottom: 1.2rem; outline: none;
-          box-sizing: border-box; transition: border 0.2s;
-        }
-        .input:focus { border: 1.7px solid #2563eb; }
-        .button {
-          width: 100%; background: #2563eb; color: #fff;
-          border: none; border-radius: 8px; font-size: 1.1rem;
-          font-weight: 600; padding: 0.75rem 0; cursor: pointer;
-          transition: background 0.18s; box-shadow: 0 2px 8px #2563eb22;
-        }
-        .button:active { background: #1740b6; }
-        .back-link {
-          display: block; text-align: center; color: #2563eb;
-          text-decoration: none; font-size: 0.95rem; margin-top: 1rem;
-        }
-        .status { margin-top: 1rem; padding: 0.7rem 0.5rem; text-align: center; border-radius: 8px; font-weight: 500; }
-        .status-success { background: #bbf7d0; color: #166534; border: 1.2px solid #16653444; }
-        .status-error   { background: #fecaca; color: #991b1b; border: 1.2px solid #991b1b44; }
-        .hint { color: #94a3b8; font-size: 0.82rem; margin-top: -0.8rem; margin-bottom: 1.2rem; }
-      </style>
-    </head>
-    <body>
-      <div class="card">
-        <div class="title">⚙️ Settings</div>
-        <div class="subtitle">{{LOCATION}} &mdash; v{{VERSION}}</div>
-        <form id="settingsForm" autocomplete="off">
-          <label class="form-label" for="ice_kg">Target Ice (kg)</label>
-          <input id="ice_kg" name="ice_kg" class="input" type="number" step="0.1" min="0" required value="{{ICE_KG}}" />
-          <label class="form-label" for="water_kg">Target Water (kg)</label>
-          <input id="water_kg" name="water_kg" class="input" type="number" step="0.1" min="0" required value="{{WATER_KG}}" />
-          <label class="form-label" for="min_w">Minimum start weight (kg)</label>
-          <input id="min_w" name="min_w" class="input" type="number" step="0.1" min="0" required value="{{MIN_WEIGHT}}" />
-          <p class="hint">Changes take effect immediately and persist after reboot.</p>
-          <button type="submit" class="button">Save Settings</button>
-        </form>
-        <div id="statusMsg"></div>
-        <a class="back-link" href="/">&larr; Back to main page</a>
-      </div>
-      <script>
-        document.getElementById('settingsForm').addEventListener('submit', function(e) {
-          e.preventDefault();
-          const statusMsg = document.getElementById('statusMsg');
-          statusMsg.textContent = '';
-          statusMsg.className = '';
-          const data = new URLSearchParams({
-            ice_kg:   document.getElementById('ice_kg').value,
-            water_kg: document.getElementById('water_kg').value,
-            min_w:    document.getElementById('min_w').value
-          });
-          fetch('/update_settings', {
-            method: 'POST',
-            headers: { 'Content-Type': 'application/x-www-form-urlencoded' },
-            body: data
-          })
-          .then(async res => {
-            const text = await res.text();
-            if (!res.ok) throw new Error(text || 'Error saving settings.');
-            return text;
-          })
-          .then(msg => {
-            statusMsg.textContent = msg;
-            statusMsg.className = 'status status-success';
-          })
-          .catch(err => {
-            statusMsg.textContent = err.message || 'Error saving settings.';
-            statusMsg.className = 'status status-error';
-          });
-        });
-      </script>
-    </body>
-    </html>
-    )rawliteral";
+#include "WebFiles.h"
+
+// index.html: 8108 bytes, 2700 gzip
+static const uint8_t INDEX_PAGE_GZ[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x59, 0xdd, 0x72, 0xdb, 0xb8,
+  0x15, 0xbe, 0xf7, 0x53, 0x60, 0x99, 0x76, 0x48, 0x75, 0x4d, 0x8a, 0x92, 0x7f, 0x62, 0xcb, 0x92,
+  0x3a, 0xd9, 0xc4, 0xd9, 0x7a, 0x26, 0xe9, 0x7a, 0x62, 0x67, 0x32, 0x9d, 0x4c, 0x26, 0x0b, 0x91,
+  0xa0, 0x84, 0x84, 0x24, 0x58, 0x02, 0xb4, 0xe4, 0xcd, 0xfa, 0x19, 0x7a, 0xd7, 0x99, 0xf6, 0x1d,
+  0x7a, 0xd5, 0x9b, 0xde, 0xef, 0x9b, 0xf4, 0x05, 0xfa, 0x0a, 0x3d, 0x00, 0xf8, 0x03, 0x52, 0x94,
+  0xd6, 0xe9, 0x34, 0x17, 0xb1, 0x0c, 0xe0, 0xfc, 0x9f, 0xf3, 0x9d, 0x73, 0xe4, 0xe9, 0x37, 0x2f,
+  0x7e, 0x78, 0x7e, 0xfb, 0xa7, 0xeb, 0x4b, 0xb4, 0x12, 0x49, 0x3c, 0x3f, 0x98, 0xca, 0x1f, 0x28,
+  0xc6, 0xe9, 0x72, 0x66, 0x11, 0x6e, 0xc9, 0x03, 0x82, 0xc3, 0xf9, 0x01, 0x42, 0xd3, 0x84, 0x08,
+  0x8c, 0x82, 0x15, 0xce, 0x39, 0x11, 0x33, 0xeb, 0xed, 0xed, 0x4b, 0xf7, 0xcc, 0x42, 0xc3, 0xe6,
+  0x2a, 0xc5, 0x09, 0x99, 0x59, 0x77, 0x94, 0xac, 0x33, 0x96, 0x0b, 0x0b, 0x05, 0x2c, 0x15, 0x24,
+  0x85, 0xa7, 0x6b, 0x1a, 0x8a, 0xd5, 0x2c, 0x24, 0x77, 0x34, 0x20, 0xae, 0xfa, 0xe5, 0x90, 0xa6,
+  0x54, 0x50, 0x1c, 0xbb, 0x3c, 0xc0, 0x31, 0x99, 0x8d, 0x3c, 0xdf, 0xd2, 0x8c, 0x04, 0x15, 0x31,
+  0x99, 0xbf, 0x81, 0xa7, 0x9c, 0xfe, 0xf2, 0xcf, 0x14, 0x85, 0x04, 0x5d, 0xc3, 0x0b, 0x81, 0x5c,
+  0xf4, 0x8a, 0xe1, 0x30, 0x20, 0x71, 0x3c, 0x1d, 0xea, 0x47, 0xf2, 0x39, 0x17, 0xf7, 0xfa, 0x13,
+  0x42, 0x0b, 0x16, 0xde, 0xa3, 0x2f, 0xea, 0x23, 0x42, 0x09, 0xce, 0x97, 0x34, 0x9d, 0x20, 0xff,
+  0xa2, 0x3c, 0xc8, 0x70, 0x18, 0xd2, 0x74, 0x69, 0x9c, 0x44, 0xa0, 0x9d, 0x1b, 0xe1, 0x84, 0xc6,
+  0xf7, 0x13, 0x64, 0xdf, 0x90, 0x25, 0x23, 0xe8, 0xed, 0x95, 0x7d, 0x88, 0xec, 0x67, 0x39, 0x68,
+  0x06, 0x1f, 0x38, 0x4e, 0xb9, 0xcb, 0x49, 0x4e, 0xa3, 0x8a, 0x66, 0x81, 0x83, 0xcf, 0xcb, 0x9c,
+  0x15, 0x69, 0x38, 0x41, 0x4f, 0xa2, 0xe3, 0xe8, 0x34, 0xc2, 0xd5, 0x55, 0x42, 0x53, 0x77, 0x45,
+  0xe8, 0x72, 0x25, 0x26, 0x68, 0xe4, 0xfb, 0x77, 0xab, 0xea, 0x22, 0xa4, 0x3c, 0x8b, 0x31, 0xc8,
+  0x88, 0x62, 0xb2, 0xd1, 0x87, 0x0f, 0xea, 0x7f, 0x8f, 0xd3, 0x90, 0x2c, 0x70, 0x5e, 0x2b, 0xad,
+  0x3c, 0x33, 0x41, 0x27, 0xa7, 0xd9, 0xa6, 0x5f, 0x60, 0xd4, 0x28, 0xc2, 0x36, 0x2e, 0x5f, 0xe1,
+  0x90, 0xad, 0x27, 0x68, 0x9c, 0x6d, 0x90, 0x8f, 0x80, 0x08, 0x3d, 0xf1, 0x7d, 0x7f, 0xb4, 0x47,
+  0x2e, 0x52, 0x9f, 0xdd, 0x90, 0xe6, 0x24, 0x10, 0x94, 0x81, 0x7f, 0x02, 0x16, 0x17, 0x49, 0x5a,
+  0xdd, 0xe2, 0x98, 0x2e, 0x53, 0x97, 0x0a, 0x92, 0x70, 0xb8, 0x82, 0xd0, 0x91, 0x7c, 0xcb, 0x7f,
+  0x47, 0xbe, 0x14, 0xd7, 0x6b, 0x87, 0x47, 0x21, 0xe2, 0xb5, 0x35, 0xca, 0xbf, 0x9c, 0xfe, 0x44,
+  0x40, 0xc3, 0x9c, 0x24, 0x15, 0x23, 0x90, 0xc8, 0x72, 0x30, 0x66, 0x7c, 0x72, 0x7a, 0x44, 0x16,
+  0x17, 0xad, 0x78, 0xb9, 0x0b, 0x26, 0x04, 0x4b, 0xc0, 0x81, 0x35, 0x41, 0x29, 0x42, 0xa6, 0x12,
+  0xa6, 0x29, 0x69, 0x9c, 0x25, 0x2d, 0x81, 0x87, 0x7b, 0xad, 0xdd, 0x63, 0xcf, 0xa7, 0x82, 0x0b,
+  0x1a, 0xdd, 0xbb, 0x65, 0x8e, 0xb6, 0xaf, 0x2b, 0xa1, 0x38, 0x0f, 0x6b, 0x79, 0xbb, 0x23, 0x91,
+  0x87, 0x24, 0x77, 0x73, 0x1c, 0xd2, 0x02, 0xa4, 0x8c, 0x7d, 0x23, 0x78, 0x46, 0x90, 0x7c, 0x74,
+  0x0c, 0x7e, 0x1b, 0x1f, 0x77, 0xa3, 0x54, 0xfb, 0x55, 0xfa, 0x08, 0x8d, 0xbd, 0x93, 0xad, 0x1f,
+  0x66, 0x82, 0x95, 0x19, 0x72, 0x64, 0x4a, 0x49, 0xf0, 0xa6, 0x3e, 0x3f, 0x33, 0xce, 0xcb, 0x33,
+  0xc8, 0xc5, 0xdf, 0xb6, 0xac, 0x52, 0xc5, 0xf3, 0xd8, 0x28, 0x8d, 0xf0, 0xd8, 0x1f, 0x07, 0xd5,
+  0xa9, 0x20, 0x1b, 0xe1, 0x2a, 0xa7, 0x76, 0xdd, 0xd9, 0x8d, 0x5f, 0x4b, 0x73, 0x25, 0x63, 0x5d,
+  0xd6, 0xc6, 0xa9, 0xdf, 0x4e, 0x1e, 0x7d, 0xee, 0xc6, 0x78, 0x41, 0xe2, 0x5a, 0xab, 0x4a, 0xfc,
+  0xe9, 0xf1, 0xd3, 0xe3, 0xb3, 0xc5, 0x57, 0x8b, 0xf7, 0xb7, 0xc5, 0x6b, 0x13, 0xb7, 0xf2, 0xaa,
+  0x94, 0x7e, 0x87, 0xe3, 0xa2, 0xf1, 0xc9, 0x6e, 0x39, 0x06, 0xab, 0xa3, 0xdd, 0x26, 0x2e, 0x58,
+  0x1c, 0x7e, 0x5d, 0xba, 0xb7, 0x78, 0x01, 0xda, 0x81, 0x48, 0x97, 0x67, 0x38, 0x50, 0x99, 0xe1,
+  0x8e, 0xb3, 0x36, 0x6e, 0x44, 0x2c, 0x4f, 0x76, 0x38, 0x6c, 0x44, 0xc6, 0xe7, 0x47, 0x8b, 0x5e,
+  0xad, 0x4e, 0x7c, 0x7f, 0xa7, 0xbb, 0x8e, 0x0d, 0xf1, 0x75, 0x25, 0x2d, 0x62, 0x16, 0x7c, 0x6e,
+  0x09, 0xa6, 0x69, 0x56, 0x88, 0x2e, 0x5c, 0x35, 0x09, 0xd6, 0x76, 0xb5, 0x37, 0x32, 0x8d, 0xea,
+  0x94, 0xc9, 0x99, 0x59, 0x25, 0xf2, 0x06, 0x08, 0xa0, 0x34, 0x38, 0x8b, 0x69, 0x88, 0x9e, 0x84,
+  0xa3, 0xf0, 0x24, 0x5c, 0x6c, 0x43, 0xb7, 0x77, 0x2a, 0xcb, 0x62, 0x64, 0x16, 0x45, 0xd7, 0x91,
+  0x66, 0x12, 0xb3, 0x42, 0xc4, 0x80, 0x19, 0x13, 0x94, 0xb2, 0x94, 0xb4, 0x8a, 0x92, 0xfe, 0xa4,
+  0x18, 0x96, 0x4a, 0xc1, 0x51, 0x9d, 0x62, 0x39, 0x60, 0x3e, 0xd5, 0xd8, 0xa8, 0x6f, 0x41, 0xea,
+  0x98, 0x6f, 0x7b, 0x61, 0x12, 0xb1, 0xa0, 0xe0, 0x0d, 0x3a, 0x54, 0x46, 0x78, 0x4f, 0x1b, 0x33,
+  0xcc, 0x98, 0x97, 0xb4, 0x8b, 0x02, 0x14, 0x4d, 0xf7, 0xb9, 0xb0, 0x85, 0x33, 0xed, 0xac, 0xa9,
+  0x82, 0xbc, 0x85, 0x3e, 0x5d, 0x0b, 0x77, 0xb9, 0x7a, 0x77, 0x78, 0xfa, 0x4b, 0xb4, 0xe5, 0xfb,
+  0xa7, 0x0a, 0x93, 0xea, 0x9b, 0xa0, 0xc8, 0xb9, 0xd4, 0x26, 0x63, 0xd4, 0xac, 0x90, 0x96, 0x03,
+  0x6b, 0x53, 0x80, 0x7c, 0x74, 0xc6, 0xfb, 0x71, 0x51, 0xb6, 0xaf, 0x33, 0x09, 0x8b, 0xda, 0xd8,
+  0xf1, 0xb8, 0xc7, 0x61, 0x13, 0x0c, 0xfd, 0xea, 0x8e, 0xf4, 0x83, 0xf1, 0xe8, 0xe9, 0xb1, 0xbf,
+  0x38, 0x6d, 0x77, 0x24, 0x81, 0x85, 0x11, 0x9d, 0x32, 0x4b, 0x04, 0xcb, 0x26, 0xad, 0xec, 0x31,
+  0xad, 0x53, 0xc6, 0xb5, 0xea, 0x70, 0x37, 0x0c, 0xfc, 0x8a, 0x87, 0x7b, 0x2a, 0xae, 0xe5, 0x79,
+  0xff, 0xa4, 0x0b, 0x43, 0x5a, 0x5f, 0x97, 0x17, 0x41, 0x40, 0x38, 0xef, 0x37, 0x73, 0xb1, 0x88,
+  0x9e, 0x86, 0xfe, 0x16, 0x40, 0x9f, 0x9e, 0x9e, 0x1c, 0x1d, 0x6f, 0xd5, 0x92, 0x37, 0x6e, 0xd2,
+  0x50, 0x3f, 0x39, 0x3e, 0xee, 0x93, 0x48, 0xf2, 0x9c, 0xe5, 0x3b, 0x7a, 0x1c, 0x09, 0x70, 0x80,
+  0xbb, 0xf2, 0xce, 0xcf, 0x47, 0x8b, 0xd1, 0x62, 0xaf, 0x3c, 0xfd, 0xa4, 0x2b, 0x0f, 0xb0, 0x84,
+  0x08, 0xd7, 0x1c, 0x77, 0x32, 0x56, 0x25, 0x4a, 0x44, 0x37, 0x24, 0x6c, 0x78, 0x96, 0xa8, 0xd4,
+  0xe0, 0x61, 0x24, 0x8c, 0x5f, 0x7b, 0x6a, 0x66, 0x77, 0xa4, 0x8c, 0x08, 0xb7, 0xd3, 0xb7, 0x3f,
+  0x50, 0x5b, 0xca, 0xca, 0xc1, 0x23, 0x85, 0x61, 0x89, 0x84, 0xff, 0x6b, 0x50, 0xb6, 0x59, 0x02,
+  0xc0, 0xfe, 0x0a, 0xd7, 0x5f, 0x77, 0xbd, 0xe4, 0x3a, 0x1d, 0x96, 0xd3, 0xef, 0x74, 0xa8, 0x47,
+  0xf4, 0xa9, 0x1c, 0x81, 0xd5, 0x58, 0x1c, 0xd2, 0x3b, 0x14, 0xc4, 0x98, 0xf3, 0x99, 0x55, 0x0e,
+  0x67, 0x96, 0x1e, 0x92, 0xcd, 0x1b, 0x39, 0xad, 0x59, 0xf3, 0x7f, 0xff, 0xfd, 0xaf, 0xff, 0xf9,
+  0xd7, 0x5f, 0xa6, 0x43, 0xb8, 0x28, 0x9f, 0x60, 0xb4, 0xca, 0x49, 0x34, 0xb3, 0x86, 0x30, 0xe6,
+  0x0b, 0x70, 0x1e, 0xb7, 0x90, 0x12, 0x34, 0xb3, 0xb4, 0x26, 0x15, 0x2a, 0x35, 0x39, 0x5d, 0xf6,
+  0x2f, 0x15, 0x86, 0x90, 0x04, 0x2c, 0xc7, 0x2a, 0xae, 0x0a, 0x94, 0x8c, 0xda, 0x2b, 0xcb, 0xcb,
+  0x42, 0x6a, 0x04, 0x99, 0x59, 0x37, 0x15, 0x7f, 0x50, 0xe2, 0x6f, 0x4a, 0x09, 0xac, 0xb4, 0xaf,
+  0x74, 0x31, 0x95, 0xad, 0x07, 0xc0, 0x1e, 0x43, 0xe4, 0x9c, 0x56, 0x1e, 0xb7, 0x2f, 0x94, 0x1c,
+  0x6b, 0x7e, 0x15, 0x10, 0x84, 0x01, 0x84, 0xde, 0x61, 0xc8, 0x0c, 0xc3, 0xd2, 0xf6, 0x63, 0x73,
+  0x10, 0xb1, 0xe6, 0xcf, 0x02, 0x51, 0xe0, 0x18, 0xe9, 0x43, 0xe4, 0x7c, 0x5e, 0x0e, 0xb6, 0x09,
+  0x69, 0x58, 0x51, 0x59, 0x1d, 0x26, 0x6a, 0x9e, 0xb0, 0xe6, 0x6e, 0x9b, 0x46, 0xf6, 0x6d, 0x45,
+  0x94, 0xe1, 0x18, 0x9a, 0xfc, 0x4b, 0xf8, 0xd5, 0x42, 0xb8, 0x10, 0x2c, 0x60, 0x49, 0x06, 0x07,
+  0xe0, 0x12, 0x16, 0x45, 0xb5, 0x25, 0x40, 0xa1, 0x9b, 0x7c, 0xc9, 0xbb, 0x69, 0xfb, 0x16, 0xa4,
+  0x6f, 0x5e, 0xb1, 0xb9, 0x02, 0xdb, 0x6f, 0x99, 0x20, 0xe8, 0xea, 0xc5, 0x74, 0xa8, 0xae, 0x0d,
+  0x06, 0xba, 0x63, 0x37, 0x32, 0xe1, 0x71, 0x1d, 0x7e, 0x79, 0x05, 0xb1, 0xb8, 0xcf, 0x40, 0xae,
+  0x0c, 0x9d, 0x85, 0x72, 0xf2, 0xe7, 0x02, 0x76, 0x83, 0x50, 0xce, 0x94, 0x31, 0x49, 0x97, 0xb0,
+  0xb4, 0x59, 0x47, 0x63, 0x0b, 0xc1, 0x3c, 0x10, 0x90, 0x15, 0x4c, 0x35, 0x04, 0xa4, 0x5e, 0x6e,
+  0x3c, 0x34, 0x1a, 0x1f, 0x3f, 0xf3, 0xcf, 0xcb, 0xe5, 0xaf, 0x14, 0x55, 0xb6, 0x36, 0xcd, 0x8f,
+  0x17, 0x8b, 0x84, 0x36, 0x6e, 0xd1, 0x77, 0xd6, 0xfc, 0x52, 0xd6, 0x26, 0xaa, 0xb5, 0xd5, 0xc7,
+  0xb5, 0x7f, 0x86, 0xd2, 0xc2, 0x2d, 0x0f, 0x6b, 0xa4, 0x7a, 0xcd, 0x97, 0xd6, 0xbc, 0x3f, 0x04,
+  0xb0, 0xcc, 0x40, 0xcd, 0x3f, 0xef, 0x24, 0xc8, 0xde, 0xf0, 0x56, 0x09, 0x6d, 0x24, 0xa7, 0xea,
+  0x0b, 0xd6, 0xfc, 0x15, 0xe6, 0x02, 0x74, 0xe3, 0x2d, 0x51, 0xc0, 0xa9, 0x88, 0x0d, 0x59, 0x57,
+  0x61, 0x53, 0x13, 0x31, 0xe5, 0x50, 0x05, 0xf2, 0xb3, 0xce, 0xf7, 0x12, 0x71, 0x5c, 0x85, 0x5a,
+  0x7e, 0x5f, 0xfa, 0x83, 0x19, 0x45, 0xdc, 0x18, 0xdd, 0x67, 0x92, 0xb4, 0x99, 0xff, 0x9f, 0x2c,
+  0xba, 0xce, 0x59, 0x58, 0xa8, 0x75, 0xaf, 0x6b, 0x93, 0xc0, 0x0b, 0xd8, 0x04, 0x6a, 0x79, 0x35,
+  0x0f, 0x8d, 0xb0, 0x0a, 0x60, 0x9b, 0x1a, 0xf7, 0xbd, 0x73, 0xa5, 0x7e, 0x89, 0x01, 0xe5, 0xa0,
+  0x29, 0x8d, 0x51, 0x6c, 0x7a, 0xec, 0x69, 0xea, 0xb8, 0x55, 0xd0, 0x4a, 0x9e, 0x42, 0xc3, 0x1b,
+  0x15, 0xd9, 0x3a, 0x49, 0x8c, 0x16, 0x61, 0x42, 0xa4, 0x35, 0xbf, 0x51, 0x17, 0x93, 0xd6, 0x69,
+  0xc3, 0x93, 0x07, 0x39, 0xcd, 0x84, 0x16, 0x39, 0x1c, 0xa2, 0xd9, 0x6c, 0x86, 0xde, 0x91, 0x85,
+  0xa6, 0x01, 0xfc, 0xcf, 0x31, 0xca, 0x08, 0x67, 0x88, 0x40, 0x6a, 0x52, 0x92, 0x64, 0x0c, 0xb2,
+  0x1c, 0x0a, 0x5b, 0x6e, 0xaa, 0x10, 0x4c, 0x88, 0xd8, 0x46, 0x7d, 0xcf, 0x00, 0x64, 0x07, 0xe5,
+  0xf0, 0x8d, 0xd6, 0xe5, 0xa4, 0x22, 0x3f, 0xab, 0x37, 0x52, 0xe4, 0x0b, 0x02, 0x43, 0x31, 0x9a,
+  0xc9, 0xbe, 0x53, 0xe2, 0x7d, 0x54, 0xa4, 0xca, 0xad, 0xa8, 0xc8, 0x42, 0x40, 0x96, 0x1b, 0xc3,
+  0x26, 0x87, 0xca, 0xe8, 0x69, 0x4d, 0x07, 0xc6, 0x90, 0x9e, 0x42, 0x72, 0x41, 0x41, 0xcf, 0x50,
+  0x08, 0xd3, 0x63, 0x02, 0x99, 0xe4, 0x2d, 0x89, 0xb8, 0x8c, 0x89, 0xfc, 0xf8, 0xdd, 0xfd, 0x55,
+  0xe8, 0xd8, 0xa6, 0x67, 0xec, 0x41, 0xd5, 0x02, 0x68, 0x84, 0xfa, 0x59, 0x22, 0x60, 0xe7, 0xc9,
+  0xe2, 0x7d, 0xae, 0xf7, 0x58, 0x60, 0x6d, 0x57, 0xee, 0xaa, 0x7d, 0x65, 0x5f, 0x98, 0xaf, 0x95,
+  0xb7, 0xff, 0x88, 0x13, 0x22, 0xdf, 0x1a, 0x3e, 0xdf, 0x7e, 0xfe, 0x00, 0xcf, 0x39, 0x79, 0x94,
+  0x2c, 0x33, 0x34, 0x8f, 0x13, 0xd7, 0x4b, 0xf1, 0x60, 0xb4, 0xcc, 0xda, 0xbd, 0xe5, 0xb3, 0x77,
+  0x37, 0x4e, 0x63, 0xf7, 0x9a, 0x03, 0xbb, 0x94, 0xac, 0x9b, 0x50, 0x3b, 0x3f, 0xae, 0xf9, 0x64,
+  0x38, 0xfc, 0xcd, 0x17, 0xd8, 0x5a, 0x54, 0xfb, 0xf1, 0x56, 0x8c, 0x8b, 0x87, 0xe1, 0x9a, 0xff,
+  0x58, 0xbb, 0x71, 0xcd, 0x3d, 0x96, 0xb2, 0x0c, 0x52, 0x61, 0x86, 0x80, 0xd9, 0x6c, 0x6e, 0xd8,
+  0xb6, 0x27, 0xd0, 0xf2, 0x5f, 0x4f, 0x8c, 0x45, 0x5e, 0x90, 0x9a, 0xf5, 0x43, 0x4b, 0x46, 0x02,
+  0x53, 0x1c, 0x5e, 0x4a, 0x93, 0x1d, 0x72, 0x07, 0xae, 0xea, 0xc8, 0xda, 0x19, 0x7d, 0x5d, 0xd2,
+  0xf6, 0xa0, 0xe3, 0x66, 0xc5, 0xc3, 0x03, 0x05, 0x30, 0xfa, 0xf9, 0x67, 0x64, 0xbb, 0x86, 0x87,
+  0x65, 0x4e, 0xb1, 0x98, 0x78, 0x31, 0x5b, 0x3a, 0xd6, 0x3b, 0xdd, 0xad, 0xb4, 0xae, 0xe1, 0xc4,
+  0x3a, 0x34, 0x28, 0x77, 0x68, 0x1a, 0xc4, 0x8c, 0x93, 0x1e, 0x77, 0x7c, 0xad, 0x8a, 0x2d, 0xa5,
+  0x7a, 0x9c, 0x15, 0x61, 0x48, 0xa5, 0x41, 0xf3, 0x04, 0x66, 0x8b, 0x5b, 0x9a, 0x10, 0x58, 0xd1,
+  0x9c, 0x3a, 0xbe, 0x87, 0x9d, 0x20, 0x18, 0xcf, 0xb7, 0xa2, 0xf3, 0x1a, 0x8b, 0x95, 0x97, 0xd0,
+  0xd4, 0xe9, 0xdc, 0xfc, 0x0e, 0x8d, 0x0f, 0x55, 0xe8, 0xfc, 0x1d, 0x06, 0xeb, 0x89, 0x77, 0xdb,
+  0x60, 0xb8, 0x54, 0xbe, 0x70, 0xba, 0x74, 0x3a, 0x1b, 0x8d, 0x24, 0xbc, 0x38, 0x30, 0xb1, 0x46,
+  0x76, 0xf1, 0x22, 0xc6, 0x39, 0x65, 0x55, 0x5f, 0xab, 0xb1, 0x64, 0xa7, 0x0f, 0x9b, 0xfe, 0x0f,
+  0x7e, 0x84, 0x7e, 0x71, 0x29, 0xa3, 0xf4, 0x0a, 0x1a, 0x09, 0x01, 0xf5, 0x00, 0x03, 0x54, 0xf3,
+  0xb4, 0x0f, 0xeb, 0x12, 0x70, 0x48, 0x93, 0xf9, 0xc4, 0xcb, 0x72, 0x15, 0xd5, 0x17, 0x24, 0xc2,
+  0x45, 0x2c, 0x1a, 0x7d, 0x35, 0xbc, 0x54, 0x7d, 0x7e, 0x1f, 0xc8, 0x54, 0x6f, 0x40, 0xba, 0x9a,
+  0x54, 0x3c, 0x91, 0xd3, 0xa4, 0xcb, 0xa8, 0xee, 0xbb, 0x7b, 0xe1, 0xaa, 0x7a, 0xd4, 0x60, 0x55,
+  0x7d, 0xd4, 0xcd, 0x10, 0x7b, 0xfb, 0x45, 0x0b, 0x1c, 0xea, 0xfb, 0x88, 0x88, 0x60, 0xe5, 0xd8,
+  0xc3, 0x9c, 0x2c, 0xa5, 0x4f, 0xf2, 0x8f, 0x5a, 0x5f, 0x70, 0x48, 0xbd, 0xd0, 0x11, 0xb1, 0x62,
+  0x30, 0x29, 0xdb, 0xd7, 0x3f, 0xdc, 0xdc, 0xda, 0x87, 0x75, 0x10, 0xe5, 0x1c, 0x4c, 0x72, 0x58,
+  0xc9, 0xbe, 0x20, 0xbb, 0x94, 0xec, 0xde, 0xc2, 0x40, 0x62, 0xc3, 0x53, 0x9c, 0x65, 0x31, 0xd5,
+  0xd0, 0x30, 0xdc, 0xb8, 0xeb, 0xf5, 0xda, 0x55, 0x03, 0x55, 0x91, 0xc3, 0xa4, 0x13, 0xb0, 0x10,
+  0x50, 0x08, 0x3d, 0x34, 0x9c, 0xe4, 0x28, 0x3d, 0x51, 0x08, 0xf3, 0xf6, 0xcd, 0xab, 0x1b, 0x82,
+  0xf3, 0x60, 0x75, 0x0d, 0xbd, 0x24, 0xe1, 0xce, 0x17, 0xe8, 0x60, 0x93, 0xc6, 0xcd, 0x0f, 0x83,
+  0x2a, 0x5d, 0xaa, 0x0f, 0x9e, 0x58, 0x91, 0xd4, 0xc1, 0xfc, 0x3e, 0x0d, 0x20, 0x6f, 0x79, 0x3b,
+  0xcd, 0xb4, 0x6f, 0xa5, 0x67, 0xc0, 0x64, 0xbc, 0xc6, 0x54, 0xb6, 0x18, 0xae, 0x5c, 0xe5, 0x18,
+  0xf9, 0x2e, 0x01, 0xff, 0x1b, 0x79, 0xc1, 0x3e, 0x0f, 0x90, 0x58, 0xe5, 0x6c, 0xad, 0x74, 0xb9,
+  0x94, 0xc9, 0xeb, 0x28, 0x6a, 0x09, 0x04, 0xea, 0x57, 0x54, 0xb9, 0x09, 0xa6, 0x0e, 0x95, 0x82,
+  0x9e, 0xdd, 0x2a, 0x1c, 0x51, 0xe4, 0x29, 0xaa, 0x49, 0x54, 0x8e, 0x56, 0x14, 0x30, 0xe9, 0x95,
+  0x2b, 0x67, 0x54, 0xc4, 0xf1, 0xbd, 0xd7, 0xe0, 0x70, 0xdb, 0x96, 0x44, 0x26, 0x81, 0x69, 0xc5,
+  0xae, 0x18, 0xc3, 0xc3, 0x8b, 0x9e, 0x47, 0xed, 0x1e, 0xa0, 0x77, 0xf3, 0xf6, 0xca, 0x6b, 0x80,
+  0xc7, 0xe3, 0xaa, 0x06, 0x7c, 0x43, 0x5a, 0x1e, 0x83, 0x32, 0x7a, 0x53, 0x0e, 0x67, 0x4e, 0x15,
+  0x9c, 0xc1, 0xb6, 0x3d, 0x90, 0x00, 0x90, 0x5b, 0x00, 0x02, 0x8f, 0x33, 0x08, 0x1e, 0x7a, 0x15,
+  0x98, 0xef, 0xf3, 0xf8, 0x57, 0x5a, 0xad, 0x40, 0xc8, 0xf0, 0x76, 0x89, 0x34, 0x1d, 0x68, 0xb9,
+  0x84, 0xd7, 0xe1, 0x2f, 0xff, 0xe0, 0x02, 0xd2, 0x96, 0xcb, 0xbf, 0x84, 0x64, 0x6a, 0x94, 0x0b,
+  0xd4, 0xc0, 0xe2, 0x7c, 0x7f, 0x79, 0x8b, 0x86, 0x6a, 0x70, 0x1b, 0xd4, 0x88, 0x53, 0xf7, 0xcc,
+  0x28, 0x11, 0x37, 0x10, 0x36, 0x80, 0x8d, 0x2a, 0x03, 0xe0, 0x37, 0x34, 0x54, 0xc8, 0x08, 0xd0,
+  0xcd, 0x5e, 0xca, 0x8d, 0xdb, 0x19, 0x0d, 0xd0, 0xb7, 0xc8, 0x46, 0xe0, 0xfd, 0x6e, 0xcf, 0x05,
+  0xfa, 0xef, 0x9d, 0xe5, 0x00, 0x19, 0xf4, 0x4b, 0x34, 0x47, 0x3e, 0xfa, 0x3d, 0xb2, 0xbf, 0xb5,
+  0x11, 0x94, 0x93, 0x2d, 0x69, 0x97, 0x8a, 0x7e, 0xb9, 0x4d, 0x0f, 0x0b, 0x24, 0x44, 0x68, 0x25,
+  0xc1, 0x9f, 0x1b, 0x6d, 0xbb, 0xaa, 0x6c, 0xa5, 0xb6, 0xec, 0x21, 0x32, 0xbb, 0x54, 0x28, 0x72,
+  0xef, 0x13, 0x07, 0xa0, 0x1b, 0x94, 0x67, 0xbd, 0x55, 0xc3, 0x65, 0x44, 0xb8, 0xfc, 0xea, 0x62,
+  0x49, 0xf8, 0xc7, 0x84, 0x1f, 0x22, 0x76, 0xa7, 0x4e, 0xd8, 0x1d, 0x14, 0xfd, 0x8a, 0x31, 0xf1,
+  0x71, 0x79, 0xd1, 0xa1, 0x81, 0xca, 0x91, 0xa3, 0xc2, 0xfb, 0xfa, 0x18, 0xa1, 0xf7, 0xaa, 0x08,
+  0xa4, 0x37, 0x56, 0xac, 0xc8, 0x01, 0x55, 0xaa, 0xc8, 0x81, 0x5f, 0xe0, 0xfc, 0x63, 0x06, 0x88,
+  0x23, 0x6f, 0x94, 0x6d, 0x8e, 0x0d, 0x3f, 0xaa, 0x1b, 0xf8, 0x1f, 0x46, 0x47, 0x79, 0xac, 0x3e,
+  0x0d, 0xec, 0x0f, 0x87, 0x2d, 0xbe, 0xcf, 0xef, 0x03, 0x18, 0xa8, 0xb3, 0x13, 0x1f, 0x78, 0x67,
+  0xe7, 0x7e, 0xc9, 0x5a, 0xc5, 0x82, 0x0b, 0x2f, 0x90, 0xb7, 0x1e, 0xdc, 0x6a, 0xaf, 0x0f, 0x91,
+  0x64, 0xdd, 0xb9, 0x3c, 0xf7, 0x07, 0x1d, 0x9e, 0x6a, 0x69, 0x95, 0x3c, 0x1b, 0x45, 0x0d, 0x9e,
+  0x6b, 0x79, 0xab, 0x78, 0x76, 0xc8, 0xe4, 0xce, 0xdb, 0x25, 0x6a, 0xc8, 0x68, 0x40, 0x7a, 0x89,
+  0x5e, 0x20, 0x85, 0x48, 0x6d, 0xc2, 0x9a, 0x28, 0xfc, 0x28, 0x6f, 0xfb, 0x08, 0xb5, 0x92, 0x75,
+  0x18, 0x4a, 0x06, 0x2a, 0x89, 0xd8, 0xdd, 0x7e, 0x25, 0xbb, 0x44, 0xa8, 0x26, 0xdb, 0xa1, 0xe4,
+  0x77, 0x18, 0xc6, 0x0a, 0xd8, 0xe6, 0xaf, 0xdf, 0xde, 0x1a, 0x4e, 0xe6, 0xde, 0x42, 0x9f, 0x43,
+  0x5e, 0x78, 0xb0, 0xd8, 0x4a, 0x57, 0x2a, 0x37, 0x27, 0xdc, 0x8c, 0xd2, 0x87, 0x47, 0xe0, 0x4c,
+  0x95, 0x9c, 0x14, 0x3a, 0x7e, 0xfe, 0x87, 0xdb, 0xd7, 0xaf, 0x20, 0x7f, 0x64, 0x1a, 0x19, 0x5a,
+  0x78, 0x09, 0xce, 0x74, 0xde, 0xda, 0x53, 0x91, 0xcf, 0xa7, 0x22, 0x9c, 0xcb, 0x60, 0xe6, 0xef,
+  0xfd, 0x0f, 0x52, 0x28, 0xec, 0x44, 0xa1, 0x3c, 0xac, 0x16, 0x2a, 0xe3, 0xfb, 0xa9, 0x5c, 0x4e,
+  0x4f, 0xb0, 0x36, 0xe9, 0xe7, 0x23, 0xe3, 0xf9, 0x10, 0x18, 0xd9, 0x03, 0x53, 0xc8, 0x27, 0x06,
+  0xf3, 0x8d, 0x6d, 0x1b, 0x28, 0x56, 0xc2, 0x57, 0x39, 0xbb, 0xd4, 0xb8, 0x71, 0xa0, 0x91, 0xde,
+  0x2c, 0x39, 0x7d, 0x03, 0x18, 0x79, 0x25, 0x57, 0x6e, 0xe8, 0xf2, 0x8e, 0x79, 0xdf, 0x8c, 0x48,
+  0x07, 0x46, 0xa9, 0x54, 0xbb, 0xad, 0xac, 0x97, 0xd2, 0x51, 0xfa, 0x26, 0xc1, 0x1b, 0x7d, 0x7c,
+  0xd2, 0xd9, 0x7c, 0x4c, 0xd0, 0xa5, 0xc6, 0x5a, 0x52, 0xb3, 0xf2, 0x8a, 0x94, 0xaf, 0x68, 0x24,
+  0xe4, 0xad, 0xb9, 0xcc, 0x34, 0x0f, 0xf4, 0xf7, 0x0c, 0x80, 0x2d, 0x5a, 0xc8, 0xc0, 0xa0, 0xcd,
+  0x58, 0xd6, 0x1d, 0x4a, 0xe4, 0xb6, 0xbd, 0x6f, 0x1e, 0xa9, 0x89, 0x1b, 0xaf, 0x49, 0x92, 0x56,
+  0x2c, 0x9b, 0x41, 0xa3, 0x11, 0x05, 0xa3, 0xc0, 0x25, 0x06, 0xcf, 0xd2, 0x3e, 0xdc, 0x89, 0xa9,
+  0x29, 0x32, 0x80, 0xfd, 0x51, 0x90, 0x52, 0xaa, 0x63, 0xc7, 0xd4, 0x6c, 0xb7, 0x31, 0xed, 0x34,
+  0x10, 0x6a, 0xde, 0x81, 0x22, 0x30, 0x85, 0x40, 0x92, 0x3e, 0x5f, 0xd1, 0x38, 0x74, 0x62, 0x3a,
+  0xd8, 0x6a, 0x01, 0xfa, 0x7b, 0xbd, 0x72, 0xa5, 0x9d, 0x0e, 0xf5, 0x37, 0x7a, 0xd3, 0xa1, 0xfe,
+  0xdb, 0xfc, 0x7f, 0x01, 0x8f, 0xa6, 0x34, 0xe9, 0xac, 0x1f, 0x00, 0x00,
+};
+const WebAsset INDEX_PAGE = {"text/html", INDEX_PAGE_GZ, sizeof(INDEX_PAGE_GZ), "\"477292cfac718b77\""};
+
+// settings.html: 9321 bytes, 2922 gzip
+static const uint8_t SETTINGS_PAGE_GZ[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x5a, 0x5d, 0x6e, 0xdc, 0xc8,
+  0x11, 0x7e, 0xf7, 0x29, 0x7a, 0x69, 0x24, 0x9c, 0xc1, 0x6a, 0x7e, 0x35, 0x92, 0xe5, 0xd1, 0xcc,
+  0x04, 0x6b, 0xad, 0x9c, 0x18, 0x90, 0xd7, 0xc6, 0x4a, 0xde, 0x45, 0x60, 0x2c, 0x84, 0x26, 0xd9,
+  0x9c, 0xa1, 0x45, 0xb2, 0xb9, 0xec, 0xa6, 0x46, 0xb2, 0xd7, 0x40, 0x6e, 0x90, 0x97, 0x00, 0x41,
+  0xf2, 0xb6, 0xb7, 0xc8, 0xbb, 0x6f, 0xb2, 0x17, 0xc8, 0x15, 0x52, 0xd5, 0xdd, 0x24, 0x9b, 0xf3,
+  0x2b, 0x07, 0xeb, 0x17, 0x8b, 0xec, 0xae, 0xaa, 0xae, 0xfa, 0xba, 0x7e, 0x39, 0x9e, 0x7c, 0xf5,
+  0xed, 0xab, 0xb3, 0xab, 0xbf, 0xbe, 0x3e, 0x27, 0x0b, 0x99, 0xc4, 0xb3, 0x47, 0x13, 0xfc, 0x43,
+  0x62, 0x9a, 0xce, 0xa7, 0x0e, 0x13, 0x0e, 0x2e, 0x30, 0x1a, 0xcc, 0x1e, 0x11, 0x32, 0x49, 0x98,
+  0xa4, 0xc4, 0x5f, 0xd0, 0x5c, 0x30, 0x39, 0x75, 0xde, 0x5c, 0x3d, 0xef, 0x9c, 0x38, 0xa4, 0x57,
+  0x6f, 0xa5, 0x34, 0x61, 0x53, 0xe7, 0x36, 0x62, 0xcb, 0x8c, 0xe7, 0xd2, 0x21, 0x3e, 0x4f, 0x25,
+  0x4b, 0x81, 0x74, 0x19, 0x05, 0x72, 0x31, 0x0d, 0xd8, 0x6d, 0xe4, 0xb3, 0x8e, 0x7a, 0x39, 0x88,
+  0xd2, 0x48, 0x46, 0x34, 0xee, 0x08, 0x9f, 0xc6, 0x6c, 0x3a, 0xe8, 0xf6, 0x1d, 0x2d, 0x48, 0x46,
+  0x32, 0x66, 0xb3, 0x4b, 0x26, 0x65, 0x94, 0xce, 0xc5, 0xa4, 0xa7, 0xdf, 0x71, 0x47, 0xc8, 0x7b,
+  0xfd, 0x44, 0x88, 0xc7, 0x83, 0x7b, 0xf2, 0x41, 0x3d, 0x12, 0x92, 0xd0, 0x7c, 0x1e, 0xa5, 0x63,
+  0xd2, 0x3f, 0x25, 0x19, 0x0d, 0x02, 0x60, 0xc3, 0x67, 0xb3, 0x19, 0x82, 0x0a, 0x9d, 0x90, 0x26,
+  0x51, 0x7c, 0x3f, 0x26, 0xee, 0x25, 0x9b, 0x73, 0x46, 0xde, 0xbc, 0x70, 0x0f, 0x88, 0xfb, 0x4d,
+  0x0e, 0xc7, 0xc3, 0x83, 0xa0, 0xa9, 0xe8, 0x08, 0x96, 0x47, 0x61, 0xc9, 0xe3, 0x51, 0xff, 0x66,
+  0x9e, 0xf3, 0x22, 0x0d, 0xc6, 0xe4, 0x71, 0x38, 0x0a, 0x8f, 0x43, 0x5a, 0x6e, 0x25, 0x51, 0xda,
+  0x59, 0xb0, 0x68, 0xbe, 0x90, 0x63, 0x32, 0xe8, 0xf7, 0x6f, 0x17, 0xe5, 0x46, 0x10, 0x89, 0x2c,
+  0xa6, 0x70, 0x46, 0x18, 0xb3, 0xbb, 0x72, 0x91, 0xc6, 0xd1, 0x3c, 0xed, 0x44, 0x92, 0x25, 0x62,
+  0x4c, 0x7c, 0x40, 0x82, 0xe5, 0xe5, 0xd6, 0xbb, 0x42, 0xc8, 0x28, 0xbc, 0xef, 0x18, 0x88, 0x9a,
+  0xdb, 0x1f, 0xd5, 0xbf, 0x5d, 0x9f, 0xe6, 0x41, 0x65, 0x65, 0x53, 0xa9, 0xb0, 0x56, 0x96, 0xe7,
+  0x01, 0xcb, 0x3b, 0x39, 0x0d, 0xa2, 0x02, 0x4e, 0x19, 0xf6, 0xb3, 0xbb, 0x7a, 0xeb, 0xae, 0x23,
+  0x16, 0x34, 0xe0, 0x4b, 0x00, 0x84, 0x8c, 0xb2, 0x3b, 0x32, 0xc4, 0x7f, 0x1e, 0xf7, 0xfb, 0xfd,
+  0x41, 0x49, 0x53, 0x21, 0x36, 0xcc, 0x59, 0x42, 0x86, 0xdd, 0xa3, 0xb5, 0x3f, 0xb6, 0xe9, 0xea,
+  0xea, 0xc6, 0xe4, 0xd0, 0x3e, 0x25, 0xa1, 0x77, 0xe5, 0xfa, 0xa8, 0x6f, 0xad, 0x9b, 0x35, 0x40,
+  0xe9, 0x0f, 0x0d, 0xab, 0xd4, 0x85, 0x12, 0xf2, 0x41, 0x5f, 0x8d, 0x88, 0xde, 0x33, 0x20, 0xea,
+  0x1e, 0xe3, 0x49, 0xe0, 0x30, 0x31, 0xcf, 0xc1, 0xbe, 0x01, 0x1d, 0xf6, 0x87, 0xfe, 0x29, 0x91,
+  0xec, 0x4e, 0x76, 0x14, 0x8a, 0x15, 0x40, 0xe6, 0xba, 0x3b, 0x1e, 0x97, 0x92, 0x27, 0x60, 0x58,
+  0xf7, 0x50, 0xb1, 0x2a, 0x69, 0x4b, 0x73, 0x35, 0xc7, 0x7d, 0x70, 0x06, 0x73, 0x9e, 0x28, 0x3c,
+  0x7d, 0xe4, 0x87, 0x4a, 0xfc, 0xf1, 0xe8, 0xc9, 0xe8, 0xc4, 0xdb, 0x2c, 0xde, 0xd2, 0xaa, 0xdf,
+  0x7d, 0xaa, 0x44, 0xaf, 0x9c, 0x38, 0xd0, 0xb0, 0x94, 0xf2, 0x43, 0x9e, 0x27, 0x9d, 0x98, 0x7a,
+  0x2c, 0xb6, 0x4e, 0x18, 0xb0, 0xe1, 0xd3, 0x43, 0x6f, 0x45, 0xab, 0x23, 0xd4, 0x6a, 0x4d, 0xfd,
+  0x91, 0x12, 0x56, 0xf9, 0x8f, 0x17, 0x73, 0xff, 0xa6, 0x12, 0x1e, 0xa5, 0x59, 0x21, 0x2b, 0x1f,
+  0xb0, 0x21, 0x6d, 0xc2, 0x37, 0x50, 0x42, 0x56, 0x7c, 0xe1, 0xc4, 0x76, 0x05, 0xdc, 0x01, 0x4a,
+  0xb8, 0x7f, 0xc1, 0xe3, 0x28, 0x20, 0x8f, 0x83, 0x41, 0x70, 0x14, 0x78, 0x76, 0xcc, 0xa8, 0x4b,
+  0x20, 0x03, 0xfb, 0xce, 0x57, 0x2d, 0x1f, 0xaa, 0x73, 0x78, 0x21, 0xe3, 0x28, 0x85, 0x83, 0x53,
+  0x9e, 0xb2, 0x86, 0xb7, 0x45, 0xef, 0x95, 0x28, 0xa3, 0x08, 0x2c, 0x01, 0xc8, 0x39, 0x04, 0x18,
+  0xc4, 0x3a, 0x4f, 0xcb, 0x75, 0x38, 0x69, 0x28, 0x1a, 0x3e, 0xa1, 0xcc, 0x1c, 0x87, 0xdc, 0x2f,
+  0x04, 0x80, 0x58, 0x29, 0xdb, 0x7d, 0x52, 0xab, 0x3b, 0x3c, 0x3a, 0x3e, 0x64, 0x5e, 0x05, 0x8c,
+  0x57, 0x80, 0x4a, 0xe9, 0x66, 0x64, 0x1a, 0xa1, 0x52, 0xf2, 0x95, 0x37, 0xb3, 0x16, 0x3a, 0xc6,
+  0x8a, 0x4d, 0xe0, 0x6d, 0xc0, 0xd8, 0x4e, 0x2b, 0x0d, 0x6f, 0xb3, 0x60, 0x7c, 0xa2, 0xa2, 0x07,
+  0xd6, 0xfc, 0x22, 0x17, 0x78, 0x68, 0xc6, 0x23, 0x3b, 0xf6, 0x1b, 0x88, 0x54, 0xba, 0x02, 0xe3,
+  0xe0, 0x44, 0x9c, 0xae, 0x44, 0xed, 0x10, 0x10, 0x38, 0xc1, 0xa0, 0xd5, 0x76, 0x0c, 0x87, 0x0d,
+  0xdc, 0x34, 0x0a, 0x63, 0xea, 0xcb, 0xe8, 0x16, 0x1d, 0xbc, 0x61, 0xf9, 0xe0, 0xc9, 0xa8, 0xef,
+  0x1d, 0xaf, 0x20, 0x36, 0x06, 0x47, 0xa3, 0x5e, 0xcc, 0x20, 0xb1, 0x10, 0x9e, 0x51, 0x3f, 0x92,
+  0xf7, 0xa8, 0xf2, 0x51, 0x4d, 0x06, 0x22, 0x3a, 0x70, 0xbb, 0x37, 0x15, 0xb6, 0xab, 0xae, 0xb9,
+  0x29, 0x6a, 0x4a, 0x74, 0x0d, 0xda, 0xa5, 0xa1, 0x48, 0x19, 0x30, 0x9f, 0xe7, 0x54, 0x5b, 0xab,
+  0x91, 0x6e, 0x86, 0xd8, 0x91, 0x1d, 0x63, 0x92, 0x67, 0x63, 0xcb, 0x03, 0xcb, 0x10, 0x96, 0x54,
+  0x2a, 0xcf, 0x58, 0xa3, 0x6a, 0xc0, 0xae, 0x50, 0x37, 0xc1, 0xb9, 0x49, 0xc9, 0xad, 0x37, 0xdc,
+  0x08, 0xd0, 0xc6, 0x99, 0x1d, 0x51, 0xf8, 0x3e, 0x13, 0x62, 0x15, 0x5b, 0xcf, 0x0b, 0x9f, 0x04,
+  0x7d, 0x2b, 0x61, 0x1d, 0x1f, 0x1f, 0x1d, 0x8e, 0x4e, 0x2d, 0xd7, 0x1d, 0xd6, 0xae, 0xab, 0x37,
+  0x47, 0xa3, 0x55, 0xd9, 0x2c, 0xcf, 0x79, 0x4e, 0xc8, 0xaa, 0xec, 0x90, 0xf9, 0xd4, 0xa7, 0xb5,
+  0xec, 0xa7, 0x4f, 0x07, 0xde, 0xc0, 0xdb, 0x22, 0x5b, 0x6f, 0x5a, 0xb2, 0xfd, 0x05, 0x83, 0x0b,
+  0xcc, 0xf9, 0x12, 0xc4, 0x36, 0x8b, 0xd2, 0xc6, 0x72, 0x44, 0xe6, 0x34, 0x1b, 0x57, 0xa8, 0x35,
+  0xd0, 0x18, 0x59, 0x68, 0x64, 0x34, 0xca, 0xd7, 0x05, 0x1a, 0xde, 0x13, 0x3b, 0x1d, 0x2a, 0xca,
+  0x19, 0x50, 0xde, 0x62, 0x8a, 0x07, 0x32, 0x50, 0xb8, 0xda, 0x5c, 0x40, 0x1c, 0x58, 0x59, 0xf2,
+  0xe9, 0x88, 0x1e, 0x7a, 0x27, 0x2b, 0x0e, 0x71, 0x32, 0x5c, 0x73, 0x88, 0x4e, 0x79, 0xc6, 0x96,
+  0x7c, 0x64, 0xa4, 0xc7, 0x7c, 0xbe, 0xd9, 0xf0, 0xb5, 0x62, 0x2b, 0xc0, 0xf3, 0x59, 0xc7, 0x63,
+  0x72, 0xc9, 0x58, 0xba, 0x05, 0x98, 0xb5, 0x44, 0x7d, 0xb4, 0xe9, 0x2c, 0xc1, 0x62, 0xe6, 0xcb,
+  0x95, 0x6a, 0xb6, 0x29, 0x19, 0x1f, 0xa3, 0xb7, 0x3d, 0x2c, 0x0d, 0x0f, 0x6d, 0x47, 0xc6, 0xf3,
+  0x26, 0x3d, 0xd3, 0xfb, 0x4c, 0x7a, 0xba, 0x17, 0x9b, 0x60, 0x03, 0xa4, 0x9a, 0x22, 0xc4, 0xd9,
+  0x8f, 0xa9, 0x10, 0x53, 0x07, 0xdb, 0x05, 0x47, 0xf7, 0x47, 0xf6, 0xb2, 0x2a, 0x7e, 0xce, 0xec,
+  0xb7, 0x7f, 0xff, 0xeb, 0xbf, 0xff, 0xf9, 0x3b, 0xa9, 0x1b, 0x2b, 0x20, 0xb1, 0x88, 0xa3, 0x60,
+  0xea, 0x94, 0x95, 0xd2, 0x29, 0x59, 0xab, 0x85, 0xd9, 0x1f, 0x53, 0x4f, 0x64, 0xa7, 0x36, 0x13,
+  0x96, 0x3d, 0xcd, 0x65, 0x24, 0x3e, 0x87, 0x05, 0x87, 0xd0, 0x42, 0x72, 0x9f, 0x27, 0x59, 0xcc,
+  0x24, 0xb4, 0x82, 0x3c, 0x0c, 0x8d, 0x46, 0xc0, 0xa1, 0x6b, 0xa4, 0x11, 0x5d, 0x57, 0x4d, 0x07,
+  0xa0, 0xcb, 0xa7, 0x0e, 0x74, 0x86, 0xd7, 0x37, 0x73, 0x67, 0x76, 0x05, 0xb0, 0x33, 0x49, 0x5e,
+  0xf8, 0x8c, 0xb4, 0x6e, 0xe6, 0xed, 0x49, 0x4f, 0x11, 0x55, 0x42, 0x74, 0x41, 0xc4, 0x73, 0x0d,
+  0x83, 0x69, 0x3a, 0xcb, 0x37, 0x23, 0x5e, 0x91, 0x39, 0x44, 0xde, 0x67, 0xb0, 0x97, 0x16, 0x89,
+  0xc7, 0x72, 0x87, 0x08, 0xc9, 0xb2, 0xa9, 0x03, 0x69, 0xd6, 0xc1, 0x66, 0x06, 0x9e, 0x1c, 0x92,
+  0xb3, 0x9f, 0x8b, 0x28, 0x87, 0x6c, 0xd8, 0x7b, 0xa0, 0x9a, 0x4b, 0x0a, 0xce, 0x61, 0x2b, 0xfa,
+  0x23, 0x2e, 0xec, 0x51, 0xb5, 0x62, 0x32, 0xca, 0xd6, 0xef, 0x5f, 0x5a, 0x5d, 0x60, 0xbc, 0x5e,
+  0x3a, 0xb3, 0x97, 0xd0, 0x6d, 0x27, 0x45, 0x02, 0x22, 0x69, 0x2e, 0x89, 0x0e, 0xf0, 0x3d, 0x3a,
+  0x6b, 0x4e, 0xa3, 0xb0, 0x79, 0xf9, 0x62, 0xda, 0x92, 0x2a, 0x6b, 0x19, 0xbd, 0xd1, 0x8d, 0xae,
+  0x95, 0xb6, 0x95, 0xff, 0x34, 0xb4, 0xb3, 0xf6, 0x8d, 0x8a, 0xf6, 0x8a, 0xd6, 0x4c, 0xc9, 0x84,
+  0x6a, 0xea, 0xd4, 0xe7, 0x13, 0x72, 0xa9, 0x10, 0x40, 0xe2, 0x04, 0x6a, 0x12, 0xcc, 0x1e, 0xf1,
+  0x3d, 0x59, 0x2e, 0x58, 0x4a, 0x28, 0x91, 0x5c, 0x32, 0x82, 0xde, 0x1c, 0x33, 0x41, 0xa0, 0xb7,
+  0x90, 0x0b, 0x78, 0xc5, 0xe9, 0xa4, 0x54, 0x7e, 0x05, 0xab, 0xb5, 0x18, 0x23, 0x2a, 0x4a, 0xd1,
+  0xae, 0x32, 0x15, 0x98, 0x04, 0x65, 0xe5, 0x32, 0xd3, 0x3c, 0x3a, 0x33, 0x74, 0xf0, 0x80, 0x0b,
+  0x88, 0x1c, 0x2b, 0xaa, 0x3e, 0x03, 0x21, 0x7e, 0xcb, 0xf2, 0x98, 0x66, 0x9b, 0xe1, 0x29, 0x37,
+  0x0d, 0x36, 0xd5, 0xeb, 0x0e, 0x60, 0xb4, 0x1f, 0x53, 0xe8, 0x43, 0x20, 0x94, 0x08, 0x95, 0xda,
+  0x7c, 0x60, 0x27, 0x32, 0x82, 0x7f, 0x5a, 0x34, 0xc4, 0xfd, 0x43, 0x00, 0xe8, 0xe7, 0x02, 0x32,
+  0x24, 0xcc, 0x4e, 0xc4, 0xbf, 0xf7, 0x11, 0x2a, 0xc9, 0x49, 0xcc, 0x68, 0xae, 0x01, 0x0b, 0x63,
+  0xbe, 0x14, 0xed, 0x2d, 0x88, 0x3d, 0xd4, 0x36, 0x0c, 0x66, 0x3f, 0xdc, 0x6c, 0x9a, 0xd9, 0xb3,
+  0xc2, 0x1e, 0xdf, 0x76, 0x18, 0x76, 0xc6, 0x71, 0x5e, 0xed, 0x85, 0xaa, 0x61, 0x0d, 0x8b, 0x38,
+  0x86, 0xec, 0xcf, 0x58, 0x70, 0x80, 0xea, 0xa6, 0x44, 0x2c, 0x60, 0x52, 0x05, 0xc3, 0xb2, 0x22,
+  0x16, 0x60, 0x4b, 0x0a, 0x86, 0x28, 0x3b, 0xa4, 0x8a, 0xee, 0xfd, 0x37, 0x8f, 0xe5, 0xce, 0x56,
+  0xd4, 0xba, 0xca, 0x07, 0x84, 0x27, 0x2a, 0xa5, 0x92, 0xc9, 0x73, 0x78, 0x20, 0xef, 0xa1, 0x3b,
+  0xda, 0x14, 0x95, 0x2b, 0x08, 0x94, 0x4c, 0x06, 0x82, 0xea, 0xf5, 0x21, 0xd1, 0xd9, 0x3f, 0x2a,
+  0xc3, 0x13, 0x03, 0x75, 0x3d, 0x40, 0xd1, 0xd6, 0x86, 0x09, 0x9f, 0x69, 0x90, 0xe4, 0xb1, 0x4e,
+  0x8e, 0x3c, 0x66, 0xd0, 0xe5, 0xfa, 0x0f, 0xb1, 0xc7, 0xf0, 0x18, 0x73, 0xca, 0xb7, 0x07, 0x59,
+  0x53, 0x9b, 0xf3, 0x00, 0x63, 0x9a, 0x2f, 0xbf, 0xdb, 0x1d, 0x2a, 0xcf, 0xb9, 0x86, 0x29, 0xf8,
+  0x3a, 0x11, 0xce, 0xec, 0x35, 0xbe, 0xe1, 0x4c, 0x4c, 0x5a, 0x89, 0xd8, 0x63, 0x78, 0x83, 0xd3,
+  0x98, 0xdf, 0x5c, 0xdb, 0x0f, 0xc2, 0x51, 0xdf, 0x20, 0x00, 0xdd, 0x9a, 0x83, 0xe7, 0x4e, 0x1d,
+  0x18, 0x82, 0xfa, 0xfd, 0x2f, 0x71, 0xb9, 0x46, 0x37, 0xa8, 0x05, 0x96, 0xa5, 0x51, 0xfa, 0x70,
+  0x4b, 0x35, 0x67, 0xd3, 0x52, 0xb3, 0xf6, 0x45, 0x2d, 0x7d, 0x50, 0x86, 0x6d, 0x18, 0xb9, 0xa4,
+  0x91, 0x54, 0x56, 0xfe, 0x08, 0x0f, 0x44, 0xe7, 0x3e, 0xb5, 0xb3, 0xc9, 0xd8, 0x35, 0x43, 0x4b,
+  0xee, 0x86, 0xa5, 0xd5, 0xe2, 0x67, 0x98, 0xba, 0xd7, 0xd0, 0x49, 0x56, 0x8a, 0xc3, 0xd6, 0xda,
+  0x99, 0x7d, 0xcf, 0x12, 0x0a, 0xb5, 0x3e, 0x9d, 0xab, 0x2c, 0x0e, 0x3a, 0x42, 0x8b, 0xaa, 0xd2,
+  0x72, 0x95, 0x5f, 0x22, 0x81, 0x65, 0x07, 0x64, 0xc0, 0xc5, 0x99, 0xa4, 0xc7, 0x43, 0xe5, 0xb0,
+  0x9f, 0xfe, 0x09, 0x07, 0x94, 0xec, 0x3d, 0x8b, 0xa5, 0x95, 0x32, 0x28, 0x20, 0x46, 0x1a, 0xe8,
+  0xd5, 0x3e, 0x20, 0x05, 0x54, 0x80, 0x18, 0xa6, 0x6e, 0x09, 0xc7, 0x42, 0x01, 0x30, 0xc1, 0xde,
+  0x9d, 0xf4, 0xb2, 0x6d, 0x9a, 0x9d, 0x2d, 0x68, 0x3a, 0xc7, 0x6a, 0x41, 0x6f, 0x18, 0x61, 0x61,
+  0x88, 0x5d, 0x73, 0x94, 0x24, 0x2c, 0x88, 0xa0, 0xf0, 0x40, 0x11, 0xc6, 0xca, 0x93, 0xb1, 0x5c,
+  0x44, 0xa2, 0xc4, 0x3b, 0x67, 0x1e, 0xe7, 0xb2, 0x21, 0xd3, 0x4c, 0xfd, 0xaa, 0xed, 0xa4, 0xb7,
+  0xec, 0x99, 0x4c, 0x4b, 0x00, 0xa1, 0x55, 0x4d, 0x22, 0x59, 0x81, 0xab, 0x09, 0x1d, 0x52, 0x4e,
+  0xbb, 0xb3, 0x4b, 0x20, 0xb7, 0x9a, 0x5f, 0xbd, 0x6f, 0x5a, 0xd9, 0x1e, 0x3a, 0xc1, 0x6a, 0x2f,
+  0xac, 0x46, 0xb4, 0x97, 0x02, 0x72, 0xd9, 0x6a, 0xab, 0xfc, 0xff, 0xd7, 0xfc, 0x0b, 0x3e, 0x87,
+  0x52, 0x79, 0xcb, 0xe2, 0x46, 0xfb, 0xdd, 0x04, 0xaa, 0x14, 0x68, 0xf1, 0xf7, 0x81, 0xf5, 0x92,
+  0xe1, 0xe7, 0x4a, 0xfc, 0xf2, 0x82, 0xae, 0x06, 0x40, 0x91, 0x84, 0x07, 0x45, 0xcc, 0xba, 0xe4,
+  0x55, 0x86, 0xb3, 0xb5, 0x20, 0xd4, 0x83, 0x32, 0xaf, 0x2e, 0x1b, 0xfb, 0xef, 0x08, 0x47, 0x7c,
+  0xbc, 0x55, 0x9a, 0xc3, 0x9d, 0xcf, 0x53, 0x0e, 0x6e, 0x53, 0x43, 0x59, 0x99, 0x09, 0x63, 0xcc,
+  0x85, 0x52, 0xa8, 0x69, 0x26, 0xad, 0x70, 0x2c, 0xbf, 0x06, 0x38, 0x64, 0x91, 0xb3, 0x70, 0xea,
+  0xf4, 0x60, 0x16, 0x88, 0x69, 0x0e, 0xf3, 0xd1, 0x33, 0xd8, 0xc2, 0xda, 0x8f, 0x1e, 0x03, 0xd3,
+  0xcb, 0x9c, 0x4d, 0x7a, 0x54, 0x8d, 0x24, 0xa5, 0x9c, 0x89, 0xf0, 0xf3, 0x28, 0x93, 0x5a, 0x64,
+  0xaf, 0x47, 0xa6, 0xd3, 0x29, 0xf9, 0x81, 0xc2, 0xe4, 0x07, 0x5e, 0x40, 0x7d, 0x59, 0x50, 0x6c,
+  0x1e, 0x5a, 0x7f, 0x3e, 0xbf, 0x22, 0xbd, 0x72, 0x86, 0xe8, 0xbe, 0x13, 0x3c, 0x6d, 0x8f, 0x49,
+  0x4c, 0x49, 0xf6, 0xe9, 0x57, 0xb0, 0x9f, 0x12, 0xa0, 0x61, 0x42, 0x7e, 0xfa, 0x15, 0x9b, 0x35,
+  0x72, 0x4f, 0x60, 0x34, 0x86, 0x11, 0x08, 0xae, 0x14, 0xc5, 0x29, 0xc9, 0x21, 0x93, 0xfe, 0xa2,
+  0xe5, 0x36, 0x65, 0xb8, 0xed, 0x2e, 0x96, 0xf7, 0x56, 0x4e, 0xa6, 0x33, 0x92, 0xab, 0xa5, 0x56,
+  0xdb, 0xac, 0x09, 0x5c, 0xab, 0x3e, 0x6e, 0x70, 0xbf, 0x48, 0xa0, 0x9f, 0x31, 0x9f, 0x25, 0xa7,
+  0xf8, 0x8d, 0x58, 0xcb, 0x21, 0xbf, 0xfd, 0xed, 0x1f, 0xc4, 0x25, 0x5f, 0x13, 0x01, 0xc3, 0x9e,
+  0xaf, 0x3e, 0x60, 0x9c, 0xae, 0x32, 0x41, 0x8b, 0x70, 0x1e, 0x33, 0x7c, 0x7c, 0x76, 0xff, 0x22,
+  0x68, 0xb9, 0xe5, 0xc0, 0x84, 0xc7, 0xb3, 0x3b, 0x79, 0xa6, 0xe7, 0x4d, 0x90, 0x5a, 0xcb, 0x00,
+  0x81, 0xae, 0x12, 0x7d, 0xab, 0x65, 0xdf, 0xa2, 0xcf, 0xd7, 0xa2, 0x5f, 0x79, 0xef, 0x20, 0x32,
+  0xba, 0x37, 0xec, 0x5e, 0xb4, 0x44, 0x1b, 0x3f, 0x2e, 0x9e, 0x83, 0xc5, 0xad, 0x1b, 0x5b, 0x67,
+  0x82, 0x1f, 0xd6, 0x21, 0x4c, 0x20, 0x8b, 0x4d, 0xb7, 0xea, 0x72, 0xd3, 0x3e, 0xad, 0xc8, 0xa3,
+  0x90, 0xb4, 0xbe, 0x02, 0xea, 0x5f, 0x7e, 0x01, 0x9e, 0xae, 0xa4, 0xf3, 0xef, 0xb0, 0xaf, 0xfb,
+  0x0a, 0xee, 0xc3, 0x7d, 0xf1, 0xdd, 0xeb, 0x37, 0x57, 0x6e, 0x1b, 0x82, 0x4d, 0x16, 0x79, 0xda,
+  0x64, 0x41, 0x5a, 0x08, 0x2e, 0x75, 0x71, 0x6e, 0xd9, 0x5b, 0x01, 0x2d, 0xac, 0xab, 0x37, 0xf0,
+  0x30, 0xb0, 0xec, 0xed, 0xcd, 0x4f, 0x35, 0x1b, 0xc3, 0x14, 0x09, 0xfb, 0xb7, 0x34, 0x2e, 0xd8,
+  0xca, 0xee, 0xc7, 0xf6, 0x7e, 0xfc, 0x74, 0x50, 0x03, 0x7c, 0xd5, 0x67, 0xaa, 0x29, 0x09, 0x29,
+  0x08, 0x35, 0xdf, 0x83, 0xda, 0x5d, 0x40, 0x11, 0xf0, 0x68, 0xb5, 0x6d, 0x40, 0x34, 0x1c, 0x55,
+  0xc8, 0xee, 0x40, 0xc5, 0xad, 0x88, 0xdc, 0x4a, 0x9b, 0x6a, 0x69, 0xe5, 0xce, 0xdc, 0x33, 0x5e,
+  0xc4, 0x01, 0x49, 0xb9, 0x24, 0x31, 0xa7, 0x81, 0x0e, 0xad, 0x22, 0xcf, 0x71, 0xb7, 0x74, 0xb6,
+  0x03, 0x00, 0xae, 0xda, 0xc4, 0x20, 0xe8, 0xba, 0xeb, 0x62, 0x55, 0x2c, 0x29, 0xc8, 0x41, 0xa8,
+  0xf9, 0x96, 0x65, 0x7f, 0x02, 0x72, 0x4b, 0xe3, 0x4e, 0x1f, 0x3d, 0xda, 0x0d, 0x8f, 0x35, 0x6a,
+  0x03, 0x46, 0x34, 0x08, 0xce, 0x6f, 0x61, 0xf3, 0x02, 0x72, 0x26, 0x4b, 0x59, 0xae, 0xfc, 0x0f,
+  0xb2, 0xa0, 0x7b, 0x00, 0x7d, 0x6e, 0xea, 0xa3, 0xb7, 0xb5, 0x58, 0xbb, 0x42, 0x89, 0x75, 0xb3,
+  0x9c, 0x21, 0xfd, 0xb7, 0x2c, 0xa4, 0x45, 0x2c, 0x5b, 0x15, 0x02, 0x5f, 0x08, 0xbf, 0x7d, 0x50,
+  0xb8, 0xcd, 0xf3, 0x03, 0x2a, 0x29, 0x2c, 0xa7, 0x6c, 0x49, 0xde, 0x7c, 0x7f, 0x71, 0x09, 0x9d,
+  0xb8, 0xbf, 0x78, 0x4d, 0x73, 0x9a, 0x88, 0x56, 0xed, 0xf9, 0x7a, 0xce, 0x1f, 0xef, 0x42, 0x49,
+  0x93, 0x00, 0x3e, 0xca, 0x09, 0x0f, 0x2a, 0xd6, 0x72, 0xea, 0x1e, 0x6f, 0x67, 0x2d, 0x49, 0xd6,
+  0x99, 0xd5, 0x04, 0x3c, 0xde, 0x79, 0x3b, 0x8a, 0x64, 0x9d, 0xb3, 0x1e, 0x4c, 0x77, 0x1c, 0x5c,
+  0x13, 0x81, 0x80, 0x32, 0xb8, 0xfe, 0x44, 0xdc, 0x81, 0x4b, 0xc6, 0xc4, 0xed, 0xbb, 0xb5, 0x38,
+  0x33, 0xcb, 0x8d, 0x77, 0x28, 0x62, 0x48, 0xf6, 0x49, 0xd2, 0xb3, 0xd3, 0x5e, 0x28, 0xfd, 0x70,
+  0x9f, 0x20, 0x33, 0x81, 0xec, 0x52, 0xc9, 0x90, 0xac, 0xa3, 0xa3, 0xdb, 0xfd, 0x9d, 0x4a, 0x68,
+  0x92, 0x75, 0x56, 0xbb, 0x55, 0xde, 0x75, 0xb6, 0x4d, 0xb7, 0x55, 0x8a, 0x6a, 0x43, 0x1f, 0x20,
+  0x45, 0xd1, 0x6d, 0x93, 0x62, 0x5a, 0xbc, 0xf1, 0x3e, 0x29, 0x86, 0xae, 0x14, 0xb3, 0x96, 0x1f,
+  0xcb, 0x92, 0x56, 0x64, 0x10, 0x13, 0xec, 0xba, 0x0c, 0x7b, 0x88, 0xeb, 0x3a, 0x10, 0x12, 0x26,
+  0x17, 0x3c, 0x80, 0x9b, 0x78, 0xfd, 0xea, 0xf2, 0xca, 0xba, 0x0c, 0xfc, 0x40, 0x08, 0x25, 0x65,
+  0x4c, 0x3e, 0x60, 0x02, 0x53, 0xb1, 0xd8, 0xb9, 0x82, 0x2c, 0xee, 0x02, 0x29, 0xcd, 0xb2, 0x38,
+  0xd2, 0x65, 0xa8, 0x77, 0xd7, 0x59, 0x2e, 0x97, 0x1d, 0xd5, 0xfe, 0x16, 0x79, 0xcc, 0x52, 0x9f,
+  0x07, 0x2c, 0x70, 0xc9, 0xc7, 0x5a, 0x12, 0x7e, 0x63, 0x1c, 0xab, 0xa8, 0xac, 0x14, 0x34, 0x0f,
+  0xba, 0x8e, 0x52, 0x71, 0x9f, 0xfa, 0x04, 0xab, 0xf9, 0x86, 0xda, 0x84, 0xa9, 0x00, 0x82, 0x99,
+  0xa2, 0xa9, 0x48, 0xa3, 0x72, 0x43, 0x6b, 0xb5, 0x26, 0xe1, 0x06, 0xbf, 0x69, 0x43, 0xf6, 0xc4,
+  0x6f, 0xa9, 0x18, 0xf9, 0xe7, 0x98, 0x10, 0x5b, 0x8a, 0x1b, 0xaa, 0x95, 0xab, 0x5e, 0x09, 0x94,
+  0x05, 0xec, 0x49, 0xab, 0x0a, 0xef, 0x5a, 0x72, 0x74, 0xe1, 0x52, 0xe7, 0x9d, 0x6e, 0xd6, 0x33,
+  0xc1, 0x8c, 0x66, 0x6b, 0xb8, 0x2d, 0x61, 0x01, 0xe1, 0xe9, 0x06, 0xa2, 0x1d, 0xe9, 0xdb, 0xfc,
+  0x3a, 0xe0, 0xae, 0x9f, 0xac, 0xcb, 0x14, 0xa4, 0xf7, 0x87, 0x1d, 0x0d, 0x84, 0xdd, 0x04, 0x24,
+  0x41, 0x05, 0xd9, 0x65, 0xf7, 0x67, 0xaa, 0x67, 0x57, 0x97, 0xda, 0xbf, 0xaa, 0x3a, 0x63, 0x7a,
+  0xb2, 0xba, 0x2b, 0x55, 0xdd, 0x58, 0x0f, 0x1d, 0x8a, 0xf4, 0xa0, 0x33, 0xbc, 0xd6, 0xab, 0xed,
+  0xaa, 0xd5, 0xd2, 0x57, 0x7b, 0x71, 0xfe, 0xc3, 0xf9, 0xc5, 0x25, 0x9c, 0xf6, 0xd6, 0xe5, 0x61,
+  0x88, 0x3f, 0xa5, 0x47, 0x69, 0xc8, 0xf1, 0x2f, 0xe4, 0x1d, 0x0f, 0x66, 0x0b, 0xd7, 0x94, 0xfc,
+  0xd2, 0x8d, 0x6b, 0x51, 0xbb, 0xda, 0x32, 0xe8, 0x67, 0xc5, 0x7a, 0x51, 0x87, 0x8e, 0x63, 0x57,
+  0x39, 0xaa, 0xfa, 0xd7, 0xda, 0x25, 0xec, 0x0e, 0x0a, 0x65, 0xd6, 0x4d, 0x54, 0xaa, 0x40, 0x5a,
+  0xf7, 0x55, 0xf4, 0x3d, 0xeb, 0x0c, 0x3f, 0x67, 0x10, 0x75, 0xe6, 0x98, 0x96, 0x0b, 0xdd, 0x6c,
+  0xc3, 0xdf, 0xf8, 0xb2, 0x09, 0xb9, 0xf9, 0x25, 0xc0, 0xba, 0x1b, 0x53, 0x4e, 0x9b, 0xed, 0xd9,
+  0x8a, 0x54, 0xfd, 0xbb, 0x81, 0x2d, 0x58, 0xc3, 0x5a, 0x29, 0xdb, 0x52, 0x23, 0xe6, 0x01, 0x89,
+  0xda, 0x4d, 0x95, 0x4b, 0xf1, 0x3c, 0x93, 0x3b, 0xc4, 0x73, 0x35, 0x14, 0xd8, 0xe2, 0x09, 0x72,
+  0x54, 0x7d, 0x59, 0xb4, 0xba, 0xd1, 0x74, 0x47, 0x3d, 0x22, 0x7f, 0x4d, 0x5a, 0x11, 0x99, 0xe1,
+  0xa0, 0x21, 0xde, 0x22, 0x76, 0x3f, 0x75, 0x71, 0xa0, 0x80, 0x12, 0x40, 0x5a, 0x42, 0x42, 0x6b,
+  0x9f, 0xb1, 0xa0, 0xad, 0x8a, 0x41, 0xf3, 0x1c, 0x30, 0xad, 0x0b, 0x99, 0x86, 0xa5, 0xc1, 0xd9,
+  0x22, 0x8a, 0x83, 0x16, 0x88, 0xb7, 0xf6, 0x3f, 0x5a, 0xcf, 0xc2, 0xea, 0x14, 0xad, 0x53, 0x94,
+  0xaf, 0x34, 0xa9, 0xd6, 0x5b, 0x1d, 0x5f, 0xcd, 0x93, 0xe0, 0x75, 0xad, 0x35, 0x80, 0x36, 0xf8,
+  0xdd, 0x41, 0x83, 0x60, 0x7b, 0xf6, 0xfc, 0x7d, 0x33, 0x68, 0x9d, 0x45, 0x37, 0x36, 0x35, 0x66,
+  0x84, 0x1b, 0xab, 0xcf, 0x04, 0x07, 0x3a, 0x06, 0xc7, 0x16, 0x28, 0x55, 0x36, 0x59, 0xc5, 0xed,
+  0xe3, 0x8a, 0x3f, 0x46, 0x29, 0x40, 0xf2, 0x97, 0xab, 0x97, 0x17, 0xe8, 0x8f, 0x13, 0x91, 0xd1,
+  0x74, 0xc3, 0xe7, 0x8d, 0x19, 0xce, 0x1b, 0x2a, 0x04, 0x60, 0x02, 0x99, 0xf4, 0x90, 0x6a, 0xe6,
+  0x36, 0xe5, 0xd8, 0xb7, 0x06, 0x6a, 0x58, 0xa7, 0x40, 0x18, 0x36, 0x76, 0x81, 0xba, 0xbd, 0x29,
+  0xaf, 0xa8, 0xdf, 0xaa, 0xcc, 0xd8, 0x07, 0x53, 0xb6, 0xfa, 0x95, 0x6a, 0xd2, 0xd3, 0xff, 0xb1,
+  0xe8, 0x7f, 0xfc, 0xfa, 0x14, 0x51, 0x69, 0x24, 0x00, 0x00,
+};
+const WebAsset SETTINGS_PAGE = {"text/html", SETTINGS_PAGE_GZ, sizeof(SETTINGS_PAGE_GZ), "\"44712bf851eaf17c\""};
@@ -1,5 +1,18 @@
 // WebFiles.h
 #pragma once
+#include <stdint.h>
+#include <stddef.h>
 
-extern const char* INDEX_HTML;
-extern const char* SETTINGS_HTML;
\ No newline at end of file
+// Páginas en flash ya comprimidas (WebFiles.cpp lo genera
+// tools/web_assets.py desde web/). Se envían tal cual con
+// Content-Encoding: gzip; etag cambia solo si cambia la página.
+// Los valores dinámicos no van en la página: los pide por JSON.
+struct WebAsset {
+  const char*    type;   // MIME
+  const uint8_t* gz;
+  size_t         len;
+  const char*    etag;   // con comillas, listo para la cabecera
+};
+
+extern const WebAsset INDEX_PAGE;
+extern const WebAsset SETTINGS_PAGE;
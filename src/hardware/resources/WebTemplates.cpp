@@ -0,0 +1,21 @@
+// WebTemplates.cpp
+#include "WebTemplates.h"
+#include "config.h"
+
+size_t renderSettingsJson(char* out, size_t n, const Settings::Snapshot& settings,
+                          const char* location) {
+  const Dosing::Config& dosing = settings.dosing;
+  const int len = snprintf(out, n,
+      "{\"location\":\"%s\",\"version\":\"%s\","
+      "\"ice_kg\":%.2f,\"water_kg\":%.2f,\"min_w\":%.2f,\"auto_start\":%s,"
+      "\"overlap\":%s,\"ice_cf\":%s,\"fine_kg\":%.2f,\"tol_kg\":%.3f,"
+      "\"pulse_max_ms\":%lu,\"pulse_min_ms\":%lu,\"pulse_wait_ms\":%lu}",
+      location, VERSION,
+      dosing.ice_kg, dosing.water_kg, settings.min_w, settings.auto_start ? "true" : "false",
+      dosing.overlap ? "true" : "false",
+      dosing.strategy == Dosing::Strategy::COARSE_FINE ? "true" : "false",
+      dosing.fine_kg, dosing.tol_kg,
+      (unsigned long)dosing.pulse_max_ms, (unsigned long)dosing.pulse_min_ms,
+      (unsigned long)dosing.pulse_wait_ms);
+  return len < 0 ? 0 : (size_t)len;
+}
@@ -0,0 +1,13 @@
+// WebTemplates.h
+#pragma once
+#include <Arduino.h>
+#include "../../Settings.h"
+
+// What GET /settings.json returns: the current values for the static
+// settings page (SETTINGS_PAGE fills its inputs by id from these keys),
+// plus location and firmware version. Every value comes from one
+// Settings::snapshot(), so the page never mixes two versions. Written
+// into out, no heap; returns the length, >= n if it did not fit. No web
+// server dependency so env:native can benchmark it.
+size_t renderSettingsJson(char* out, size_t n, const Settings::Snapshot& settings,
+                          const char* location);
@@ -0,0 +1,43 @@
+#pragma once
+// ============================================================
+// LaneHost  —  What Lane.cpp takes from main.h, for native builds
+//
+// Lane.cpp talks to the backend WebSocket, the BLE QR reader and
+// the tote record builder through main.cpp's globals. Off-target
+// they are these stand-ins instead: the WS client records what the
+// lane reported (the simulator compares it with the plant), the
+// QR reader is never connected. The objects and the two functions
+// are defined by the host program (src/sim/SimBackend.cpp).
+// ============================================================
+#include <Arduino.h>
+#include <math.h>
+#include "Types.h"
+
+class ToteWebSocketClient {
+public:
+  // ── Test side ──────────────────────────────────────────────
+  float    waterKg = NAN;   // last sendWaterDispensed()
+  float    iceKg   = NAN;   // last sendIceDispensed()
+  uint32_t sent = 0, errors = 0;
+
+  bool sendWeight(float, const char*)            { sent++; return true; }
+  bool sendStateChange(const char*, const char*) { sent++; return true; }
+  bool sendToteValidated(const char*, const char*) { sent++; return true; }
+  bool sendToteCompleted(const char*, const char*) { sent++; return true; }
+  bool sendIceDispensed(float kg, const char*)   { sent++; iceKg = kg; return true; }
+  bool sendWaterDispensed(float kg, const char*) { sent++; waterKg = kg; return true; }
+  bool sendError(const char*, const char*)       { sent++; errors++; return true; }
+};
+
+class BLEQRClient {
+public:
+  bool     isConnected() const    { return false; }
+  uint32_t pollIntervalMs() const { return 3000; }
+  void     requestQR()            {}
+};
+
+extern ToteWebSocketClient wsClient;
+extern BLEQRClient bleQRClient;
+
+void sendStats();
+String totePayload(const char* toteId, float raw_kg, float ice_out_kg, float water_out_kg, float temp_out, const tote_trace* trace = nullptr);
@@ -0,0 +1,217 @@
+// ============================================================
+// MarelEmulator.cpp  —  Marel M2200 Modbus RTU slave on a pty
+// ============================================================
+#include "MarelEmulator.h"
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <chrono>
+#include <thread>
+#include "../core/ModbusRtu.h"
+#include "../marel.h"            // REG_* / COIL_* map (host shims via -Isrc/host/shim)
+
+#define REG_COUNT               8      // 40001..40008
+#define COIL_COUNT              1016   // 00001..01016
+
+using namespace ModbusRtu;
+
+static uint64_t nowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+MarelEmulator::MarelEmulator(const Params& p) : _p(p), _rng(p.seed) {
+  _t0Us = nowUs();
+}
+
+MarelEmulator::~MarelEmulator() {
+  if (!_link.empty()) unlink(_link.c_str());
+  if (_slaveHold >= 0) close(_slaveHold);
+  if (_master >= 0) close(_master);
+}
+
+bool MarelEmulator::open(const char* linkPath) {
+  _master = posix_openpt(O_RDWR | O_NOCTTY);
+  if (_master < 0 || grantpt(_master) != 0 || unlockpt(_master) != 0) {
+    perror("[emu] posix_openpt");
+    return false;
+  }
+  _path = ptsname(_master);
+
+  // Raw mode on the slave side so the line discipline never touches
+  // the binary frames (no echo, no CR/LF mapping)
+  _slaveHold = ::open(_path.c_str(), O_RDWR | O_NOCTTY);
+  termios tio;
+  if (_slaveHold >= 0 && tcgetattr(_slaveHold, &tio) == 0) {
+    cfmakeraw(&tio);
+    tcsetattr(_slaveHold, TCSANOW, &tio);
+  }
+
+  if (linkPath) {
+    unlink(linkPath);
+    if (symlink(_path.c_str(), linkPath) == 0) _link = linkPath;
+    else perror("[emu] symlink");
+  }
+  return true;
+}
+
+// ── Weight model ─────────────────────────────────────────────────────────────
+double MarelEmulator::grossKg() {
+  std::lock_guard<std::mutex> lock(_mtx);
+  return _p.gross_kg + _p.ramp_kgps * (nowUs() - _t0Us) / 1e6 - _zero;
+}
+
+double MarelEmulator::tareKg() {
+  std::lock_guard<std::mutex> lock(_mtx);
+  return _tare;
+}
+
+double MarelEmulator::weightNoise() {
+  if (_p.noise_kg <= 0) return 0;
+  return std::normal_distribution<double>(0.0, _p.noise_kg)(_rng);
+}
+
+MarelEmulator::Counters MarelEmulator::counters() {
+  std::lock_guard<std::mutex> lock(_mtx);
+  return _count;
+}
+
+static void putWeight(uint16_t* regs, uint16_t reg, double kg, int32_t countsPerKg) {
+  const int32_t raw = (int32_t)lround(kg * countsPerKg);
+  regs[reg]     = (uint16_t)((uint32_t)raw & 0xFFFF);   // CDAB: low word first
+  regs[reg + 1] = (uint16_t)((uint32_t)raw >> 16);
+}
+
+// ── Serving ──────────────────────────────────────────────────────────────────
+void MarelEmulator::serve(const std::atomic<bool>& stop) {
+  const uint32_t gapUs = frameGapUs(_p.baud);
+  uint8_t  frame[MAX_FRAME];
+  size_t   len = 0;
+
+  while (!stop.load()) {
+    pollfd pfd = {_master, POLLIN, 0};
+    // Wait for the first byte in 50 ms slices, then for t3.5 of silence
+    const int timeoutMs = len ? (int)((gapUs + 999) / 1000) : 50;
+    const int r = poll(&pfd, 1, timeoutMs);
+
+    if (r > 0 && (pfd.revents & POLLIN)) {
+      const ssize_t n = read(_master, frame + len, sizeof(frame) - len);
+      if (n > 0) len += n;
+      // Every request in the M2200 subset is 8 bytes: no need to wait the gap out
+      if (len < REQUEST_SIZE) continue;
+    } else if (len == 0) {
+      continue;
+    }
+
+    handle(frame, len);
+    len = 0;
+  }
+}
+
+void MarelEmulator::handle(const uint8_t* frame, size_t len) {
+  Request req;
+  if (!parseRequest(frame, len, req)) {
+    std::lock_guard<std::mutex> lock(_mtx);
+    _count.bad_crc++;
+    return;
+  }
+
+  uint8_t out[MAX_FRAME];
+  size_t  n = 0;
+  {
+    std::lock_guard<std::mutex> lock(_mtx);
+    if (req.slave < _p.slave || req.slave - _p.slave >= _p.slaves) {
+      _count.foreign++;
+      return;
+    }
+    _count.rx++;
+    if (std::uniform_real_distribution<double>(0, 1)(_rng) < _p.drop_rate) {
+      _count.dropped++;
+      return;
+    }
+
+    const double gross = _p.gross_kg + _p.ramp_kgps * (nowUs() - _t0Us) / 1e6 - _zero + weightNoise();
+
+    switch (req.fc) {
+      case FC_READ_HREGS: {
+        if (req.value == 0 || req.addr + req.value > REG_COUNT) {
+          n = buildException(out, req.slave, req.fc, EX_ILLEGAL_ADDRESS);
+          break;
+        }
+        uint16_t regs[REG_COUNT];
+        putWeight(regs, REG_DISPLAY_WEIGHT, gross - _tare, _p.counts_per_kg);
+        putWeight(regs, REG_GROSS_WEIGHT,   gross,         _p.counts_per_kg);
+        putWeight(regs, REG_NET_WEIGHT,     gross - _tare, _p.counts_per_kg);
+        putWeight(regs, REG_TARE_VALUE,     _tare,         _p.counts_per_kg);
+        n = buildRegsReply(out, req.slave, regs + req.addr, req.value);
+        break;
+      }
+
+      case FC_READ_COILS: {
+        if (req.value == 0 || req.addr + req.value > COIL_COUNT) {
+          n = buildException(out, req.slave, req.fc, EX_ILLEGAL_ADDRESS);
+          break;
+        }
+        bool coils[64] = {};
+        const uint16_t count = req.value > 64 ? 64 : req.value;
+        for (uint16_t i = 0; i < count; i++)
+          coils[i] = (req.addr + i == COIL_WEIGHT_STABLE) && _p.ramp_kgps == 0;
+        n = buildCoilsReply(out, req.slave, coils, count);
+        break;
+      }
+
+      case FC_WRITE_COIL: {
+        if (req.value != COIL_ON && req.value != COIL_OFF) {
+          n = buildException(out, req.slave, req.fc, EX_ILLEGAL_VALUE);
+          break;
+        }
+        const bool on = req.value == COIL_ON;
+        if      (req.addr == COIL_TARE)       { if (on) _tare = gross; }
+        else if (req.addr == COIL_CLEAR_TARE) { if (on) _tare = 0; }
+        else if (req.addr == COIL_ZERO)       { if (on) _zero += gross; }
+        else {
+          n = buildException(out, req.slave, req.fc, EX_ILLEGAL_ADDRESS);
+          break;
+        }
+        n = buildWriteCoilReply(out, req);
+        break;
+      }
+
+      default:
+        n = buildException(out, req.slave, req.fc, EX_ILLEGAL_FUNCTION);
+        break;
+    }
+    if (out[1] & FC_EXCEPTION) _count.exceptions++;
+  }
+
+  reply(out, n, len);
+}
+
+void MarelEmulator::reply(uint8_t* frame, size_t len, size_t requestLen) {
+  // The pty delivers instantly: wait out what the RS-485 line would take
+  const uint32_t charUs = charTimeUs(_p.baud);
+  const uint64_t waitUs = (uint64_t)requestLen * charUs + frameGapUs(_p.baud)
+                        + (uint64_t)_p.response_ms * 1000 + (uint64_t)len * charUs;
+  std::this_thread::sleep_for(std::chrono::microseconds(waitUs));
+
+  {
+    std::lock_guard<std::mutex> lock(_mtx);
+    if (std::uniform_real_distribution<double>(0, 1)(_rng) < _p.corrupt_rate) {
+      const size_t byte = std::uniform_int_distribution<size_t>(0, len - 1)(_rng);
+      frame[byte] ^= (uint8_t)(1 << std::uniform_int_distribution<int>(0, 7)(_rng));
+      _count.corrupted++;
+    }
+    _count.tx++;
+  }
+
+  size_t done = 0;
+  while (done < len) {
+    const ssize_t n = write(_master, frame + done, len - done);
+    if (n <= 0) break;
+    done += n;
+  }
+}
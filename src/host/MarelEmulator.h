@@ -0,0 +1,85 @@
+#pragma once
+// ============================================================
+// MarelEmulator  —  Marel M2200 Modbus RTU slave on a pty (host)
+//
+// Serves the register/coil map from marel.h:
+//   REG_DISPLAY/GROSS/NET/TARE_WEIGHT  int32 in CDAB word order
+//                                      (reg N = low word), the
+//                                      way MarelClient decodes it
+//   COIL_WEIGHT_STABLE                 read
+//   COIL_ZERO / COIL_TARE / CLEAR_TARE write (momentary)
+// anything else answers ILLEGAL_ADDRESS / ILLEGAL_FUNCTION.
+//
+// Wire behaviour is modelled, not just the data: each reply is
+// held for request + t3.5 + response delay + reply time at the
+// configured baud, and can be dropped or CRC-corrupted at a given
+// rate. Weight can ramp (dosing) and carry Gaussian noise.
+// ============================================================
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <string>
+
+class MarelEmulator {
+public:
+  struct Params {
+    uint8_t  slave         = 1;
+    uint8_t  slaves        = 1;      // answers IDs slave .. slave+slaves-1 (one shared load cell)
+    uint32_t baud          = 9600;
+    uint32_t response_ms   = 5;      // indicator processing time
+    double   gross_kg      = 180.0;  // at t = 0
+    double   ramp_kgps     = 0.0;    // > 0 emulates dosing
+    double   noise_kg      = 0.0;    // 1σ on every weight read
+    double   drop_rate     = 0.0;    // requests left unanswered
+    double   corrupt_rate  = 0.0;    // replies with a flipped bit
+    int32_t  counts_per_kg = 1;      // register units per kg (firmware reads raw = kg)
+    uint32_t seed          = 1;
+  };
+
+  struct Counters {
+    uint64_t rx;          // valid requests for our slave IDs
+    uint64_t tx;          // replies sent (incl. exceptions and corrupted)
+    uint64_t dropped;
+    uint64_t corrupted;
+    uint64_t bad_crc;     // requests that failed CRC
+    uint64_t foreign;     // requests for other slave IDs
+    uint64_t exceptions;
+  };
+
+  explicit MarelEmulator(const Params& p);
+  ~MarelEmulator();
+
+  /** Opens the pty; linkPath (optional) gets a symlink to it. False on error. */
+  bool open(const char* linkPath = nullptr);
+
+  /** Path the client opens (/dev/pts/N). */
+  const char* path() const { return _path.c_str(); }
+
+  /** Serves requests until stop becomes true. */
+  void serve(const std::atomic<bool>& stop);
+
+  /** Weight the scale shows right now (no noise), kg. */
+  double grossKg();
+  double tareKg();
+
+  Counters counters();
+
+private:
+  void   handle(const uint8_t* frame, size_t len);
+  void   reply(uint8_t* frame, size_t len, size_t requestLen);
+  double weightNoise();
+
+  Params      _p;
+  int         _master = -1;
+  int         _slaveHold = -1;   // keeps the pty alive between client opens
+  std::string _path;
+  std::string _link;
+
+  std::mutex  _mtx;              // _tare/_zero/_counters vs. main-thread readers
+  double      _tare = 0;
+  double      _zero = 0;
+  uint64_t    _t0Us = 0;
+  Counters    _count = {};
+  std::mt19937 _rng;
+};
@@ -0,0 +1,289 @@
+// ============================================================
+// marel_bench.cpp  —  MarelClient ↔ M2200 emulator benchmark (host)
+//
+// Builds the firmware's MarelClient (src/marel.cpp) unchanged on
+// top of the host Arduino/ModbusRTU shims and drives it against
+// MarelEmulator over a pty, or against any tty with --port (a
+// real indicator behind a USB-RS485 adapter).
+//
+//   pio run -e native_marel
+//   P=.pio/build/native_marel/program
+//   $P --n 500 --op mix
+//   $P --drop 0.02 --corrupt 0.01 --json        # timeout handling
+//   $P --baud 19200 --response-ms 2             # faster indicator
+//   $P --serve --link /tmp/marel0               # emulator only
+//   $P --port /tmp/marel0 --n 200               # client only
+//   $P --scales 3 --poll --op net                # shared bus: scale 0 dosing,
+//                                                #   the rest polled as idle
+// ============================================================
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "../marel.h"
+#include "../ScaleBus.h"
+#include "../Debug.h"
+#include "../Metrics.h"
+#include "../core/LogHistogram.h"
+#include "MarelEmulator.h"
+
+static std::atomic<bool> s_stop{false};
+
+static void onSignal(int) { s_stop = true; }
+
+enum Op : uint8_t { OP_NET, OP_GROSS, OP_TARE_READ, OP_STABLE, OP_SET_TARE, OP_MIX };
+
+static const char* OP_NAMES[] = {"net", "gross", "tare", "stable", "settare", "mix"};
+
+struct Options {
+  MarelEmulator::Params emu;
+  const char* port    = nullptr;   // external tty instead of the emulator
+  const char* link    = nullptr;
+  bool        serve   = false;
+  bool        json    = false;
+  bool        metrics = false;
+  uint32_t    n       = 300;
+  Op          op      = OP_MIX;
+  uint8_t     scales  = 1;         // handles on the bus, slave IDs slave..
+  bool        poll    = false;     // background polling (ScaleBus::task)
+};
+
+// Per-scale view of the background polls: how often latest() changed
+// and the longest it went without a fresh reading
+struct ScaleStats {
+  uint32_t updates  = 0;
+  uint32_t maxAgeMs = 0;
+  uint32_t stampMs  = 0;
+};
+
+static void track(MarelClient& scale, ScaleStats& st) {
+  uint32_t age = 0;
+  if (!scale.latest(&age).ok) return;
+  const uint32_t stamp = millis() - age;
+  if (stamp != st.stampMs) {
+    st.updates++;
+    st.stampMs = stamp;
+  }
+  if (age > st.maxAgeMs) st.maxAgeMs = age;
+}
+
+// ── One transaction through MarelClient ──────────────────────────────────────
+// Controller::getWeight() reads NET once per loop pass and the stable flag
+// now and then; "mix" follows that ratio.
+static Op pick(Op op, uint32_t i) {
+  if (op != OP_MIX) return op;
+  switch (i % 6) {
+    case 4:  return OP_STABLE;
+    case 5:  return OP_GROSS;
+    default: return OP_NET;
+  }
+}
+
+static float run(MarelClient& marel, Op op) {
+  switch (op) {
+    case OP_NET:       return marel.getNetWeightKg();
+    case OP_GROSS:     return marel.getWeightKg();
+    case OP_TARE_READ: return marel.getTareKg();
+    case OP_STABLE:    return marel.isWeightStable() ? 1.0f : 0.0f;
+    case OP_SET_TARE:  return marel.setTare() ? 1.0f : 0.0f;
+    default:           return 0.0f;
+  }
+}
+
+// Same counters the device exports on /metrics, compared before/after
+static uint32_t failures() {
+  return Metrics::get(Metrics::MODBUS_TIMEOUTS) + Metrics::get(Metrics::MODBUS_ERRORS)
+       + Metrics::get(Metrics::MODBUS_QUEUE_FAILS);
+}
+
+// A transaction the library expired (not one of the background polls)
+// that MarelClient still reported as answered: the caller got the
+// previous register values. Must stay 0; main() fails otherwise.
+static uint32_t libraryTimeouts() {
+  return ModbusRTU::counters().timeouts - Metrics::get(Metrics::MODBUS_POLL_FAILS);
+}
+
+// ── Report ───────────────────────────────────────────────────────────────────
+static const char* PRIO_NAMES[] = {"active", "idle", "off"};
+
+static void report(const Options& o, const LogHistogram& lat, uint32_t ok, uint32_t failed,
+                   uint32_t stale, double wallS, MarelEmulator* emu, MarelClient** scales, const ScaleStats* stats) {
+  const ModbusRTU::Counters& mc = ModbusRTU::counters();
+  const double tps = wallS > 0 ? ok / wallS : 0;
+
+  if (o.json) {
+    printf("{\n  \"op\": \"%s\",\n  \"baud\": %u,\n  \"transactions\": %u,\n  \"ok\": %u,\n"
+           "  \"timeouts\": %u,\n  \"errors\": %u,\n  \"queue_fails\": %u,\n  \"stale\": %u,\n  \"crc_errors\": %u,\n  \"unexpected\": %u,\n"
+           "  \"wall_s\": %.3f,\n  \"frames_per_s\": %.1f,\n",
+           OP_NAMES[o.op], o.emu.baud, o.n, ok, Metrics::get(Metrics::MODBUS_TIMEOUTS),
+           Metrics::get(Metrics::MODBUS_ERRORS), Metrics::get(Metrics::MODBUS_QUEUE_FAILS), stale, mc.crcErrors, mc.unexpected, wallS, tps);
+    printf("  \"latency_us\": {\"min\": %u, \"p50\": %u, \"p95\": %u, \"p99\": %u, \"max\": %u, \"mean\": %u}",
+           lat.min(), lat.percentile(0.50f), lat.percentile(0.95f), lat.percentile(0.99f), lat.max(), lat.mean());
+    if (o.poll) {
+      printf(",\n  \"polls\": %u,\n  \"poll_fails\": %u,\n  \"scales\": [",
+             Metrics::get(Metrics::MODBUS_POLLS), Metrics::get(Metrics::MODBUS_POLL_FAILS));
+      for (uint8_t i = 0; i < o.scales; i++) {
+        printf("%s\n    {\"slave\": %u, \"priority\": \"%s\", \"updates\": %u, \"updates_per_s\": %.1f, "
+               "\"max_age_ms\": %u}", i ? "," : "", scales[i]->slaveID(), PRIO_NAMES[scales[i]->priority()],
+               stats[i].updates, wallS > 0 ? stats[i].updates / wallS : 0, stats[i].maxAgeMs);
+      }
+      printf("\n  ]");
+    }
+    if (emu) {
+      const MarelEmulator::Counters ec = emu->counters();
+      printf(",\n  \"emulator\": {\"rx\": %llu, \"tx\": %llu, \"dropped\": %llu, \"corrupted\": %llu, "
+             "\"bad_crc\": %llu, \"exceptions\": %llu}",
+             (unsigned long long)ec.rx, (unsigned long long)ec.tx, (unsigned long long)ec.dropped,
+             (unsigned long long)ec.corrupted, (unsigned long long)ec.bad_crc, (unsigned long long)ec.exceptions);
+    }
+    printf("\n}\n");
+  } else {
+    printf("op %-8s %u transactions in %.2f s @ %u baud\n", OP_NAMES[o.op], o.n, wallS, o.emu.baud);
+    printf("  ok          %u  (%.1f frames/s)\n", ok, tps);
+    printf("  failed      %u  (timeouts %u, errors %u, queue fails %u)  crc errors %u  unexpected %u\n", failed,
+           Metrics::get(Metrics::MODBUS_TIMEOUTS), Metrics::get(Metrics::MODBUS_ERRORS),
+           Metrics::get(Metrics::MODBUS_QUEUE_FAILS), mc.crcErrors, mc.unexpected);
+    printf("  stale       %u%s\n", stale, stale ? "  ← expired transactions reported as answered" : "");
+    printf("  latency µs  min %u  p50 %u  p95 %u  p99 %u  max %u\n",
+           lat.min(), lat.percentile(0.50f), lat.percentile(0.95f), lat.percentile(0.99f), lat.max());
+    if (o.poll) {
+      printf("  polls       %u  (failed %u)\n", Metrics::get(Metrics::MODBUS_POLLS),
+             Metrics::get(Metrics::MODBUS_POLL_FAILS));
+      for (uint8_t i = 0; i < o.scales; i++) {
+        printf("  slave %-3u   %-6s  %u updates (%.1f/s)  max age %u ms\n", scales[i]->slaveID(),
+               PRIO_NAMES[scales[i]->priority()], stats[i].updates,
+               wallS > 0 ? stats[i].updates / wallS : 0, stats[i].maxAgeMs);
+      }
+    }
+    if (emu) {
+      const MarelEmulator::Counters ec = emu->counters();
+      printf("  emulator    rx %llu  tx %llu  dropped %llu  corrupted %llu  bad crc %llu\n",
+             (unsigned long long)ec.rx, (unsigned long long)ec.tx, (unsigned long long)ec.dropped,
+             (unsigned long long)ec.corrupted, (unsigned long long)ec.bad_crc);
+    }
+  }
+  if (o.metrics) Metrics::render(Serial);
+}
+
+// ── CLI ──────────────────────────────────────────────────────────────────────
+static void usage() {
+  printf("usage: marel_bench [--n N] [--op net|gross|tare|stable|settare|mix] [--json] [--metrics]\n"
+         "                   [--baud B] [--response-ms N] [--noise-kg X] [--ramp-kgps X]\n"
+         "                   [--drop P] [--corrupt P] [--slave ID] [--seed S] [--verbose]\n"
+         "                   [--scales N [--poll]]\n"
+         "                   [--serve [--link PATH]] | [--port TTY]\n");
+}
+
+static bool parse(int argc, char** argv, Options& o) {
+  for (int i = 1; i < argc; i++) {
+    const char* a = argv[i];
+    const char* v = i + 1 < argc ? argv[i + 1] : nullptr;
+    auto takes = [&](const char* name) { if (strcmp(a, name) || !v) return false; i++; return true; };
+
+    if      (!strcmp(a, "--serve"))     o.serve = true;
+    else if (!strcmp(a, "--json"))      o.json = true;
+    else if (!strcmp(a, "--metrics"))   o.metrics = true;
+    else if (!strcmp(a, "--poll"))      o.poll = true;
+    else if (!strcmp(a, "--verbose"))   Log::levels[LOG_MOD_MAREL] = LOG_LVL_VERBOSE;
+    else if (takes("--n"))              o.n = strtoul(v, nullptr, 10);
+    else if (takes("--port"))           o.port = v;
+    else if (takes("--link"))           o.link = v;
+    else if (takes("--baud"))           o.emu.baud = strtoul(v, nullptr, 10);
+    else if (takes("--response-ms"))    o.emu.response_ms = strtoul(v, nullptr, 10);
+    else if (takes("--noise-kg"))       o.emu.noise_kg = atof(v);
+    else if (takes("--ramp-kgps"))      o.emu.ramp_kgps = atof(v);
+    else if (takes("--drop"))           o.emu.drop_rate = atof(v);
+    else if (takes("--corrupt"))        o.emu.corrupt_rate = atof(v);
+    else if (takes("--slave"))          o.emu.slave = (uint8_t)strtoul(v, nullptr, 10);
+    else if (takes("--seed"))           o.emu.seed = strtoul(v, nullptr, 10);
+    else if (takes("--scales"))         o.scales = (uint8_t)strtoul(v, nullptr, 10);
+    else if (takes("--op")) {
+      uint8_t k = 0;
+      while (k <= OP_MIX && strcmp(v, OP_NAMES[k])) k++;
+      if (k > OP_MIX) return false;
+      o.op = (Op)k;
+    }
+    else return false;
+  }
+  if (o.scales < 1 || o.scales > ScaleBus::MAX_SCALES) return false;
+  o.emu.slaves = o.scales;
+  return true;
+}
+
+int main(int argc, char** argv) {
+  Options o;
+  if (!parse(argc, argv, o)) {
+    usage();
+    return 2;
+  }
+  signal(SIGINT, onSignal);
+  signal(SIGTERM, onSignal);
+
+  // ── Emulator ──────────────────────────────────────────────────
+  MarelEmulator* emu = nullptr;
+  std::thread    emuThread;
+  if (!o.port) {
+    emu = new MarelEmulator(o.emu);
+    if (!emu->open(o.link)) return 1;
+    if (o.serve) {
+      printf("M2200 emulator: slave %u on %s%s%s (Ctrl-C to stop)\n", o.emu.slave, emu->path(),
+             o.link ? " → " : "", o.link ? o.link : "");
+      fflush(stdout);
+      emu->serve(s_stop);
+      const MarelEmulator::Counters ec = emu->counters();
+      printf("rx %llu  tx %llu  dropped %llu  corrupted %llu  bad crc %llu\n",
+             (unsigned long long)ec.rx, (unsigned long long)ec.tx, (unsigned long long)ec.dropped,
+             (unsigned long long)ec.corrupted, (unsigned long long)ec.bad_crc);
+      delete emu;
+      return 0;
+    }
+    emuThread = std::thread([emu] { emu->serve(s_stop); });
+  }
+
+  // ── Client: the firmware's ScaleBus + MarelClient, unchanged ──
+  // Commands go to the scales in turn; with --poll scale 0 is the
+  // one dosing (ACTIVE) and the others wait for a tote (IDLE).
+  Serial1.setDevice(o.port ? o.port : emu->path());
+  ScaleBus     bus(18, 17, 8);
+  MarelClient* scales[ScaleBus::MAX_SCALES] = {};
+  ScaleStats   stats[ScaleBus::MAX_SCALES];
+  for (uint8_t i = 0; i < o.scales; i++) {
+    scales[i] = new MarelClient(o.emu.slave + i, bus);
+    scales[i]->begin();
+    if (o.poll) scales[i]->setPriority(i == 0 ? MarelClient::POLL_ACTIVE : MarelClient::POLL_IDLE);
+  }
+
+  LogHistogram lat;
+  uint32_t ok = 0, stale = 0;
+  const auto t0 = std::chrono::steady_clock::now();
+
+  uint32_t done = 0;
+  for (; done < o.n && !s_stop; done++) {
+    bus.task();   // Controller::update() runs this every loop pass
+    for (uint8_t i = 0; i < o.scales; i++) track(*scales[i], stats[i]);
+    MarelClient& marel = *scales[o.poll ? 0 : done % o.scales];
+    const uint32_t before = failures();
+    const uint32_t expired = libraryTimeouts();
+    const uint32_t us0 = micros();
+    run(marel, pick(o.op, done));
+    const uint32_t us = micros() - us0;
+    if (failures() == before) {
+      if (libraryTimeouts() != expired) stale++;
+      ok++;
+      lat.record(us);
+    }
+  }
+
+  const double wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  s_stop = true;
+  if (emuThread.joinable()) emuThread.join();
+
+  report(o, lat, ok, done - ok, stale, wallS, emu, scales, stats);
+  for (uint8_t i = 0; i < o.scales; i++) delete scales[i];
+  delete emu;
+  return stale ? 1 : 0;
+}
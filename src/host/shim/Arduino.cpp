@@ -0,0 +1,113 @@
+// ============================================================
+// Arduino.cpp (host)  —  Clock and serial ports for native envs
+// ============================================================
+#include "Arduino.h"
+#include <chrono>
+#include <thread>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <errno.h>
+
+static const auto s_boot = std::chrono::steady_clock::now();
+static bool     s_simulated = false;
+static uint64_t s_simUs     = 0;
+
+namespace HostTime {
+  void simulate()              { s_simulated = true; }
+  void advanceUs(uint64_t us)  { s_simUs += us; }
+  uint64_t nowUs() {
+    if (s_simulated) return s_simUs;
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - s_boot).count();
+  }
+}
+
+uint32_t millis() { return (uint32_t)(HostTime::nowUs() / 1000); }
+uint32_t micros() { return (uint32_t)HostTime::nowUs(); }
+
+void delay(uint32_t ms) {
+  if (s_simulated) HostTime::advanceUs((uint64_t)ms * 1000);
+  else             std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+void delayMicroseconds(uint32_t us) {
+  if (s_simulated) HostTime::advanceUs(us);
+  else             std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+void yield() { if (!s_simulated) std::this_thread::yield(); }
+
+HardwareSerial Serial(STDOUT_FILENO);
+HardwareSerial Serial1;
+
+// ── HardwareSerial over a POSIX tty ──────────────────────────────────────────
+static speed_t toSpeed(uint32_t baud) {
+  switch (baud) {
+    case 1200:   return B1200;
+    case 2400:   return B2400;
+    case 4800:   return B4800;
+    case 9600:   return B9600;
+    case 19200:  return B19200;
+    case 38400:  return B38400;
+    case 57600:  return B57600;
+    case 115200: return B115200;
+    default:     return B9600;
+  }
+}
+
+void HardwareSerial::begin(uint32_t baud, uint32_t, int8_t, int8_t) {
+  _baud = baud;
+  if (!_path) return;   // Serial (stdout) needs no setup
+  _fd = open(_path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+  if (_fd < 0) {
+    fprintf(stderr, "[host] cannot open %s: %s\n", _path, strerror(errno));
+    return;
+  }
+  // Raw 8N1: no echo, no CR/LF translation. A pty ignores the speed;
+  // a real USB-RS485 adapter honours it.
+  termios tio;
+  if (tcgetattr(_fd, &tio) == 0) {
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, toSpeed(baud));
+    cfsetospeed(&tio, toSpeed(baud));
+    tio.c_cflag |= CLOCAL | CREAD;
+    tcsetattr(_fd, TCSANOW, &tio);
+  }
+  _rxHead = _rxTail = 0;
+}
+
+void HardwareSerial::end() {
+  if (_fd > STDERR_FILENO) close(_fd);
+  _fd = -1;
+}
+
+void HardwareSerial::fill() {
+  if (_fd < 0 || _rxHead != _rxTail) return;
+  const ssize_t n = ::read(_fd, _rx, sizeof(_rx));
+  _rxHead = 0;
+  _rxTail = n > 0 ? (size_t)n : 0;
+}
+
+int HardwareSerial::available() {
+  fill();
+  return (int)(_rxTail - _rxHead);
+}
+
+int HardwareSerial::read() {
+  fill();
+  return _rxHead < _rxTail ? _rx[_rxHead++] : -1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buf, size_t len) {
+  if (_fd < 0) return 0;
+  size_t done = 0;
+  while (done < len) {
+    const ssize_t n = ::write(_fd, buf + done, len - done);
+    if (n > 0) done += n;
+    else if (n < 0 && errno != EAGAIN && errno != EINTR) break;
+  }
+  return done;
+}
+
+void HardwareSerial::flush() {
+  if (_fd > STDERR_FILENO) tcdrain(_fd);
+}
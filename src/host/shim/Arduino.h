@@ -0,0 +1,144 @@
+#pragma once
+// ============================================================
+// Arduino.h (host)  —  Minimal Arduino-ESP32 surface for native envs
+//
+// Only what the modules built off-target actually use: timing,
+// pin stubs, String, PROGMEM, Print/Stream and HardwareSerial.
+// Serial prints to stdout; Serial1 is a POSIX tty (a pty from the
+// M2200 emulator or a USB-RS485 adapter) chosen with
+// Serial1.setDevice().
+//
+// Found before the framework headers via -Isrc/host/shim.
+// ============================================================
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <functional>
+#include <algorithm>
+#include <mutex>
+#include "WString.h"
+
+typedef uint8_t byte;
+using std::min;   // arduino-esp32 does the same
+using std::max;
+
+// ── Flash constants (one address space on host) ─────────────────────────────
+#define PROGMEM
+#define PSTR(s)           (s)
+#define pgm_read_byte(p)  (*(const uint8_t*)(p))
+#define pgm_read_word(p)  (*(const uint16_t*)(p))
+#define _min(a, b)        ((a) < (b) ? (a) : (b))
+#define _max(a, b)        ((a) > (b) ? (a) : (b))
+
+// ── Timing ───────────────────────────────────────────────────────────────────
+uint32_t millis();
+uint32_t micros();
+void     delay(uint32_t ms);
+void     delayMicroseconds(uint32_t us);
+void     yield();
+
+// Host only: simulated time for the station simulator. After
+// simulate(), millis() / micros() / esp_timer_get_time() read a
+// virtual clock that only advanceUs() (and delay()) moves.
+namespace HostTime {
+  void     simulate();
+  void     advanceUs(uint64_t us);
+  uint64_t nowUs();   // real or simulated µs since start
+}
+
+// ── GPIO (no-ops on host) ────────────────────────────────────────────────────
+#define HIGH   1
+#define LOW    0
+#define INPUT  0x01
+#define OUTPUT 0x03
+#define ANALOG 0xC0
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int  digitalRead(uint8_t) { return LOW; }
+
+// ── FreeRTOS bits referenced by shared headers ───────────────────────────────
+typedef void* TaskHandle_t;
+inline unsigned uxTaskGetStackHighWaterMark(TaskHandle_t) { return 0; }
+
+// Critical sections: a plain mutex (no ISRs, no second core)
+typedef std::mutex portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED {}
+#define portENTER_CRITICAL(mux) (mux)->lock()
+#define portEXIT_CRITICAL(mux)  (mux)->unlock()
+
+// ── Print / Stream ───────────────────────────────────────────────────────────
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buf, size_t len) {
+    size_t n = 0;
+    while (len--) n += write(*buf++);
+    return n;
+  }
+  size_t print(const char* s)     { return write((const uint8_t*)s, strlen(s)); }
+  size_t print(const String& s)   { return write((const uint8_t*)s.c_str(), s.length()); }
+  size_t println(const char* s)   { return print(s) + print("\n"); }
+  size_t println(const String& s) { return print(s) + print("\n"); }
+  size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+    char buf[256];
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+    if (n < 0) return 0;
+    if ((size_t)n < sizeof(buf)) return write((const uint8_t*)buf, n);
+    // Long lines (e.g. /metrics exposition): format again on the heap
+    char* big = new char[n + 1];
+    va_start(ap, fmt);
+    vsnprintf(big, n + 1, fmt, ap);
+    va_end(ap);
+    const size_t w = write((const uint8_t*)big, n);
+    delete[] big;
+    return w;
+  }
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual void flush() {}
+};
+
+// ── Serial ports ─────────────────────────────────────────────────────────────
+#define SERIAL_8N1 0x800001c
+
+class HardwareSerial : public Stream {
+public:
+  explicit HardwareSerial(int fd = -1) : _fd(fd) {}
+
+  /** Host only: tty to open on begin() (pty path or /dev/ttyUSBx). */
+  void setDevice(const char* path) { _path = path; }
+
+  void   begin(uint32_t baud, uint32_t config = SERIAL_8N1, int8_t rxPin = -1, int8_t txPin = -1);
+  void   end();
+  int    available() override;
+  int    read() override;
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* buf, size_t len) override;
+  void   flush() override;
+  uint32_t baudRate() const { return _baud; }
+  operator bool() const { return _fd >= 0; }
+
+private:
+  int         _fd   = -1;
+  const char* _path = nullptr;
+  uint32_t    _baud = 0;
+  uint8_t     _rx[512];
+  size_t      _rxHead = 0, _rxTail = 0;
+
+  void fill();
+};
+
+extern HardwareSerial Serial;    // stdout
+extern HardwareSerial Serial1;   // Marel RS-485
@@ -0,0 +1,18 @@
+#pragma once
+// Button.h (host)  —  Debounced input stand-in: never pressed.
+// Host programs press buttons through the code's own entry points
+// (e.g. Lane::press()).
+#include <stdint.h>
+
+class Button {
+public:
+  explicit Button(uint8_t pin) : _pin(pin) {}
+  void begin()    {}
+  bool read()     { return false; }
+  bool pressed()  { return false; }
+  bool released() { return false; }
+  bool has_changed() { return false; }
+  uint8_t pin() const { return _pin; }
+private:
+  uint8_t _pin;
+};
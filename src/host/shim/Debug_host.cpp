@@ -0,0 +1,15 @@
+// ============================================================
+// Debug_host.cpp  —  Log::levels for native envs
+//
+// Debug.cpp persists levels through Settings/NVS, which does not
+// exist off-target; host programs only need the level table the
+// LOG_* macros read, set from their own command line.
+// ============================================================
+#include "../../Debug.h"
+
+namespace Log {
+  uint8_t levels[LOG_MOD_COUNT] = {
+    LOG_DEFAULT_MAIN, LOG_DEFAULT_MAREL, LOG_DEFAULT_WS,
+    LOG_DEFAULT_WIFI, LOG_DEFAULT_CTRL,  LOG_DEFAULT_BLE,
+  };
+}
@@ -0,0 +1,20 @@
+#pragma once
+// ============================================================
+// EdgeBox_ESP_100.h (host)  —  I/O names from the board library
+//
+// config.h maps START_IO, WATER_PUMP, ... onto these. On host
+// they are plain channel numbers; nothing is driven.
+// ============================================================
+#include "Arduino.h"
+
+#define DI_0 0
+#define DI_1 1
+#define DI_2 2
+#define DI_3 3
+
+#define DO_0 0
+#define DO_1 1
+#define DO_2 2
+#define DO_3 3
+#define DO_4 4
+#define DO_5 5
@@ -0,0 +1,98 @@
+// ============================================================
+// ModbusRTU.cpp (host)  —  RTU master over a tty
+// ============================================================
+#include "ModbusRTU.h"
+
+using namespace ModbusRtu;
+
+ModbusRTU::Counters ModbusRTU::s_count = {};
+
+bool ModbusRTU::begin(HardwareSerial* port, int16_t) {
+  _port  = port;
+  _gapUs = frameGapUs(port->baudRate() ? port->baudRate() : 9600);
+  return true;
+}
+
+uint16_t ModbusRTU::send(size_t len, uint16_t count, void* dest, cbTransaction cb) {
+  if (_pending || !_port || !*_port) return 0;
+  // Drop anything left on the line (late reply to a timed-out request)
+  while (_port->available()) _port->read();
+  _rxLen   = 0;
+  _count16 = count;
+  _dest    = dest;
+  _cb      = cb;
+  _pending = true;
+  _sentMs  = millis();
+  _port->write(_req, len);
+  s_count.tx++;
+  return ++_transaction ? _transaction : ++_transaction;
+}
+
+uint16_t ModbusRTU::readHreg(uint8_t slaveId, uint16_t offset, uint16_t* value, uint16_t numregs,
+                             cbTransaction cb, uint8_t) {
+  if (_pending) return 0;
+  return send(buildRead(_req, slaveId, FC_READ_HREGS, offset, numregs), numregs, value, cb);
+}
+
+uint16_t ModbusRTU::readCoil(uint8_t slaveId, uint16_t offset, bool* value, uint16_t numregs,
+                             cbTransaction cb, uint8_t) {
+  if (_pending) return 0;
+  return send(buildRead(_req, slaveId, FC_READ_COILS, offset, numregs), numregs, value, cb);
+}
+
+uint16_t ModbusRTU::writeCoil(uint8_t slaveId, uint16_t offset, bool value, cbTransaction cb, uint8_t) {
+  if (_pending) return 0;
+  return send(buildWriteCoil(_req, slaveId, offset, value), 1, nullptr, cb);
+}
+
+void ModbusRTU::task() {
+  if (!_port) return;
+
+  while (_port->available()) {
+    const int c = _port->read();
+    if (_rxLen < sizeof(_rx)) _rx[_rxLen++] = (uint8_t)c;
+    _lastByteUs = micros();
+  }
+
+  // End of frame: t3.5 of silence, or the expected length already in
+  if (_rxLen > 0) {
+    const bool complete = _pending && replyComplete(_req, _count16, _rx, _rxLen);
+    if (complete || micros() - _lastByteUs >= _gapUs) {
+      handleFrame();
+      _rxLen = 0;
+    }
+  }
+
+  if (_pending && millis() - _sentMs >= MODBUSRTU_TIMEOUT) {
+    s_count.timeouts++;
+    finish(Modbus::EX_TIMEOUT);
+  }
+}
+
+void ModbusRTU::handleFrame() {
+  const uint8_t rc = _pending ? decodeReply(_req, _count16, _rx, _rxLen, _dest)
+                              : (checkCrc(_rx, _rxLen) ? REPLY_FOREIGN : REPLY_BAD_CRC);
+  switch (rc) {
+    case REPLY_BAD_CRC:
+      s_count.crcErrors++;
+      return;   // wait for a retry or the timeout
+    case REPLY_FOREIGN:
+      s_count.rx++;
+      s_count.unexpected++;
+      return;
+    case REPLY_BAD_LENGTH:
+      s_count.rx++;
+      finish(Modbus::EX_DATA_MISMACH);
+      return;
+    default:
+      s_count.rx++;
+      finish((Modbus::ResultCode)rc);   // REPLY_OK = EX_SUCCESS, else the exception code
+      return;
+  }
+}
+
+void ModbusRTU::finish(Modbus::ResultCode rc) {
+  _pending = false;
+  if (_cb) _cb(rc, _transaction, nullptr);
+  _cb = nullptr;
+}
@@ -0,0 +1,79 @@
+#pragma once
+// ============================================================
+// ModbusRTU.h (host)  —  emelianov/modbus-esp8266 master subset
+//
+// Same names and semantics as the library calls marel.cpp makes
+// (readHreg / readCoil / writeCoil queue one transaction, task()
+// drives it, slave() != 0 while it is pending, 1 s timeout), on
+// top of core/ModbusRtu.h framing over a HardwareSerial tty.
+// Bad-CRC and foreign frames are discarded, so corruption shows
+// up as a timeout exactly as on the device.
+// ============================================================
+#include "Arduino.h"
+#include "../../core/ModbusRtu.h"
+
+#ifndef MODBUSRTU_TIMEOUT
+#define MODBUSRTU_TIMEOUT 1000
+#endif
+
+namespace Modbus {
+  enum ResultCode : uint8_t {
+    EX_SUCCESS                  = 0x00,
+    EX_ILLEGAL_FUNCTION         = 0x01,
+    EX_ILLEGAL_ADDRESS          = 0x02,
+    EX_ILLEGAL_VALUE            = 0x03,
+    EX_SLAVE_FAILURE            = 0x04,
+    EX_DEVICE_FAILED_TO_RESPOND = 0x0B,
+    EX_GENERAL_FAILURE          = 0xE1,
+    EX_DATA_MISMACH             = 0xE2,
+    EX_UNEXPECTED_RESPONSE      = 0xE3,
+    EX_TIMEOUT                  = 0xE4,
+  };
+}
+
+typedef std::function<bool(Modbus::ResultCode, uint16_t, void*)> cbTransaction;
+
+class ModbusRTU {
+public:
+  bool begin(HardwareSerial* port, int16_t txEnablePin = -1);
+  void master() {}
+  void task();
+
+  /** Slave ID of the pending transaction, 0 when idle. */
+  uint8_t slave() const { return _pending ? _req[0] : 0; }
+
+  uint16_t readHreg(uint8_t slaveId, uint16_t offset, uint16_t* value, uint16_t numregs = 1,
+                    cbTransaction cb = nullptr, uint8_t unit = 1);
+  uint16_t readCoil(uint8_t slaveId, uint16_t offset, bool* value, uint16_t numregs = 1,
+                    cbTransaction cb = nullptr, uint8_t unit = 1);
+  uint16_t writeCoil(uint8_t slaveId, uint16_t offset, bool value,
+                     cbTransaction cb = nullptr, uint8_t unit = 1);
+
+  // Host only: frames seen by all masters, for the Modbus benchmark
+  // (MarelClient keeps its ModbusRTU private)
+  struct Counters {
+    uint32_t tx, rx, crcErrors, unexpected, timeouts;
+  };
+  static const Counters& counters() { return s_count; }
+
+private:
+  uint16_t send(size_t len, uint16_t count, void* dest, cbTransaction cb);
+  void     finish(Modbus::ResultCode rc);
+  void     handleFrame();
+
+  HardwareSerial* _port = nullptr;
+  uint32_t _gapUs   = 0;
+  bool     _pending = false;
+  uint8_t  _req[ModbusRtu::REQUEST_SIZE];
+  uint16_t _count16 = 0;           // registers / coils requested
+  void*    _dest    = nullptr;
+  cbTransaction _cb;
+  uint16_t _transaction = 0;
+  uint32_t _sentMs  = 0;
+
+  uint8_t  _rx[ModbusRtu::MAX_FRAME];
+  size_t   _rxLen   = 0;
+  uint32_t _lastByteUs = 0;
+
+  static Counters s_count;
+};
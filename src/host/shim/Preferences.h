@@ -0,0 +1,21 @@
+#pragma once
+// Preferences.h (host)  —  An empty NVS: every get returns its
+// default and puts are dropped. Settings::load() then starts from
+// config.h, like a freshly erased station.
+#include <stddef.h>
+#include <stdint.h>
+
+class Preferences {
+public:
+  bool     begin(const char*, bool = false, const char* = nullptr) { return true; }
+  void     end() {}
+  float    getFloat(const char*, float def = 0)       { return def; }
+  bool     getBool(const char*, bool def = false)     { return def; }
+  uint16_t getUShort(const char*, uint16_t def = 0)   { return def; }
+  size_t   getBytesLength(const char*)                { return 0; }
+  size_t   getBytes(const char*, void*, size_t)       { return 0; }
+  size_t   putFloat(const char*, float)               { return 0; }
+  size_t   putBool(const char*, bool)                 { return 0; }
+  size_t   putUShort(const char*, uint16_t)           { return 0; }
+  size_t   putBytes(const char*, const void*, size_t) { return 0; }
+};
@@ -0,0 +1,137 @@
+// ============================================================
+// WString.cpp (host)  —  Arduino String for native envs
+// ============================================================
+#include "WString.h"
+#include <stdio.h>
+#include <ctype.h>
+
+static void formatInt(char* out, size_t cap, unsigned long v, bool neg, unsigned char base) {
+  char tmp[34];
+  int i = 0;
+  do {
+    const unsigned d = v % base;
+    tmp[i++] = (char)(d < 10 ? '0' + d : 'a' + d - 10);
+    v /= base;
+  } while (v && i < 33);
+  size_t n = 0;
+  if (neg && n + 1 < cap) out[n++] = '-';
+  while (i && n + 1 < cap) out[n++] = tmp[--i];
+  out[n] = 0;
+}
+
+String::String(int v, unsigned char base)           { init(); char b[34]; formatInt(b, sizeof(b), v < 0 && base == 10 ? -(long)v : (unsigned)v, v < 0 && base == 10, base); copy(b, strlen(b)); }
+String::String(unsigned int v, unsigned char base)  { init(); char b[34]; formatInt(b, sizeof(b), v, false, base); copy(b, strlen(b)); }
+String::String(long v, unsigned char base)          { init(); char b[34]; formatInt(b, sizeof(b), v < 0 && base == 10 ? -(unsigned long)v : (unsigned long)v, v < 0 && base == 10, base); copy(b, strlen(b)); }
+String::String(unsigned long v, unsigned char base) { init(); char b[34]; formatInt(b, sizeof(b), v, false, base); copy(b, strlen(b)); }
+
+String::String(float v, unsigned int decimals)  { init(); char b[48]; snprintf(b, sizeof(b), "%.*f", (int)decimals, (double)v); copy(b, strlen(b)); }
+String::String(double v, unsigned int decimals) { init(); char b[48]; snprintf(b, sizeof(b), "%.*f", (int)decimals, v); copy(b, strlen(b)); }
+
+bool String::reserve(unsigned int size) {
+  if (size <= _cap) return true;
+  char* p = (char*)(_sso ? malloc(size + 1) : realloc(_ptr, size + 1));
+  if (!p) return false;
+  if (_sso) memcpy(p, _buf, _len + 1);
+  _ptr = p;
+  _sso = false;
+  _cap = size;
+  return true;
+}
+
+void String::copy(const char* c, unsigned int n) {
+  if (!reserve(n)) return;
+  memmove(data(), c, n);
+  _len = n;
+  data()[n] = 0;
+}
+
+void String::move(String& s) {
+  if (!_sso) free(_ptr);
+  if (s._sso) {
+    memcpy(_buf, s._buf, s._len + 1);
+    _sso = true;
+    _cap = SSO_CAP;
+  } else {
+    _ptr = s._ptr;
+    _sso = false;
+    _cap = s._cap;
+  }
+  _len = s._len;
+  s.init();
+}
+
+bool String::concat(const char* c, unsigned int n) {
+  if (n == 0) return true;
+  // c may point into our own buffer (s += s): remember the offset across realloc
+  const char* base = c_str();
+  const bool  self = c >= base && c < base + _len + 1;
+  const size_t off = self ? (size_t)(c - base) : 0;
+  if (!reserve(_len + n)) return false;
+  if (self) c = c_str() + off;
+  memmove(data() + _len, c, n);
+  _len += n;
+  data()[_len] = 0;
+  return true;
+}
+
+int String::indexOf(char c, unsigned int from) const {
+  if (from >= _len) return -1;
+  const char* p = strchr(c_str() + from, c);
+  return p ? (int)(p - c_str()) : -1;
+}
+
+int String::indexOf(const String& s, unsigned int from) const {
+  if (from > _len) return -1;
+  const char* p = strstr(c_str() + from, s.c_str());
+  return p ? (int)(p - c_str()) : -1;
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+  if (from > to) { unsigned int t = from; from = to; to = t; }
+  if (from >= _len) return String();
+  if (to > _len) to = _len;
+  String r;
+  r.copy(c_str() + from, to - from);
+  return r;
+}
+
+void String::replace(const String& find, const String& repl) {
+  if (_len == 0 || find._len == 0) return;
+  // Same strategy as arduino-esp32: count, grow once, then rewrite in place
+  const char* s = c_str();
+  unsigned int hits = 0;
+  for (const char* p = strstr(s, find.c_str()); p; p = strstr(p + find._len, find.c_str())) hits++;
+  if (!hits) return;
+
+  const unsigned int newLen = _len + hits * repl._len - hits * find._len;
+  String out;
+  out.reserve(newLen);
+  const char* from = c_str();
+  for (const char* p = strstr(from, find.c_str()); p; p = strstr(from, find.c_str())) {
+    out.concat(from, (unsigned int)(p - from));
+    out.concat(repl.c_str(), repl._len);
+    from = p + find._len;
+  }
+  out.concat(from, (unsigned int)(c_str() + _len - from));
+  move(out);
+}
+
+void String::trim() {
+  const char* s = c_str();
+  unsigned int b = 0, e = _len;
+  while (b < e && isspace((unsigned char)s[b])) b++;
+  while (e > b && isspace((unsigned char)s[e - 1])) e--;
+  if (b == 0 && e == _len) return;
+  memmove(data(), s + b, e - b);
+  _len = e - b;
+  data()[_len] = 0;
+}
+
+void String::toCharArray(char* buf, unsigned int size, unsigned int index) const {
+  if (!buf || size == 0) return;
+  if (index >= _len) { buf[0] = 0; return; }
+  unsigned int n = _len - index;
+  if (n > size - 1) n = size - 1;
+  memcpy(buf, c_str() + index, n);
+  buf[n] = 0;
+}
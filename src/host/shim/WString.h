@@ -0,0 +1,94 @@
+#pragma once
+// ============================================================
+// WString.h (host)  —  Arduino String for native envs
+//
+// Same heap behaviour as arduino-esp32's WString where it matters
+// for the allocation benchmarks: short strings (≤ 11 chars) live
+// inline (SSO), longer ones in a malloc/realloc'ed buffer that
+// grows to fit. Only the members firmware code and ArduinoJson's
+// String adapters use are implemented.
+// ============================================================
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+class String {
+public:
+  String(const char* cstr = "") { init(); if (cstr) copy(cstr, strlen(cstr)); }
+  String(const String& s)       { init(); copy(s.c_str(), s.length()); }
+  String(String&& s)            { init(); move(s); }
+  explicit String(char c)       { init(); char b[2] = {c, 0}; copy(b, 1); }
+  explicit String(int v, unsigned char base = 10);
+  explicit String(unsigned int v, unsigned char base = 10);
+  explicit String(long v, unsigned char base = 10);
+  explicit String(unsigned long v, unsigned char base = 10);
+  explicit String(float v, unsigned int decimals = 2);
+  explicit String(double v, unsigned int decimals = 2);
+  ~String() { if (!_sso) free(_ptr); }
+
+  String& operator=(const String& s) { if (this != &s) copy(s.c_str(), s.length()); return *this; }
+  String& operator=(String&& s)      { if (this != &s) move(s); return *this; }
+  String& operator=(const char* c)   { if (c) copy(c, strlen(c)); else clear(); return *this; }
+
+  bool reserve(unsigned int size);
+  unsigned int length() const { return _len; }
+  bool         isEmpty() const { return _len == 0; }
+  const char*  c_str() const { return _sso ? _buf : _ptr; }
+
+  bool concat(const String& s)         { return concat(s.c_str(), s.length()); }
+  bool concat(const char* c)           { return c ? concat(c, strlen(c)) : false; }
+  bool concat(const char* c, unsigned int n);
+  bool concat(char c)                  { return concat(&c, 1); }
+  bool concat(int v)                   { return concat(String(v)); }
+  bool concat(unsigned int v)          { return concat(String(v)); }
+  bool concat(long v)                  { return concat(String(v)); }
+  bool concat(unsigned long v)         { return concat(String(v)); }
+  bool concat(float v)                 { return concat(String(v)); }
+  bool concat(double v)                { return concat(String(v)); }
+
+  template <class T> String& operator+=(const T& v) { concat(v); return *this; }
+
+  char  operator[](unsigned int i) const { return i < _len ? c_str()[i] : 0; }
+  char& operator[](unsigned int i)       { return data()[i]; }
+
+  bool equals(const String& s) const   { return _len == s._len && memcmp(c_str(), s.c_str(), _len) == 0; }
+  bool equals(const char* c) const     { return c && strcmp(c_str(), c) == 0; }
+  bool operator==(const String& s) const { return equals(s); }
+  bool operator==(const char* c) const   { return equals(c); }
+  bool operator!=(const String& s) const { return !equals(s); }
+  bool operator!=(const char* c) const   { return !equals(c); }
+  bool startsWith(const String& s) const { return s._len <= _len && memcmp(c_str(), s.c_str(), s._len) == 0; }
+  bool endsWith(const String& s) const   { return s._len <= _len && memcmp(c_str() + _len - s._len, s.c_str(), s._len) == 0; }
+
+  int    indexOf(char c, unsigned int from = 0) const;
+  int    indexOf(const String& s, unsigned int from = 0) const;
+  String substring(unsigned int from) const { return substring(from, _len); }
+  String substring(unsigned int from, unsigned int to) const;
+  void   replace(const String& find, const String& repl);
+  void   trim();
+  long   toInt() const   { return atol(c_str()); }
+  float  toFloat() const { return (float)atof(c_str()); }
+  void   toCharArray(char* buf, unsigned int size, unsigned int index = 0) const;
+
+private:
+  static const unsigned int SSO_CAP = 11;   // + NUL, as on arduino-esp32
+
+  union {
+    char  _buf[SSO_CAP + 1];
+    char* _ptr;
+  };
+  unsigned int _len;
+  unsigned int _cap;
+  bool         _sso;
+
+  void  init()  { _sso = true; _buf[0] = 0; _len = 0; _cap = SSO_CAP; }
+  void  clear() { _len = 0; data()[0] = 0; }
+  char* data()  { return _sso ? _buf : _ptr; }
+  void  copy(const char* c, unsigned int n);
+  void  move(String& s);
+};
+
+inline String operator+(const String& a, const String& b) { String r(a); r.concat(b); return r; }
+inline String operator+(const String& a, const char* b)   { String r(a); r.concat(b); return r; }
+inline String operator+(const char* a, const String& b)   { String r(a); r.concat(b); return r; }
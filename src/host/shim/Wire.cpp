@@ -0,0 +1,6 @@
+// ============================================================
+// Wire.cpp (host)
+// ============================================================
+#include "Wire.h"
+
+TwoWire Wire;
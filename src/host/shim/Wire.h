@@ -0,0 +1,26 @@
+#pragma once
+// ============================================================
+// Wire.h (host)  —  I2C master that only counts traffic
+//
+// Enough for the display library's SSD1306Wire to run its
+// display() path off-target: every byte that would go on the
+// bus is counted, nothing is sent.
+// ============================================================
+#include <Arduino.h>
+
+class TwoWire {
+public:
+  bool    begin(int sda = -1, int scl = -1, uint32_t freq = 0) { (void)sda; (void)scl; (void)freq; return true; }
+  void    end() {}
+  void    setClock(uint32_t) {}
+  void    beginTransmission(uint8_t) { transactions++; }
+  uint8_t endTransmission(bool = true) { return 0; }
+  size_t  write(uint8_t) { bytes++; return 1; }
+  size_t  write(const uint8_t*, size_t len) { bytes += len; return len; }
+
+  // ── Host only ──────────────────────────────────────────────
+  uint32_t transactions = 0;
+  uint32_t bytes        = 0;
+};
+
+extern TwoWire Wire;
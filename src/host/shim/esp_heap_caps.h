@@ -0,0 +1,14 @@
+#pragma once
+// esp_heap_caps.h (host)  —  heap queries report 0 off-target
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+
+inline size_t heap_caps_get_free_size(uint32_t)          { return 0; }
+inline size_t heap_caps_get_minimum_free_size(uint32_t)  { return 0; }
+inline size_t heap_caps_get_largest_free_block(uint32_t) { return 0; }
+inline void*  heap_caps_malloc(size_t size, uint32_t)    { return malloc(size); }
@@ -0,0 +1,6 @@
+#pragma once
+// esp_timer.h (host)  —  µs since process start (simulated under HostTime::simulate())
+#include <stdint.h>
+#include "Arduino.h"
+
+inline int64_t esp_timer_get_time() { return (int64_t)HostTime::nowUs(); }
@@ -0,0 +1,18 @@
+#pragma once
+// nvs.h (host)  —  Raw NVS calls Settings::flush() uses; writes are
+// accepted and dropped (see Preferences.h).
+#include <stddef.h>
+#include <stdint.h>
+
+typedef int      esp_err_t;
+typedef uint32_t nvs_handle_t;
+#define ESP_OK        0
+#define NVS_READWRITE 1
+
+inline esp_err_t   nvs_open(const char*, int, nvs_handle_t* h)                  { *h = 1; return ESP_OK; }
+inline esp_err_t   nvs_set_blob(nvs_handle_t, const char*, const void*, size_t) { return ESP_OK; }
+inline esp_err_t   nvs_set_u16(nvs_handle_t, const char*, uint16_t)             { return ESP_OK; }
+inline esp_err_t   nvs_set_u8(nvs_handle_t, const char*, uint8_t)               { return ESP_OK; }
+inline esp_err_t   nvs_commit(nvs_handle_t)                                      { return ESP_OK; }
+inline void        nvs_close(nvs_handle_t)                                       {}
+inline const char* esp_err_to_name(esp_err_t)                                    { return "ESP_FAIL"; }
@@ -1,42 +1,27 @@
+#pragma once
 #include "Stage.h"
 #include "Types.h"
-#include <TaskScheduler.h>
 #include "hardware/Controller.h"
 #include <HTTPClient.h>
 #include <ArduinoJson.h>
 #include "websocket_client.h"
 #include "BLEQRClient.h"
+#include "Lane.h"
 
-void onStop();
-void onStart();
-void onIDLE();
-void onCanceled();
-void onManualIce();
-void onManualWater();
-void onButtonPressed();
-void onWaitingToteID();
-void setToteID(const String& id);
-void handleToteState();
-bool setToteIdFromUI(const String& toteId);
-button_type handleInputs(button_type override = NONE);
-
-void handleIDLE();
-void initStage1();
-void initStage2();
-void initStage3();
+// Shared by every lane (main.cpp)
+extern Controller controller;
+extern ToteWebSocketClient wsClient;
+extern BLEQRClient bleQRClient;
+extern Lane* lanes[LANE_COUNT];
 
-void destroyStage1();
-void destroyStage2();
-void destroyStage3();
-void onToteReady();
-void onIceFilling();
-void onWaterFilling();
+void sendStats();
+void onButtonPressed();
+bool setToteIdFromUI(const char* toteId, uint32_t scannedMs = 0);
 void readButtonTypeFromSerial();
 void communicationTask(void* pvParameters);
 
-// Backend API functions
-bool validateToteIDFromBackend(const String& toteId);
-bool updateToteInBackend(const char* toteId, float raw_kg, float ice_out_kg, float water_out_kg, float temp_out);
+// Backend tote record (PUT /api/totes/<id> body, sent by ToteUploader)
+String totePayload(const char* toteId, float raw_kg, float ice_out_kg, float water_out_kg, float temp_out, const tote_trace* trace = nullptr);
 
 // WebSocket message handler
-void onWebSocketMessage(String type, JsonDocument& doc);
\ No newline at end of file
+void onWebSocketMessage(String type, JsonDocument& doc);
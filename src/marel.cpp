@@ -1,8 +1,11 @@
 #include "marel.h"
+#include <math.h>
+#include "ScaleBus.h"
 #include "Debug.h"
+#include "Metrics.h"
 
-MarelClient::MarelClient(uint8_t slaveID, uint8_t rxPin, uint8_t txPin, uint8_t dePin)
-    : _slaveID(slaveID), _rxPin(rxPin), _txPin(txPin), _dePin(dePin), _initialized(false), _readComplete(false) {
+MarelClient::MarelClient(uint8_t slaveID, ScaleBus& bus)
+    : _bus(bus), _mb(bus.master()), _slaveID(slaveID), _initialized(false) {
     _weightRegs[0] = 0;
     _weightRegs[1] = 0;
     _netWeightRegs[0] = 0;
@@ -12,27 +15,18 @@ MarelClient::MarelClient(uint8_t slaveID, uint8_t rxPin, uint8_t txPin, uint8_t
 }
 
 void MarelClient::begin() {
-    // Configure Serial1 for Modbus RTU on specified pins
-    Serial1.begin(9600, SERIAL_8N1, _rxPin, _txPin);
-    
-    // Configure DE/RE pin
-    pinMode(_dePin, OUTPUT);
-    digitalWrite(_dePin, LOW);  // Reception mode by default
-    
-    // Initialize Modbus as Master
-    _mb.begin(&Serial1, _dePin);
-    _mb.master();
-    
+    if (!_bus.begin()) return;
+    if (!_bus.attach(this)) {
+        LOG_ERR("Marel slave %d: bus full (%d scales)\n", _slaveID, ScaleBus::MAX_SCALES);
+        return;
+    }
     _initialized = true;
-    
-    LOG_MAREL("Modbus RTU Master initialized\n");
-    LOG_MAREL("Slave ID: %d, RX: GPIO%d, TX: GPIO%d, DE/RE: GPIO%d\n", 
-                  _slaveID, _rxPin, _txPin, _dePin);
+    LOG_MAREL("Slave ID: %d attached\n", _slaveID);
 }
 
 void MarelClient::task() {
     if (_initialized) {
-        _mb.task();
+        _bus.task();
     }
 }
 
@@ -45,7 +39,7 @@ float MarelClient::registersToFloat(uint16_t reg0, uint16_t reg1) {
     uint32_t uraw = ((uint32_t)reg1 << 16) | (uint32_t)reg0;
     int32_t  raw  = (int32_t)uraw;          // reinterpret como signed
     float result  = (float)raw;
-    LOG_MAREL("  [Marel] Regs[%04X, %04X] raw=%ld → %.2f kg\n", reg0, reg1, raw, result);
+    LOG_MAREL_V("  [Marel] Regs[%04X, %04X] raw=%ld → %.2f kg\n", reg0, reg1, raw, result);
     return result;
 }
 
@@ -56,82 +50,80 @@ void MarelClient::floatToRegisters(float value, uint16_t &reg0, uint16_t &reg1)
 }
 
 float MarelClient::getWeightKg() {
-    if (!_initialized) return 0.0;
+    if (!ready()) return NAN;
     
     // Read registers 2-3 (Gross Weight)
-    if (!_mb.readHreg(_slaveID, REG_GROSS_WEIGHT, _weightRegs, 2)) {
+    if (!_mb.readHreg(_slaveID, REG_GROSS_WEIGHT, _weightRegs, 2, _bus.command())) {
         LOG_ERR("Failed to queue read request for weight\n");
-        return 0.0;
+        Metrics::inc(Metrics::MODBUS_QUEUE_FAILS);
+        return NAN;
     }
     
-    // Wait for response (1 second timeout)
-    unsigned long start = millis();
-    while (_mb.slave() && (millis() - start) < 1000) {
-        _mb.task();
-        yield();
-    }
+    if (!waitForResponse()) return NAN;
     
     float weight = registersToFloat(_weightRegs[0], _weightRegs[1]);
-    LOG_MAREL("Modbus Read: Regs[%04X, %04X] = %.2f kg\n", _weightRegs[0], _weightRegs[1], weight);
+    LOG_MAREL_V("Modbus Read: Regs[%04X, %04X] = %.2f kg\n", _weightRegs[0], _weightRegs[1], weight);
     return weight;
 }
 
 float MarelClient::getNetWeightKg() {
-    if (!_initialized) return 0.0;
+    if (!_initialized) return NAN;
+
+    // Our own poll is on the line: its answer is as fresh as a new read
+    if (_bus.polling(this)) {
+        const uint32_t before = _latestMs;
+        if (_bus.acquire() && _latest.ok && _latestMs != before) return _latest.kg;
+    }
+    if (!ready()) return NAN;
     
     // Read registers 4-5 (Net Weight)
-    if (!_mb.readHreg(_slaveID, REG_NET_WEIGHT, _netWeightRegs, 2)) {
+    if (!_mb.readHreg(_slaveID, REG_NET_WEIGHT, _netWeightRegs, 2, _bus.command())) {
         LOG_ERR("Failed to queue read request for net weight\n");
-        return 0.0;
+        Metrics::inc(Metrics::MODBUS_QUEUE_FAILS);
+        return NAN;
     }
+    _polledMs = millis();
     
-    // Wait for response
-    unsigned long start = millis();
-    while (_mb.slave() && (millis() - start) < 1000) {
-        _mb.task();
-        yield();
-    }
+    // No answer: the registers still hold the previous read. NAN, never
+    // 0 kg — a full tote reading as empty would re-arm the ToteDetector
+    if (!waitForResponse()) return NAN;
     
     float netWeight = registersToFloat(_netWeightRegs[0], _netWeightRegs[1]);
-    LOG_MAREL("Modbus Read NET: Regs[%04X, %04X] = %.2f kg\n", _netWeightRegs[0], _netWeightRegs[1], netWeight);
+    LOG_MAREL_V("Modbus Read NET: Regs[%04X, %04X] = %.2f kg\n", _netWeightRegs[0], _netWeightRegs[1], netWeight);
+    storeNet(true, netWeight);
     return netWeight;
 }
 
 float MarelClient::getTareKg() {
-    if (!_initialized) return 0.0;
+    if (!ready()) return NAN;
     
     // Read registers 6-7 (Tare Value)
-    if (!_mb.readHreg(_slaveID, REG_TARE_VALUE, _tareRegs, 2)) {
+    if (!_mb.readHreg(_slaveID, REG_TARE_VALUE, _tareRegs, 2, _bus.command())) {
         LOG_ERR("Failed to queue read request for tare\n");
-        return 0.0;
+        Metrics::inc(Metrics::MODBUS_QUEUE_FAILS);
+        return NAN;
     }
     
-    // Wait for response
-    unsigned long start = millis();
-    while (_mb.slave() && (millis() - start) < 1000) {
-        _mb.task();
-        yield();
-    }
+    if (!waitForResponse()) return NAN;
     
     return registersToFloat(_tareRegs[0], _tareRegs[1]);
 }
 
 bool MarelClient::setTare() {
-    if (!_initialized) return false;
+    if (!ready()) return false;
     
     LOG_MAREL("Executing TARE command...\n");
     
     // Write coil 1002 (COIL_TARE) = true
-    if (!_mb.writeCoil(_slaveID, COIL_TARE, true)) {
+    if (!_mb.writeCoil(_slaveID, COIL_TARE, true, _bus.command())) {
         LOG_ERR("Failed to queue TARE command\n");
+        Metrics::inc(Metrics::MODBUS_QUEUE_FAILS);
         return false;
     }
     
-    // Wait for confirmation
-    unsigned long start = millis();
-    while (_mb.slave() && (millis() - start) < 1000) {
-        _mb.task();
-        yield();
+    if (!waitForResponse()) {
+        LOG_ERR("TARE command got no answer\n");
+        return false;
     }
     
     LOG_MAREL("TARE command sent successfully\n");
@@ -139,21 +131,20 @@ bool MarelClient::setTare() {
 }
 
 bool MarelClient::clearTare() {
-    if (!_initialized) return false;
+    if (!ready()) return false;
     
     LOG_MAREL("Executing CLEAR TARE command...\n");
     
     // Write coil 1003 (COIL_CLEAR_TARE) = true
-    if (!_mb.writeCoil(_slaveID, COIL_CLEAR_TARE, true)) {
+    if (!_mb.writeCoil(_slaveID, COIL_CLEAR_TARE, true, _bus.command())) {
         LOG_ERR("Failed to queue CLEAR TARE command\n");
+        Metrics::inc(Metrics::MODBUS_QUEUE_FAILS);
         return false;
     }
     
-    // Wait for confirmation
-    unsigned long start = millis();
-    while (_mb.slave() && (millis() - start) < 1000) {
-        _mb.task();
-        yield();
+    if (!waitForResponse()) {
+        LOG_ERR("CLEAR TARE command got no answer\n");
+        return false;
     }
     
     LOG_MAREL("CLEAR TARE command sent successfully\n");
@@ -161,21 +152,20 @@ bool MarelClient::clearTare() {
 }
 
 bool MarelClient::setZero() {
-    if (!_initialized) return false;
+    if (!ready()) return false;
     
     LOG_MAREL("Executing ZERO command...\n");
     
     // Write coil 1000 (COIL_ZERO) = true
-    if (!_mb.writeCoil(_slaveID, COIL_ZERO, true)) {
+    if (!_mb.writeCoil(_slaveID, COIL_ZERO, true, _bus.command())) {
         LOG_ERR("Failed to queue ZERO command\n");
+        Metrics::inc(Metrics::MODBUS_QUEUE_FAILS);
         return false;
     }
     
-    // Wait for confirmation
-    unsigned long start = millis();
-    while (_mb.slave() && (millis() - start) < 1000) {
-        _mb.task();
-        yield();
+    if (!waitForResponse()) {
+        LOG_ERR("ZERO command got no answer\n");
+        return false;
     }
     
     LOG_MAREL("ZERO command sent successfully\n");
@@ -183,32 +173,63 @@ bool MarelClient::setZero() {
 }
 
 bool MarelClient::isWeightStable() {
-    if (!_initialized) return false;
+    if (!ready()) return false;
     
     bool stable = false;
     
     // Read coil 1 (COIL_WEIGHT_STABLE)
-    if (!_mb.readCoil(_slaveID, COIL_WEIGHT_STABLE, &stable, 1)) {
+    if (!_mb.readCoil(_slaveID, COIL_WEIGHT_STABLE, &stable, 1, _bus.command())) {
         LOG_ERR("Failed to queue read for weight stable flag\n");
+        Metrics::inc(Metrics::MODBUS_QUEUE_FAILS);
         return false;
     }
     
-    // Wait for response
-    unsigned long start = millis();
-    while (_mb.slave() && (millis() - start) < 1000) {
-        _mb.task();
-        yield();
-    }
+    if (!waitForResponse()) return false;
     
     return stable;
 }
 
-bool MarelClient::cbRead(Modbus::ResultCode event, uint16_t transactionId, void* data) {
-    if (event != Modbus::EX_SUCCESS) {
-        LOG_ERR("Modbus read error: 0x%02X\n", event);
-        return false;
-    }
-    _readComplete = true;
-    return true;
+bool MarelClient::ready() {
+    // Wait out a poll (ours or another scale's) still on the line
+    return _initialized && _bus.acquire();
+}
+
+bool MarelClient::waitForResponse() {
+    return _bus.wait();
 }
 
+void MarelClient::storeNet(bool ok, float kg) {
+    if (!ok) return;   // keep the last good value; its age tells how stale
+    _latest   = {true, kg};
+    _latestMs = millis();
+}
+
+WeightReading MarelClient::latest(uint32_t* ageMs) const {
+    if (ageMs) *ageMs = _latest.ok ? millis() - _latestMs : UINT32_MAX;
+    return _latest;
+}
+
+void MarelClient::benchmark(uint16_t n) {
+    if (n == 0 || !ready()) return;
+    uint32_t ok = 0, minUs = UINT32_MAX, maxUs = 0;
+    uint64_t sumUs = 0;
+    const uint32_t t0 = micros();
+    for (uint16_t i = 0; i < n; i++) {
+        const uint32_t s = micros();
+        if (!ready() || !_mb.readHreg(_slaveID, REG_NET_WEIGHT, _netWeightRegs, 2, _bus.command())) continue;
+        if (!waitForResponse()) continue;
+        const uint32_t us = micros() - s;
+        ok++;
+        sumUs += us;
+        if (us < minUs) minUs = us;
+        if (us > maxUs) maxUs = us;
+    }
+    const float secs = (micros() - t0) / 1e6f;
+    Serial.printf("[Marel] bench (%s): %u/%u ok in %.2f s = %.1f transactions/s (%.1f frames/s)\n",
+              MAREL_BUS_NATIVE ? "native RS-485" : "ModbusRTU",
+              (unsigned)ok, (unsigned)n, secs, ok / secs, 2 * ok / secs);
+    if (ok) {
+        Serial.printf("[Marel] bench latency µs: min %lu  avg %lu  max %lu\n",
+                  (unsigned long)minUs, (unsigned long)(sumUs / ok), (unsigned long)maxUs);
+    }
+}
@@ -1,6 +1,18 @@
 #pragma once
 #include <Arduino.h>
 #include <ModbusRTU.h>
+#include "config.h"
+
+// Bus master: the UART's native RS-485 mode on the device when enabled,
+// otherwise the ModbusRTU library (and always its shim on the host)
+#if defined(ESP_PLATFORM) && MAREL_NATIVE_RS485
+#include "Rs485Modbus.h"
+#define MAREL_BUS_NATIVE 1
+typedef Rs485Modbus MarelMaster;
+#else
+#define MAREL_BUS_NATIVE 0
+typedef ModbusRTU MarelMaster;
+#endif
 
 // Modbus addresses - Marel M2200 Holding Registers (base address, reads 2 regs)
 // Word order: ABCD big-endian → addr N = HIGH word, addr N+1 = LOW word
@@ -20,27 +32,37 @@ struct WeightReading {
     float kg;
 };
 
+class ScaleBus;
+
+// One indicator (slave ID) on a ScaleBus. Several handles can share
+// one bus; each call waits for the line, then runs its transaction.
 class MarelClient {
 public:
-    // Constructor for Modbus RTU
-    MarelClient(uint8_t slaveID, uint8_t rxPin, uint8_t txPin, uint8_t dePin);
+    // Background polling of the net weight (ScaleBus::task)
+    enum Priority : uint8_t {
+        POLL_ACTIVE,   // dosing: polled as fast as the line allows
+        POLL_IDLE,     // waiting for a tote: SCALE_POLL_IDLE_MS
+        POLL_OFF       // never polled (default)
+    };
+
+    MarelClient(uint8_t slaveID, ScaleBus& bus);
 
-    // Initialize Modbus RTU
+    // Initialize the bus (first handle only) and attach to it
     void begin();
 
-    // Process Modbus tasks (call in loop)
+    // Process Modbus tasks (call in loop): drives the shared bus
     void task();
 
     // Is connected? (for Modbus RTU always returns true if initialized)
     bool isConnected();
 
-    // Read gross weight in kg
+    // Read gross weight in kg (NAN: no answer)
     float getWeightKg();
 
-    // Read net weight in kg
+    // Read net weight in kg (NAN: no answer)
     float getNetWeightKg();
 
-    // Read tare value in kg
+    // Read tare value in kg (NAN: no answer)
     float getTareKg();
 
     // Set tare (writes current weight as tare)
@@ -55,23 +77,47 @@ public:
     // Check if weight is stable
     bool isWeightStable();
 
-    // Callback for read response
-    bool cbRead(Modbus::ResultCode event, uint16_t transactionId, void* data);
+    // n back-to-back net weight reads; prints transactions/s and latency
+    void benchmark(uint16_t n);
+
+    void     setPriority(Priority p) { _priority = p; }
+    Priority priority() const        { return _priority; }
+    uint8_t  slaveID() const         { return _slaveID; }
+
+    // Last net weight from a poll or getNetWeightKg(), without touching
+    // the bus. ageMs (optional) = time since it was read.
+    WeightReading latest(uint32_t* ageMs = nullptr) const;
+
+    // Register pair <-> kg (CDAB word order, raw int32 = kg).
+    // Static and public so the native benchmarks can call them.
+    static float registersToFloat(uint16_t reg0, uint16_t reg1);
+    static void  floatToRegisters(float value, uint16_t &reg0, uint16_t &reg1);
 
 private:
-    ModbusRTU _mb;
+    friend class ScaleBus;
+
+    ScaleBus& _bus;
+    MarelMaster& _mb;   // _bus.master()
     uint8_t _slaveID;
-    uint8_t _rxPin;
-    uint8_t _txPin;
-    uint8_t _dePin;
     bool _initialized;
 
+    // Poll state (owned by ScaleBus)
+    Priority _priority = POLL_OFF;
+    uint32_t _polledMs = 0;      // last net read issued, poll or command
+    WeightReading _latest = {false, 0.0f};
+    uint32_t _latestMs = 0;
+
+    // Net weight read: stores into _latest (poll callback and getNetWeightKg)
+    void storeNet(bool ok, float kg);
+
     // Buffers for readings
     uint16_t _weightRegs[2];
     uint16_t _netWeightRegs[2];
     uint16_t _tareRegs[2];
-    bool _readComplete;
-    
-    float registersToFloat(uint16_t reg0, uint16_t reg1);
-    void  floatToRegisters(float value, uint16_t &reg0, uint16_t &reg1);
+
+    // Bus free for this handle's transaction (ScaleBus::acquire)
+    bool  ready();
+
+    // Pump the bus until the pending transaction ends; false on timeout
+    bool  waitForResponse();
 };
@@ -0,0 +1,210 @@
+#pragma once
+// ============================================================
+// Plant  —  Physical model of one outbound station (host only)
+//
+// What the firmware cannot see directly, modelled at 1 ms steps:
+//   - water pump: solenoid lag on open/close, constant flow, a
+//     short hose column that still lands after the pump stops
+//   - ice auger: ICE_PUMP / ICE_STOP are 200 ms pulses into the
+//     auger starter, spin-up/down delay, then ice falls through
+//     the chute (transport delay = mass "in flight")
+//   - Marel indicator: refreshes its display value at a fixed
+//     rate with Gaussian noise; a Modbus read returns whatever
+//     the indicator showed at mid-transaction and takes a
+//     jittered round-trip, with the odd timeout
+//
+// Defaults are rough figures for the EdgeBox line (see README);
+// every one can be overridden from the sim CLI.
+// ============================================================
+#include <stdint.h>
+#include <math.h>
+#include <deque>
+#include <random>
+#include <vector>
+
+namespace Sim {
+
+  struct PlantParams {
+    // Tote
+    double base_kg          = 180.0;  // fish + tote on the scale at START
+
+    // Water
+    double water_kgps       = 0.40;   // pump flow
+    uint32_t water_open_ms  = 120;    // solenoid open lag
+    uint32_t water_close_ms = 150;    // solenoid close lag
+    uint32_t water_fall_ms  = 300;    // hose outlet → tote
+
+    // Ice
+    double ice_kgps         = 0.30;   // auger throughput at full speed
+    uint32_t ice_start_ms   = 300;    // ICE_PUMP pulse + spin-up
+    uint32_t ice_stop_ms    = 250;    // ICE_STOP pulse + spin-down
+    uint32_t ice_fall_ms    = 700;    // auger outlet → tote (chute)
+    double ice_lump_sd      = 0.35;   // relative flow variation (lumpy ice)
+
+    // Scale / Modbus
+    uint32_t scale_period_ms = 100;   // indicator display refresh
+    double noise_kg          = 0.010; // 1σ display noise
+    uint32_t modbus_ms       = 25;    // mean round-trip (read of 2 regs @ 9600 baud)
+    uint32_t modbus_jitter_ms = 10;   // uniform ± jitter
+    double timeout_rate      = 0.002; // fraction of reads that time out
+    uint32_t timeout_ms      = 1000;  // MarelClient wait limit
+
+    // Firmware loop
+    uint32_t loop_delay_ms   = 20;    // delay() at the start of loop()
+  };
+
+  // Fixed-delay line: mass pushed now comes out delay_ms later.
+  class DelayLine {
+  public:
+    void reset(uint32_t delay_ms) {
+      _buf.assign(delay_ms + 1, 0.0);
+      _pos = 0;
+    }
+    /** Pushes this ms' mass, returns the mass that lands this ms. */
+    double step(double in) {
+      _buf[_pos] = in;
+      _pos = (_pos + 1) % _buf.size();
+      const double out = _buf[_pos];
+      _buf[_pos] = 0.0;
+      return out;
+    }
+    double inFlight() const {
+      double s = 0;
+      for (double v : _buf) s += v;
+      return s;
+    }
+  private:
+    std::vector<double> _buf;
+    size_t              _pos = 0;
+  };
+
+  class Plant {
+  public:
+    Plant(const PlantParams& p, uint32_t seed)
+      : _p(p), _rng(seed), _lumpDist(1.0, p.ice_lump_sd) {}
+
+    /** Empty scale at t_ms (simulated millis()); load() puts a tote on it. */
+    void reset(uint32_t t_ms = 0) {
+      _t          = t_ms;
+      _loaded     = false;
+      _waterKg    = 0;
+      _iceKg      = 0;
+      _waterCmd   = false;
+      _iceCmd     = false;
+      _waterOn    = false;
+      _iceOn      = false;
+      _waterEdge  = 0;
+      _iceEdge    = 0;
+      _lump       = 1.0;
+      _waterLine.reset(_p.water_fall_ms);
+      _iceLine.reset(_p.ice_fall_ms);
+      _display    = trueKg() + noise();
+      _nextUpdate = t_ms + _p.scale_period_ms;
+      _history.clear();
+      _history.push_back({t_ms, _display});
+    }
+
+    /** Tote (base_kg) on / off the scale; the display follows at its next refresh. */
+    void load(bool on) { _loaded = on; }
+
+    // ── Outputs (what StationIo would write) ─────────────────────────────────
+    void water(bool on) {
+      if (on == _waterCmd) return;
+      _waterCmd  = on;
+      _waterEdge = _t + (on ? _p.water_open_ms : _p.water_close_ms);
+    }
+    void ice(bool on) {
+      if (on == _iceCmd) return;
+      _iceCmd  = on;
+      _iceEdge = _t + (on ? _p.ice_start_ms : _p.ice_stop_ms);
+    }
+
+    /** Runs the physics up to t_ms (1 ms resolution). */
+    void advanceTo(uint32_t t_ms) {
+      while (_t < t_ms) {
+        _t++;
+        if (_waterOn != _waterCmd && _t >= _waterEdge) _waterOn = _waterCmd;
+        if (_iceOn   != _iceCmd   && _t >= _iceEdge)   _iceOn   = _iceCmd;
+
+        if (_t % 250 == 0) _lump = clampLump(_lumpDist(_rng));
+
+        _waterKg += _waterLine.step(_waterOn ? _p.water_kgps / 1000.0 : 0.0);
+        _iceKg   += _iceLine.step(_iceOn ? _p.ice_kgps * _lump / 1000.0 : 0.0);
+
+        if (_t >= _nextUpdate) {
+          _display     = trueKg() + noise();
+          _nextUpdate += _p.scale_period_ms;
+          _history.push_back({_t, _display});
+          if (_history.size() > 64) _history.pop_front();
+        }
+      }
+    }
+
+    /**
+     * One MarelClient::getWeight() issued at now_ms. Advances the plant
+     * to the end of the transaction, returns its duration in
+     * latency_ms. A timeout returns NaN (firmware keeps the old value
+     * and the engine holds).
+     */
+    double read(uint32_t now_ms, uint32_t& latency_ms) {
+      bool timedOut;
+      latency_ms = transaction(timedOut);
+      advanceTo(now_ms + latency_ms);
+      return timedOut ? NAN : displayAt(now_ms + latency_ms / 2);
+    }
+
+    /**
+     * Round-trip of one Modbus read, without running the plant: a
+     * background poll (ScaleBus) draws it when issued and looks the
+     * value up with displayAt() once the simulated clock gets there.
+     */
+    uint32_t transaction(bool& timedOut) {
+      timedOut = _unit(_rng) < _p.timeout_rate;
+      if (timedOut) return _p.timeout_ms;
+      const int32_t j = (int32_t)_p.modbus_jitter_ms;
+      return (uint32_t)((int32_t)_p.modbus_ms + std::uniform_int_distribution<int32_t>(-j, j)(_rng));
+    }
+
+    /** What the indicator showed at t (recent past only: last 64 refreshes). */
+    double displayAt(uint32_t t) const {
+      for (auto it = _history.rbegin(); it != _history.rend(); ++it)
+        if (it->t <= t) return it->kg;
+      return _history.front().kg;
+    }
+
+    uint32_t now()          const { return _t; }
+    double   trueKg()       const { return _loaded ? _p.base_kg + _waterKg + _iceKg : 0.0; }
+    double   waterInTote()  const { return _waterKg; }
+    double   iceInTote()    const { return _iceKg; }
+    /** Water and ice that has left the pump/auger but not landed yet. */
+    double   waterInFlight() const { return _waterLine.inFlight(); }
+    double   iceInFlight()   const { return _iceLine.inFlight(); }
+    bool     waterRunning() const { return _waterOn; }
+    bool     iceRunning()   const { return _iceOn; }
+
+  private:
+    struct Shown { uint32_t t; double kg; };
+
+    double noise() { return _noise(_rng) * _p.noise_kg; }
+    double clampLump(double v) const { return v < 0.2 ? 0.2 : (v > 1.8 ? 1.8 : v); }
+
+    PlantParams _p;
+    std::mt19937 _rng;
+    std::normal_distribution<double> _noise{0.0, 1.0};
+    std::normal_distribution<double> _lumpDist;
+    std::uniform_real_distribution<double> _unit{0.0, 1.0};
+
+    uint32_t  _t = 0;
+    bool      _loaded = false;
+    double    _waterKg = 0, _iceKg = 0;
+    bool      _waterCmd = false, _iceCmd = false;
+    bool      _waterOn = false, _iceOn = false;
+    uint32_t  _waterEdge = 0, _iceEdge = 0;
+    double    _lump = 1.0;
+    DelayLine _waterLine, _iceLine;
+    double    _display = 0;
+    uint32_t  _nextUpdate = 0;
+    std::deque<Shown> _history;
+  };
+
+} // namespace Sim
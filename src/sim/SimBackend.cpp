@@ -0,0 +1,123 @@
+// ============================================================
+// SimBackend.cpp  —  Host stand-ins for ToteValidator, ToteUploader
+// and main.cpp's WS / BLE globals (simulated time, no network)
+// ============================================================
+#include "SimBackend.h"
+#include "../host/LaneHost.h"
+#include "../ToteValidator.h"
+#include "../ToteUploader.h"
+
+namespace SimBackend {
+  uint32_t latency_ms = 150;
+}
+
+ToteWebSocketClient wsClient;
+BLEQRClient bleQRClient;
+
+void sendStats() {}
+
+// Only has to be non-empty: the uploader stand-in doesn't look at it
+String totePayload(const char* toteId, float, float, float, float, const tote_trace*) {
+  String payload("{\"id\":\"");
+  payload.concat(toteId);
+  payload.concat("\"}");
+  return payload;
+}
+
+// ── ToteValidator ─────────────────────────────────────────────────────────────
+namespace ToteValidator {
+
+  struct Slot {
+    Status   status;
+    char     id[ID_SIZE];
+    uint32_t submittedMs;
+    bool     taken;
+  };
+  static Slot s_slots[LANE_COUNT];
+
+  void begin() {}
+
+  bool submit(uint8_t lane, const char* id) {
+    if (lane >= LANE_COUNT || strlen(id) >= ID_SIZE) return false;
+    Slot& s = s_slots[lane];
+    if (s.status != Status::NONE && strcmp(s.id, id) == 0 &&
+        (s.status == Status::PENDING || s.status == Status::VALID)) return true;
+    strncpy(s.id, id, ID_SIZE);
+    s.status      = Status::PENDING;
+    s.submittedMs = millis();
+    s.taken       = false;
+    return true;
+  }
+
+  Status status(uint8_t lane) {
+    if (lane >= LANE_COUNT) return Status::NONE;
+    Slot& s = s_slots[lane];
+    if (s.status == Status::PENDING && millis() - s.submittedMs >= SimBackend::latency_ms)
+      s.status = Status::VALID;
+    return s.status;
+  }
+
+  void currentId(uint8_t lane, char* out, size_t size) {
+    if (!size) return;
+    out[0] = '\0';
+    if (lane >= LANE_COUNT || s_slots[lane].status == Status::NONE) return;
+    strncpy(out, s_slots[lane].id, size - 1);
+    out[size - 1] = '\0';
+  }
+
+  bool takeResult(uint8_t lane, Result& out) {
+    const Status st = status(lane);
+    Slot& s = s_slots[lane < LANE_COUNT ? lane : 0];
+    if (lane >= LANE_COUNT || st == Status::NONE || st == Status::PENDING || s.taken) return false;
+    s.taken = true;
+    out.status     = st;
+    strncpy(out.id, s.id, ID_SIZE);
+    out.raw_kg     = NAN;
+    out.latency_ms = millis() - s.submittedMs;
+    return true;
+  }
+
+  void reset(uint8_t lane) {
+    if (lane < LANE_COUNT) s_slots[lane] = {};
+  }
+
+  const char* statusName(Status s) {
+    switch (s) {
+      case Status::NONE:     return "NONE";
+      case Status::PENDING:  return "PENDING";
+      case Status::VALID:    return "VALID";
+      case Status::REJECTED: return "REJECTED";
+      case Status::FAILED:   return "FAILED";
+    }
+    return "?";
+  }
+}
+
+// ── ToteUploader ──────────────────────────────────────────────────────────────
+namespace ToteUploader {
+
+  struct Slot {
+    bool     pending;
+    uint32_t submittedMs;
+  };
+  static Slot s_slots[LANE_COUNT];
+
+  void begin() {}
+
+  bool submit(uint8_t lane, const char*, String&) {
+    if (lane >= LANE_COUNT || s_slots[lane].pending) return false;
+    s_slots[lane] = {true, millis()};
+    return true;
+  }
+
+  bool pending(uint8_t lane) {
+    return lane < LANE_COUNT && s_slots[lane].pending;
+  }
+
+  bool takeResult(uint8_t lane, Result& out) {
+    if (!pending(lane) || millis() - s_slots[lane].submittedMs < SimBackend::latency_ms) return false;
+    s_slots[lane].pending = false;
+    out = {true, 200, millis() - s_slots[lane].submittedMs};
+    return true;
+  }
+}
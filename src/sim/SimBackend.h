@@ -0,0 +1,14 @@
+#pragma once
+// ============================================================
+// SimBackend  —  Backend, WS and QR reader as the simulator sees them
+//
+// Stand-ins for what Lane.cpp calls besides Station (see
+// host/LaneHost.h): ToteValidator and ToteUploader answer after
+// latency_ms of simulated time, always OK; the WS client records
+// the lane's reported water / ice.
+// ============================================================
+#include <stdint.h>
+
+namespace SimBackend {
+  extern uint32_t latency_ms;   // submit → answer, GET and PUT alike
+}
@@ -0,0 +1,465 @@
+// ============================================================
+// sim_main.cpp  —  Discrete-event station simulator (host only)
+//
+// Runs thousands of tote cycles through the firmware's Lane
+// (src/Lane.cpp: START / auto-start, the three stages, the dosing
+// engine of src/core/Dosing.h, the tote ID stages, COMPLETED and
+// its upload) over Station<HostBoard>, against the plant model in
+// Plant.h, in simulated time. Backend, WS and QR reader are the
+// stand-ins of SimBackend.cpp. Reports per strategy:
+//   - cycle time START → back in IDLE, and START → settle done
+//     (p50/p95/p99)
+//   - real overshoot per ingredient (what ended up in the tote,
+//     including mass still in flight when the pump stopped)
+//   - what the lane reported (WS water / ice) vs the truth
+//   - host CPU ns per Lane::update() (plant model excluded)
+//
+//   pio run -e native_sim && .pio/build/native_sim/program --totes 5000
+//   .pio/build/native_sim/program --strategy all --json > sim.json
+// ============================================================
+#include <Arduino.h>   // host shim: HostTime (simulated millis())
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "../Lane.h"
+#include "../Settings.h"
+#include "../Metrics.h"
+#include "../WeightRecorder.h"
+#include "../Debug.h"
+#include "../host/LaneHost.h"
+#include "Plant.h"
+#include "SimBackend.h"
+
+using namespace Sim;
+
+// ── Per-strategy results ──────────────────────────────────────────────────────
+struct Series {
+  std::vector<double> v;
+
+  void   add(double x) { v.push_back(x); }
+  double mean() const {
+    double s = 0;
+    for (double x : v) s += x;
+    return v.empty() ? 0 : s / v.size();
+  }
+  double sd() const {
+    if (v.size() < 2) return 0;
+    const double m = mean();
+    double s = 0;
+    for (double x : v) s += (x - m) * (x - m);
+    return sqrt(s / (v.size() - 1));
+  }
+  double pct(double p) {
+    if (v.empty()) return 0;
+    std::sort(v.begin(), v.end());
+    size_t i = (size_t)ceil(p * v.size());
+    return v[i ? i - 1 : 0];
+  }
+};
+
+struct Result {
+  Dosing::Strategy strategy;
+  bool     overlap   = false;
+  uint32_t overlapped = 0;  // cycles that actually ran water + ice together
+  Series   saved_ms;        // dosing time those saved (Metrics::DOSING_SAVED_MS)
+  Series   cycle_ms;        // START → IDLE again
+  Series   dose_ms;         // START → settle done
+  Series   water_err_g;     // true water in tote − target
+  Series   ice_err_g;       // true ice in tote − target
+  Series   water_bias_g;    // lane's reading − truth
+  Series   ice_bias_g;
+  Series   update_ns;       // host CPU per Lane::update()
+  uint64_t updates   = 0;
+  uint64_t timeouts  = 0;   // Marel reads with no answer
+  uint64_t blocking  = 0;   // reads the loop waited for (no fresh poll)
+  uint32_t stuck     = 0;   // totes stopped by the sim's time limit
+  uint32_t unreported = 0;  // totes whose water or ice the lane reported as NaN
+  double   sim_ms    = 0;   // simulated time
+  double   wall_s    = 0;   // host time
+};
+
+struct Options {
+  PlantParams    p;
+  Dosing::Config cfg;
+  uint32_t totes       = 2000;
+  uint32_t seed        = 1;
+  bool     autoStart   = false;
+  uint32_t startMs     = 1500;  // tote placed → START pressed
+  uint32_t scanMs      = 3000;  // START → QR scanned
+  uint32_t gapMs       = 2000;  // tote removed → next one placed
+};
+
+// One lane, no physical I/O: outputs on HostIo channels 0..2
+static const LaneConfig SIM_LANE = {
+  "sim", 1, 0, 1, 2, LANE_NO_IO, LANE_NO_IO, LANE_NO_IO, LANE_NO_IO, LANE_NO_IO
+};
+
+static const uint32_t TOTE_LIMIT_MS = 600000;  // a cycle this long is stuck
+
+// ── Marel on the RS-485 line (ScaleBus stand-in) ─────────────────────────────
+// With a poll priority set, ScaleBus reads the scale in the background:
+// back to back (SCALE_POLL_ACTIVE_MS) while the lane doses, every
+// SCALE_POLL_IDLE_MS otherwise, and Esp32Scale::netKgImpl() returns that
+// reading while it is within SCALE_MAX_AGE_*. Without one, or when it is
+// stale, the read is the caller's own and the loop waits for it.
+struct Bus {
+  Plant&          plant;
+  Hal::HostScale& scale;
+  Result&         r;
+
+  bool     issued   = false;    // poll on the line
+  uint32_t issuedMs = 0, doneMs = 0, nextMs = 0;
+  bool     lost     = false;
+  bool     ok       = false;    // latest poll
+  float    kg       = NAN;
+  uint32_t atMs     = 0;
+  Hal::Poll rate    = Hal::Poll::OFF;
+  uint64_t hostNs   = 0;        // host time spent in the plant model
+
+  void run(uint32_t now) {
+    if (scale.pollRate != rate) {
+      if (rate == Hal::Poll::OFF) nextMs = now;
+      rate = scale.pollRate;
+    }
+    if (rate == Hal::Poll::OFF) {
+      issued = false;
+      return;
+    }
+    for (;;) {
+      if (!issued) {
+        issuedMs = nextMs;
+        doneMs   = issuedMs + plant.transaction(lost);
+        issued   = true;
+      }
+      if ((int32_t)(now - doneMs) < 0) return;
+      issued = false;
+      ok     = !lost;
+      kg     = lost ? NAN : (float)plant.displayAt(issuedMs + (doneMs - issuedMs) / 2);
+      atMs   = doneMs;
+      if (lost) r.timeouts++;
+      nextMs = std::max(doneMs, issuedMs + (rate == Hal::Poll::ACTIVE ? SCALE_POLL_ACTIVE_MS
+                                                                      : SCALE_POLL_IDLE_MS));
+    }
+  }
+
+  float read() {
+    const auto c0 = std::chrono::steady_clock::now();
+    const uint32_t now = millis();
+    plant.advanceTo(now);
+    run(now);
+    float out;
+    if (rate != Hal::Poll::OFF && ok &&
+        now - atMs <= (rate == Hal::Poll::ACTIVE ? SCALE_MAX_AGE_ACTIVE_MS : SCALE_MAX_AGE_IDLE_MS)) {
+      out = kg;
+    } else {
+      uint32_t lat;
+      out = (float)plant.read(now, lat);
+      HostTime::advanceUs((uint64_t)lat * 1000);
+      r.blocking++;
+      if (isnan(out)) r.timeouts++;
+    }
+    hostNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now() - c0).count();
+    return out;
+  }
+};
+
+// ── Lane outputs → plant ──────────────────────────────────────────────────────
+// Water is a level; the auger takes ICE_PUMP / ICE_STOP pulses (rising edge)
+struct Wiring {
+  Plant&        plant;
+  Hal::HostIo&  io;
+  uint8_t       last[3] = {};
+
+  void apply() {
+    plant.advanceTo(millis());
+    const uint8_t now[3] = {io.output(SIM_LANE.water_pump), io.output(SIM_LANE.ice_pump),
+                            io.output(SIM_LANE.ice_stop)};
+    if (now[0] != last[0]) plant.water(now[0]);
+    if (now[1] && !last[1]) plant.ice(true);
+    if (now[2] && !last[2]) plant.ice(false);
+    memcpy(last, now, sizeof(last));
+  }
+};
+
+// ── One tote through the lane, main.cpp's loop() around it ───────────────────
+static void runTote(Lane& lane, Plant& plant, Bus& bus, Wiring& wiring, const Options& o,
+                    uint32_t n, uint32_t& nextSample, Result& r) {
+  // One loop() pass: delay, Lane::task(), the 200 ms weight broadcast
+  // (runner), Lane::update()
+  auto pass = [&] {
+    delay(o.p.loop_delay_ms);
+    lane.task();
+    wiring.apply();
+    if ((int32_t)(millis() - nextSample) >= 0) {
+      nextSample += 200;
+      lane.sampleWeight();
+      wiring.apply();
+    }
+    const uint64_t plantNs = bus.hostNs;
+    const auto c0 = std::chrono::steady_clock::now();
+    lane.update();
+    const auto c1 = std::chrono::steady_clock::now();
+    r.update_ns.add((double)std::chrono::duration_cast<std::chrono::nanoseconds>(c1 - c0).count() -
+                    (double)(bus.hostNs - plantNs));
+    r.updates++;
+    wiring.apply();
+  };
+
+  wsClient.waterKg = NAN;
+  wsClient.iceKg   = NAN;
+  const uint32_t overlapped0 = Metrics::get(Metrics::DOSING_OVERLAPPED);
+  const uint32_t saved0      = Metrics::get(Metrics::DOSING_SAVED_MS);
+
+  // Tote on the scale; START after o.startMs (again every second while
+  // the weight check fails), or ToteDetector with --auto-start
+  plant.load(true);
+  const uint32_t placed = millis();
+  uint32_t pressed = 0;
+  while (lane.state() == ToteState::IDLE) {
+    if (millis() - placed >= TOTE_LIMIT_MS) {
+      r.stuck++;
+      return;
+    }
+    if (!o.autoStart && millis() - placed >= o.startMs && (!pressed || millis() - pressed >= 1000)) {
+      pressed = millis();
+      lane.start();
+      wiring.apply();
+    }
+    if (lane.state() == ToteState::IDLE) pass();
+  }
+
+  // The cycle: QR scanned o.scanMs after START, then whatever the lane does
+  char id[ID_SIZE];
+  snprintf(id, sizeof(id), "SIM-%u", (unsigned)n);
+  bool scanned = false, settled = false;
+  double water = 0, ice = 0;
+  uint32_t doseMs = 0;
+  const uint32_t started = lane.startedMs();
+  while (lane.state() != ToteState::IDLE) {
+    if (millis() - started >= TOTE_LIMIT_MS) {
+      r.stuck++;
+      lane.stop();
+      wiring.apply();
+      pass();
+      break;
+    }
+    if (!scanned && millis() - started >= o.scanMs && lane.acceptsId()) {
+      scanned = lane.submitToteId(id, millis());
+    }
+    pass();
+    if (!settled && lane.state() != ToteState::DISPENSING_WATER &&
+        lane.state() != ToteState::DISPENSING_ICE && lane.state() != ToteState::SETTLING_ICE) {
+      // Settle done: anything still in flight lands during WAITING_TOTE_ID
+      settled = true;
+      doseMs  = millis() - started;
+      water   = plant.waterInTote() + plant.waterInFlight();
+      ice     = plant.iceInTote() + plant.iceInFlight();
+    }
+  }
+
+  if (settled) {
+    const uint32_t cycle = millis() - started;
+    const Settings::Snapshot st = Settings::snapshot();
+    r.cycle_ms.add(cycle);
+    r.dose_ms.add(doseMs);
+    r.water_err_g.add((water - st.dosing.water_kg) * 1000.0);
+    r.ice_err_g.add((ice - st.dosing.ice_kg) * 1000.0);
+    if (isnan(wsClient.waterKg) || isnan(wsClient.iceKg)) {
+      r.unreported++;
+    } else {
+      r.water_bias_g.add((wsClient.waterKg - water) * 1000.0);
+      r.ice_bias_g.add((wsClient.iceKg - ice) * 1000.0);
+    }
+    if (Metrics::get(Metrics::DOSING_OVERLAPPED) != overlapped0) {
+      r.overlapped++;
+      r.saved_ms.add(Metrics::get(Metrics::DOSING_SAVED_MS) - saved0);
+    }
+  }
+
+  // Tote off, empty scale until the next one
+  plant.reset(millis());
+  const uint32_t removed = millis();
+  while (millis() - removed < o.gapMs) pass();
+}
+
+static Result runStrategy(Dosing::Strategy s, bool overlap, const Options& o) {
+  Result r;
+  r.strategy = s;
+  r.overlap  = overlap;
+  Settings::update([&](Settings::Snapshot& st) {
+    st.dosing          = o.cfg;
+    st.dosing.strategy = s;
+    st.dosing.overlap  = overlap;
+    st.auto_start      = o.autoStart;
+  });
+
+  Plant plant(o.p, o.seed);   // same seed → every strategy sees the same ice and noise
+  plant.reset(millis());
+  Lane lane(0, SIM_LANE);
+  Bus bus{plant, lane.station().scale, r};
+  lane.station().scale.source = [&] { return bus.read(); };
+  Wiring wiring{plant, lane.station().io};
+  lane.begin();
+  wiring.apply();
+
+  const uint32_t t0 = millis();
+  uint32_t nextSample = t0;
+  const auto w0 = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < o.totes; i++) runTote(lane, plant, bus, wiring, o, i, nextSample, r);
+  r.wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - w0).count();
+  r.sim_ms = millis() - t0;
+  return r;
+}
+
+// ── Report ───────────────────────────────────────────────────────────────────
+static const char* label(const Result& r) {
+  static char buf[32];
+  snprintf(buf, sizeof(buf), "%s%s", Dosing::strategyName(r.strategy), r.overlap ? "+ov" : "");
+  return buf;
+}
+
+static void printText(std::vector<Result>& results, uint32_t totes) {
+  printf("%u totes per strategy\n\n", totes);
+  printf("%-14s %8s %8s %8s %8s | %9s %8s %8s | %9s %8s %8s | %8s %8s | %7s %9s\n",
+         "strategy", "cyc p50", "cyc p95", "cyc p99", "dose p50",
+         "water Δg", "σ", "p95", "ice Δg", "σ", "p95",
+         "w bias", "i bias", "ns/upd", "speedup");
+  for (Result& r : results) {
+    printf("%-14s %7.2fs %7.2fs %7.2fs %7.2fs | %+9.0f %8.0f %+8.0f | %+9.0f %8.0f %+8.0f | %+8.0f %+8.0f | %7.0f %8.0fx\n",
+           label(r),
+           r.cycle_ms.pct(0.50) / 1000, r.cycle_ms.pct(0.95) / 1000, r.cycle_ms.pct(0.99) / 1000,
+           r.dose_ms.pct(0.50) / 1000,
+           r.water_err_g.mean(), r.water_err_g.sd(), r.water_err_g.pct(0.95),
+           r.ice_err_g.mean(), r.ice_err_g.sd(), r.ice_err_g.pct(0.95),
+           r.water_bias_g.mean(), r.ice_bias_g.mean(),
+           r.update_ns.pct(0.50),
+           r.wall_s > 0 ? r.sim_ms / 1000.0 / r.wall_s : 0);
+  }
+  for (Result& r : results) {
+    if (r.stuck) printf("\n%s: %u totes stuck (stopped after %u s)", label(r), r.stuck, TOTE_LIMIT_MS / 1000);
+    if (r.unreported) printf("\n%s: %u totes reported NaN water or ice", label(r), r.unreported);
+  }
+  for (Result& r : results) {
+    if (!r.overlap) continue;
+    printf("\n%s: %u/%u cycles overlapped, estimated saving %.2f s/tote (p50 %.2f s)",
+           label(r), r.overlapped, totes, r.saved_ms.mean() / 1000, r.saved_ms.pct(0.50) / 1000);
+  }
+  printf("\ncyc = START → IDLE again, dose = START → settle done.\n"
+         "Δg = real mass in tote − target (incl. in flight). bias = lane's reported water / ice − real.\n");
+}
+
+static void printSeriesJson(const char* name, Series& s, bool last = false) {
+  printf("      \"%s\": {\"mean\": %.2f, \"sd\": %.2f, \"p50\": %.2f, \"p95\": %.2f, \"p99\": %.2f, \"max\": %.2f}%s\n",
+         name, s.mean(), s.sd(), s.pct(0.50), s.pct(0.95), s.pct(0.99), s.pct(1.0), last ? "" : ",");
+}
+
+static void printJson(std::vector<Result>& results, uint32_t totes, uint32_t seed) {
+  printf("{\n  \"totes\": %u,\n  \"seed\": %u,\n  \"strategies\": [\n", totes, seed);
+  for (size_t i = 0; i < results.size(); i++) {
+    Result& r = results[i];
+    printf("    {\n      \"strategy\": \"%s\",\n      \"overlap\": %s,\n      \"overlapped\": %u,\n",
+           Dosing::strategyName(r.strategy), r.overlap ? "true" : "false", r.overlapped);
+    printf("      \"updates\": %llu,\n      \"timeouts\": %llu,\n      \"blocking_reads\": %llu,\n"
+           "      \"stuck\": %u,\n      \"unreported\": %u,\n      \"speedup\": %.0f,\n",
+           (unsigned long long)r.updates, (unsigned long long)r.timeouts,
+           (unsigned long long)r.blocking, r.stuck, r.unreported,
+           r.wall_s > 0 ? r.sim_ms / 1000.0 / r.wall_s : 0);
+    printSeriesJson("cycle_ms", r.cycle_ms);
+    printSeriesJson("dose_ms", r.dose_ms);
+    printSeriesJson("water_err_g", r.water_err_g);
+    printSeriesJson("ice_err_g", r.ice_err_g);
+    printSeriesJson("water_bias_g", r.water_bias_g);
+    printSeriesJson("ice_bias_g", r.ice_bias_g);
+    if (r.overlap) printSeriesJson("saved_ms", r.saved_ms);
+    printSeriesJson("update_ns", r.update_ns, true);
+    printf("    }%s\n", i + 1 < results.size() ? "," : "");
+  }
+  printf("  ]\n}\n");
+}
+
+// ── CLI ──────────────────────────────────────────────────────────────────────
+static void usage() {
+  printf("usage: sim [--totes N] [--seed S] [--strategy NAME|all] [--overlap] [--json] [--log]\n"
+         "           [--auto-start] [--start-ms N] [--scan-ms N] [--gap-ms N] [--backend-ms N]\n"
+         "           [--water-kg X] [--ice-kg X] [--settle-ms N]\n"
+         "           [--fine-kg X] [--tol-kg X] [--pulse-max-ms N] [--pulse-min-ms N]\n"
+         "           [--pulse-wait-ms N] [--fine-settle-ms N]\n"
+         "           [--water-kgps X] [--ice-kgps X] [--ice-fall-ms N] [--ice-lump-sd X]\n"
+         "           [--noise-g X] [--scale-period-ms N] [--modbus-ms N] [--timeout-rate X]\n"
+         "strategies:");
+  for (uint8_t i = 0; i < (uint8_t)Dosing::Strategy::STRATEGY_COUNT; i++)
+    printf(" %s", Dosing::strategyName((Dosing::Strategy)i));
+  printf("\n");
+}
+
+int main(int argc, char** argv) {
+  // Simulated millis() from here on; the station as a freshly erased one
+  // (host Preferences: empty NVS → config.h defaults)
+  HostTime::simulate();
+  memset(Log::levels, LOG_LVL_OFF, sizeof(Log::levels));
+  Settings::load();
+  WeightRecorder::begin();
+
+  Options o;
+  o.cfg = Settings::dosingConfig();
+  bool json = false, overlap = false;
+  const char* strategy = "all";
+
+  for (int i = 1; i < argc; i++) {
+    const char* a = argv[i];
+    const char* v = i + 1 < argc ? argv[i + 1] : nullptr;
+    auto takes = [&](const char* name) { if (strcmp(a, name) || !v) return false; i++; return true; };
+
+    if      (!strcmp(a, "--json"))          json = true;
+    else if (!strcmp(a, "--overlap"))       overlap = true;   // also run each strategy overlapped
+    else if (!strcmp(a, "--auto-start"))    o.autoStart = true;   // ToteDetector instead of START
+    else if (!strcmp(a, "--log"))           Log::levels[LOG_MOD_MAIN] = LOG_LVL_INFO;  // the lane's log
+    else if (takes("--totes"))              o.totes = strtoul(v, nullptr, 10);
+    else if (takes("--seed"))               o.seed = strtoul(v, nullptr, 10);
+    else if (takes("--strategy"))           strategy = v;
+    else if (takes("--start-ms"))           o.startMs = strtoul(v, nullptr, 10);
+    else if (takes("--scan-ms"))            o.scanMs = strtoul(v, nullptr, 10);
+    else if (takes("--gap-ms"))             o.gapMs = strtoul(v, nullptr, 10);
+    else if (takes("--backend-ms"))         SimBackend::latency_ms = strtoul(v, nullptr, 10);
+    else if (takes("--water-kg"))           o.cfg.water_kg = atof(v);
+    else if (takes("--ice-kg"))             o.cfg.ice_kg = atof(v);
+    else if (takes("--settle-ms"))          o.cfg.settle_ms = strtoul(v, nullptr, 10);
+    else if (takes("--fine-kg"))            o.cfg.fine_kg = atof(v);
+    else if (takes("--tol-kg"))             o.cfg.tol_kg = atof(v);
+    else if (takes("--pulse-max-ms"))       o.cfg.pulse_max_ms = strtoul(v, nullptr, 10);
+    else if (takes("--pulse-min-ms"))       o.cfg.pulse_min_ms = strtoul(v, nullptr, 10);
+    else if (takes("--pulse-wait-ms"))      o.cfg.pulse_wait_ms = strtoul(v, nullptr, 10);
+    else if (takes("--fine-settle-ms"))     o.cfg.fine_settle_ms = strtoul(v, nullptr, 10);
+    else if (takes("--water-kgps"))         o.p.water_kgps = atof(v);
+    else if (takes("--ice-kgps"))           o.p.ice_kgps = atof(v);
+    else if (takes("--ice-fall-ms"))        o.p.ice_fall_ms = strtoul(v, nullptr, 10);
+    else if (takes("--ice-lump-sd"))        o.p.ice_lump_sd = atof(v);
+    else if (takes("--noise-g"))            o.p.noise_kg = atof(v) / 1000.0;
+    else if (takes("--scale-period-ms"))    o.p.scale_period_ms = strtoul(v, nullptr, 10);
+    else if (takes("--modbus-ms"))          o.p.modbus_ms = strtoul(v, nullptr, 10);
+    else if (takes("--timeout-rate"))       o.p.timeout_rate = atof(v);
+    else { usage(); return strcmp(a, "--help") ? 2 : 0; }
+  }
+
+  std::vector<Result> results;
+  for (uint8_t i = 0; i < (uint8_t)Dosing::Strategy::STRATEGY_COUNT; i++) {
+    const Dosing::Strategy s = (Dosing::Strategy)i;
+    if (strcmp(strategy, "all") && strcmp(strategy, Dosing::strategyName(s))) continue;
+    results.push_back(runStrategy(s, false, o));
+    if (overlap) results.push_back(runStrategy(s, true, o));
+  }
+  if (results.empty()) {
+    usage();
+    return 2;
+  }
+
+  if (json) printJson(results, o.totes, o.seed);
+  else      printText(results, o.totes);
+  return 0;
+}
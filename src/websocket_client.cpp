@@ -1,5 +1,7 @@
 #include "websocket_client.h"
 #include "Debug.h"
+#include "Metrics.h"
+#include "WsMessages.h"
 
 // Static instance pointer for callback
 ToteWebSocketClient* ToteWebSocketClient::instance = nullptr;
@@ -10,7 +12,9 @@ ToteWebSocketClient::ToteWebSocketClient()
     , reconnectDelay(1000)
     , lastReconnectAttempt(0)
     , reconnectAttempts(0)
-    , messageCallback(nullptr) {
+    , messageCallback(nullptr)
+    , stations(nullptr)
+    , stationCount(0) {
     instance = this;
 }
 
@@ -44,30 +48,28 @@ void ToteWebSocketClient::webSocketEvent(WStype_t type, uint8_t * payload, size_
     switch(type) {
         case WStype_DISCONNECTED:
             LOG_WS("[WS] Disconnected\n");
+            if (isConnected) Metrics::inc(Metrics::WS_DISCONNECTS);
             isConnected = false;
             break;
             
         case WStype_CONNECTED: {
             LOG_WS("[WS] Connected to url: %s\n", payload);
             isConnected = true;
+            Metrics::inc(Metrics::WS_CONNECTS);
             reconnectAttempts = 0;
             reconnectDelay = 1000;
             lastHeartbeat = millis();
             
             // Identify as ESP32 client
-            StaticJsonDocument<128> doc;
-            doc["type"] = "identify";
-            doc["clientType"] = "esp32";
-            
             String output;
-            serializeJson(doc, output);
+            WsMsg::identify(output, stations, stationCount);
             webSocket.sendTXT(output);
             break;
         }
             
         case WStype_TEXT:
             LOG_WS("[WS] Received: %s\n", payload);
-            handleMessage(String((char*)payload));
+            handleMessage((const char*)payload, length);
             break;
             
         case WStype_ERROR:
@@ -84,16 +86,16 @@ void ToteWebSocketClient::webSocketEvent(WStype_t type, uint8_t * payload, size_
     }
 }
 
-void ToteWebSocketClient::handleMessage(String payload) {
-    StaticJsonDocument<512> doc;
-    DeserializationError error = deserializeJson(doc, payload);
+void ToteWebSocketClient::handleMessage(const char* payload, size_t length) {
+    WsMsg::InDoc doc;
+    DeserializationError error;
+    const char* type = WsMsg::decode(payload, length, doc, error);
     
     if (error) {
         LOG_WS("[WS] JSON parse error: %s\n", error.c_str());
         return;
     }
     
-    const char* type = doc["type"];
     if (!type) {
         LOG_WS("[WS] Message missing 'type' field\n");
         return;
@@ -140,28 +142,20 @@ void ToteWebSocketClient::handleMessage(String payload) {
 void ToteWebSocketClient::sendHeartbeat() {
     if (!isConnected) return;
     
-    StaticJsonDocument<128> doc;
-    doc["type"] = "heartbeat";
-    doc["station"] = "outbound";
-    
     String output;
-    serializeJson(doc, output);
+    WsMsg::heartbeat(output);
     webSocket.sendTXT(output);
 }
 
-bool ToteWebSocketClient::sendWeight(float weight) {
+bool ToteWebSocketClient::sendWeight(float weight, const char* station) {
     if (!isConnected) {
+        Metrics::inc(Metrics::WS_SEND_DROPPED);
         LOG_WS("[WS] Not connected, cannot send weight\n");
         return false;
     }
     
-    StaticJsonDocument<128> doc;
-    doc["type"] = "weight_update";
-    doc["station"] = "outbound";
-    doc["weight"] = weight;
-    
     String output;
-    serializeJson(doc, output);
+    WsMsg::weightUpdate(output, weight, station);
     
     webSocket.sendTXT(output);
     LOG_WS("[WS] Sent weight: %.2f kg\n", weight);
@@ -169,19 +163,15 @@ bool ToteWebSocketClient::sendWeight(float weight) {
     return true;
 }
 
-bool ToteWebSocketClient::sendStateChange(const char* state) {
+bool ToteWebSocketClient::sendStateChange(const char* state, const char* station) {
     if (!isConnected) {
+        Metrics::inc(Metrics::WS_SEND_DROPPED);
         LOG_WS("[WS] Not connected, cannot send state\n");
         return false;
     }
     
-    StaticJsonDocument<128> doc;
-    doc["type"] = "state_change";
-    doc["station"] = "outbound";
-    doc["state"] = state;
-    
     String output;
-    serializeJson(doc, output);
+    WsMsg::stateChange(output, state, station);
     
     webSocket.sendTXT(output);
     LOG_WS("[WS] Sent state: %s\n", state);
@@ -189,19 +179,15 @@ bool ToteWebSocketClient::sendStateChange(const char* state) {
     return true;
 }
 
-bool ToteWebSocketClient::sendToteValidated(const char* toteId) {
+bool ToteWebSocketClient::sendToteValidated(const char* toteId, const char* station) {
     if (!isConnected) {
+        Metrics::inc(Metrics::WS_SEND_DROPPED);
         LOG_WS("[WS] Not connected, cannot send validation\n");
         return false;
     }
     
-    StaticJsonDocument<128> doc;
-    doc["type"] = "tote_validated";
-    doc["station"] = "outbound";
-    doc["toteId"] = toteId;
-    
     String output;
-    serializeJson(doc, output);
+    WsMsg::toteEvent(output, "tote_validated", toteId, station);
     
     webSocket.sendTXT(output);
     LOG_WS("[WS] Tote validated: %s\n", toteId);
@@ -209,19 +195,15 @@ bool ToteWebSocketClient::sendToteValidated(const char* toteId) {
     return true;
 }
 
-bool ToteWebSocketClient::sendToteCompleted(const char* toteId) {
+bool ToteWebSocketClient::sendToteCompleted(const char* toteId, const char* station) {
     if (!isConnected) {
+        Metrics::inc(Metrics::WS_SEND_DROPPED);
         LOG_WS("[WS] Not connected, cannot send completion\n");
         return false;
     }
     
-    StaticJsonDocument<128> doc;
-    doc["type"] = "tote_completed";
-    doc["station"] = "outbound";
-    doc["toteId"] = toteId;
-    
     String output;
-    serializeJson(doc, output);
+    WsMsg::toteEvent(output, "tote_completed", toteId, station);
     
     webSocket.sendTXT(output);
     LOG_WS("[WS] Tote completed: %s\n", toteId);
@@ -229,19 +211,15 @@ bool ToteWebSocketClient::sendToteCompleted(const char* toteId) {
     return true;
 }
 
-bool ToteWebSocketClient::sendIceDispensed(float ice_kg) {
+bool ToteWebSocketClient::sendIceDispensed(float ice_kg, const char* station) {
     if (!isConnected) {
+        Metrics::inc(Metrics::WS_SEND_DROPPED);
         LOG_WS("[WS] Not connected, cannot send ice dispensed\n");
         return false;
     }
     
-    StaticJsonDocument<128> doc;
-    doc["type"] = "ice_dispensed";
-    doc["station"] = "outbound";
-    doc["ice_kg"] = ice_kg;
-    
     String output;
-    serializeJson(doc, output);
+    WsMsg::dispensed(output, "ice_dispensed", "ice_kg", ice_kg, station);
     
     webSocket.sendTXT(output);
     LOG_WS("[WS] Ice dispensed: %.2f kg\n", ice_kg);
@@ -249,19 +227,15 @@ bool ToteWebSocketClient::sendIceDispensed(float ice_kg) {
     return true;
 }
 
-bool ToteWebSocketClient::sendWaterDispensed(float water_kg) {
+bool ToteWebSocketClient::sendWaterDispensed(float water_kg, const char* station) {
     if (!isConnected) {
+        Metrics::inc(Metrics::WS_SEND_DROPPED);
         LOG_WS("[WS] Not connected, cannot send water dispensed\n");
         return false;
     }
     
-    StaticJsonDocument<128> doc;
-    doc["type"] = "water_dispensed";
-    doc["station"] = "outbound";
-    doc["water_kg"] = water_kg;
-    
     String output;
-    serializeJson(doc, output);
+    WsMsg::dispensed(output, "water_dispensed", "water_kg", water_kg, station);
     
     webSocket.sendTXT(output);
     LOG_WS("[WS] Water dispensed: %.2f kg\n", water_kg);
@@ -269,19 +243,15 @@ bool ToteWebSocketClient::sendWaterDispensed(float water_kg) {
     return true;
 }
 
-bool ToteWebSocketClient::sendError(const char* message) {
+bool ToteWebSocketClient::sendError(const char* message, const char* station) {
     if (!isConnected) {
+        Metrics::inc(Metrics::WS_SEND_DROPPED);
         LOG_WS("[WS] Not connected, cannot send error\n");
         return false;
     }
     
-    StaticJsonDocument<256> doc;
-    doc["type"] = "error";
-    doc["station"] = "outbound";
-    doc["message"] = message;
-    
     String output;
-    serializeJson(doc, output);
+    WsMsg::error(output, message, station);
     
     webSocket.sendTXT(output);
     LOG_WS("[WS] Error sent: %s\n", message);
@@ -289,23 +259,37 @@ bool ToteWebSocketClient::sendError(const char* message) {
     return true;
 }
 
-bool ToteWebSocketClient::sendSettingsCurrent(float ice_kg, float water_kg, float min_w) {
-    if (!isConnected) return false;
-    
-    StaticJsonDocument<192> doc;
-    doc["type"]     = "settings_current";
-    doc["station"]  = "outbound";
-    doc["ice_kg"]   = ice_kg;
-    doc["water_kg"] = water_kg;
-    doc["min_w"]    = min_w;
+bool ToteWebSocketClient::sendSettingsCurrent(float ice_kg, float water_kg, float min_w, bool auto_start) {
+    if (!isConnected) {
+        Metrics::inc(Metrics::WS_SEND_DROPPED);
+        return false;
+    }
     
     String output;
-    serializeJson(doc, output);
+    WsMsg::settingsCurrent(output, ice_kg, water_kg, min_w, auto_start);
+    webSocket.sendTXT(output);
+    LOG_WS("[WS] Settings broadcast: ice=%.2f water=%.2f min=%.2f auto=%d\n", ice_kg, water_kg, min_w, auto_start);
+    return true;
+}
+
+bool ToteWebSocketClient::sendStats(JsonDocument& stats) {
+    if (!isConnected) {
+        Metrics::inc(Metrics::WS_SEND_DROPPED);
+        return false;
+    }
+
+    String output;
+    WsMsg::stats(output, stats);
     webSocket.sendTXT(output);
-    LOG_WS("[WS] Settings broadcast: ice=%.2f water=%.2f min=%.2f\n", ice_kg, water_kg, min_w);
+    LOG_WS("[WS] Stats sent (%u bytes)\n", output.length());
     return true;
 }
 
 void ToteWebSocketClient::setMessageCallback(void (*callback)(String type, JsonDocument& doc)) {
     messageCallback = callback;
 }
+
+void ToteWebSocketClient::setStations(const char* const* list, uint8_t count) {
+    stations = list;
+    stationCount = count;
+}
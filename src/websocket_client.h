@@ -3,6 +3,7 @@
 
 #include <WebSocketsClient.h>
 #include <ArduinoJson.h>
+#include "WsMessages.h"
 
 class ToteWebSocketClient {
 private:
@@ -19,13 +20,17 @@ private:
     
     // Callback function pointer
     void (*messageCallback)(String type, JsonDocument& doc);
+
+    // Lane stations announced in "identify" (setStations)
+    const char* const* stations;
+    uint8_t stationCount;
     
     // Static wrapper for WebSocket event handler
     static void webSocketEventStatic(WStype_t type, uint8_t * payload, size_t length);
     static ToteWebSocketClient* instance;
     
     void webSocketEvent(WStype_t type, uint8_t * payload, size_t length);
-    void handleMessage(String payload);
+    void handleMessage(const char* payload, size_t length);
     void sendHeartbeat();
     
 public:
@@ -33,17 +38,21 @@ public:
     
     bool begin(const char* host, uint16_t port, const char* path = "/");
     void loop();
-    bool sendWeight(float weight);
-    bool sendStateChange(const char* state);
-    bool sendToteValidated(const char* toteId);
-    bool sendToteCompleted(const char* toteId);
-    bool sendIceDispensed(float ice_kg);
-    bool sendWaterDispensed(float water_kg);
-    bool sendError(const char* message);
-    bool sendSettingsCurrent(float ice_kg, float water_kg, float min_w);
+    // Lane messages carry the lane's station (default: the first lane's)
+    bool sendWeight(float weight, const char* station = WsMsg::STATION);
+    bool sendStateChange(const char* state, const char* station = WsMsg::STATION);
+    bool sendToteValidated(const char* toteId, const char* station = WsMsg::STATION);
+    bool sendToteCompleted(const char* toteId, const char* station = WsMsg::STATION);
+    bool sendIceDispensed(float ice_kg, const char* station = WsMsg::STATION);
+    bool sendWaterDispensed(float water_kg, const char* station = WsMsg::STATION);
+    bool sendError(const char* message, const char* station = WsMsg::STATION);
+    bool sendSettingsCurrent(float ice_kg, float water_kg, float min_w, bool auto_start);
+    bool sendStats(JsonDocument& stats);
     
     bool isClientConnected() { return isConnected; }
     void setMessageCallback(void (*callback)(String type, JsonDocument& doc));
+    /** Stations of every lane, listed in "identify" when there are several. */
+    void setStations(const char* const* list, uint8_t count);
 };
 
 #endif // WEBSOCKET_CLIENT_H
@@ -0,0 +1,79 @@
+// ============================================================
+// test_tote_detector  —  ToteDetector against failed scale reads
+//
+//   pio test -e native_test
+//
+// The scale HAL reports a read with no answer as NAN (Hal::Scale::netKg).
+// A dosed tote still on the scale must not be picked up again because
+// one read in between failed.
+// ============================================================
+#include <unity.h>
+#include <math.h>
+#include "core/ToteDetector.h"
+
+static const uint32_t PERIOD_MS = 100;   // one reading per loop pass in IDLE
+static const float    FULL_KG   = 42.0f;
+
+static ToteDetector s_det;
+static uint32_t     s_now;
+
+// Feeds kg for ms; returns how many times the detector fired
+static int feed(float kg, uint32_t ms) {
+  int detected = 0;
+  for (uint32_t t = 0; t < ms; t += PERIOD_MS) {
+    if (s_det.sample(s_now, kg) == ToteDetector::Event::DETECTED) detected++;
+    s_now += PERIOD_MS;
+  }
+  return detected;
+}
+
+void setUp() {
+  s_det = ToteDetector();
+  s_det.configure(ToteDetector::Config());
+  s_now = 1000;
+  feed(0.0f, 500);   // empty scale: armed
+  TEST_ASSERT_EQUAL(ToteDetector::State::EMPTY, s_det.state());
+}
+
+void tearDown() {}
+
+static void test_detects_settled_tote() {
+  TEST_ASSERT_EQUAL(1, feed(FULL_KG, 3000));
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, FULL_KG, s_det.weightKg());
+  TEST_ASSERT_EQUAL(ToteDetector::State::DISARMED, s_det.state());
+}
+
+static void test_failed_read_between_full_readings_does_not_rearm() {
+  TEST_ASSERT_EQUAL(1, feed(FULL_KG, 3000));   // first tote, dosed
+
+  TEST_ASSERT_EQUAL(0, feed(NAN, PERIOD_MS));  // bus glitch
+  TEST_ASSERT_EQUAL(ToteDetector::State::DISARMED, s_det.state());
+
+  TEST_ASSERT_EQUAL(0, feed(FULL_KG, 5000));   // same tote, still there
+  TEST_ASSERT_EQUAL(ToteDetector::State::DISARMED, s_det.state());
+}
+
+static void test_failed_reads_while_loading_restart_window() {
+  TEST_ASSERT_EQUAL(0, feed(FULL_KG, 1000));
+  TEST_ASSERT_EQUAL(0, feed(NAN, PERIOD_MS));
+  TEST_ASSERT_EQUAL(ToteDetector::State::LOADING, s_det.state());
+  // hold_ms counts again from the first good reading after the gap
+  TEST_ASSERT_EQUAL(0, feed(FULL_KG, s_det.config().hold_ms));
+  TEST_ASSERT_EQUAL(1, feed(FULL_KG, 2 * PERIOD_MS));
+}
+
+static void test_rearms_when_tote_removed() {
+  TEST_ASSERT_EQUAL(1, feed(FULL_KG, 3000));
+  feed(0.0f, 500);
+  TEST_ASSERT_EQUAL(ToteDetector::State::EMPTY, s_det.state());
+  TEST_ASSERT_EQUAL(1, feed(FULL_KG, 3000));   // next tote
+}
+
+int main(int, char**) {
+  UNITY_BEGIN();
+  RUN_TEST(test_detects_settled_tote);
+  RUN_TEST(test_failed_read_between_full_readings_does_not_rearm);
+  RUN_TEST(test_failed_reads_while_loading_restart_window);
+  RUN_TEST(test_rearms_when_tote_removed);
+  return UNITY_END();
+}
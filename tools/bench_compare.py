@@ -0,0 +1,56 @@
+#!/usr/bin/env python3
+"""Compare two runs of the native benchmark suite (src/bench).
+
+    pio run -e native
+    .pio/build/native/program --json > base.json
+    # ...change something, rebuild...
+    .pio/build/native/program --json > new.json
+    tools/bench_compare.py base.json new.json
+
+Prints per-case deltas. Exit status is 1 if any case got slower than
+--max-slowdown (default 10 %) or allocates more per op than before, so
+it can gate a CI step. Allocation counts are deterministic; timings are
+host wall time, so keep the threshold loose on shared machines.
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        doc = json.load(f)
+    return {r["name"]: r for r in doc["results"]}
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("base")
+    ap.add_argument("new")
+    ap.add_argument("--max-slowdown", type=float, default=10.0, help="percent, default 10")
+    args = ap.parse_args()
+
+    base, new = load(args.base), load(args.new)
+    failed = False
+
+    print(f"{'case':32} {'ns/op base':>12} {'ns/op new':>12} {'Δ%':>8} {'allocs base':>12} {'allocs new':>11}")
+    for name in sorted(set(base) | set(new)):
+        if name not in base or name not in new:
+            print(f"{name:32} {'only in ' + ('new' if name in new else 'base'):>12}")
+            continue
+        b, n = base[name], new[name]
+        delta = (n["ns_per_op"] / b["ns_per_op"] - 1) * 100 if b["ns_per_op"] else 0.0
+        flag = ""
+        if delta > args.max_slowdown:
+            flag += "  SLOWER"
+        if n["allocs_per_op"] > b["allocs_per_op"] + 1e-9:
+            flag += "  MORE ALLOCS"
+        failed |= bool(flag)
+        print(f"{name:32} {b['ns_per_op']:12.1f} {n['ns_per_op']:12.1f} {delta:+7.1f}% "
+              f"{b['allocs_per_op']:12.2f} {n['allocs_per_op']:11.2f}{flag}")
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+"""Push a firmware image to one or more stations through POST /update.
+
+The image is gzipped on the host (the station inflates it while writing
+flash, src/hardware/OtaStream.h) and sent with the SHA-256 of the
+uncompressed .bin, so a corrupted or truncated upload never becomes the
+boot partition.
+
+Usage:
+    tools/ota_push.py .pio/build/edgebox-esp-100/firmware.bin tote-inbound.local
+    tools/ota_push.py firmware.bin 10.0.0.21 10.0.0.22 10.0.0.23   # in parallel
+    tools/ota_push.py --raw firmware.bin tote-inbound.local        # no gzip
+    tools/ota_push.py --spiffs spiffs.bin tote-inbound.local
+"""
+import argparse
+import base64
+import concurrent.futures
+import gzip
+import hashlib
+import sys
+import time
+import urllib.error
+import urllib.request
+import uuid
+
+
+def multipart(filename, payload):
+    boundary = uuid.uuid4().hex
+    head = (f"--{boundary}\r\n"
+            f'Content-Disposition: form-data; name="update"; filename="{filename}"\r\n'
+            "Content-Type: application/octet-stream\r\n\r\n").encode()
+    tail = f"\r\n--{boundary}--\r\n".encode()
+    return boundary, head + payload + tail
+
+
+def push(host, filename, payload, digest, auth, timeout):
+    boundary, body = multipart(filename, payload)
+    req = urllib.request.Request(f"http://{host}/update?sha256={digest}", data=body, method="POST")
+    req.add_header("Content-Type", f"multipart/form-data; boundary={boundary}")
+    req.add_header("Authorization", "Basic " + base64.b64encode(auth.encode()).decode())
+    start = time.monotonic()
+    try:
+        with urllib.request.urlopen(req, timeout=timeout) as resp:
+            answer = resp.read().decode(errors="replace").strip()
+    except (urllib.error.URLError, OSError) as e:
+        answer = f"FAIL: {e}"
+    return host, answer, time.monotonic() - start
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("image")
+    ap.add_argument("hosts", nargs="+")
+    ap.add_argument("--raw", action="store_true", help="send the .bin as is (no gzip)")
+    ap.add_argument("--spiffs", action="store_true", help="filesystem image instead of firmware")
+    ap.add_argument("--auth", default="admin:admin", help="user:password of the web interface")
+    ap.add_argument("--timeout", type=float, default=120)
+    args = ap.parse_args()
+
+    with open(args.image, "rb") as f:
+        image = f.read()
+    digest = hashlib.sha256(image).hexdigest()
+    payload = image if args.raw else gzip.compress(image, compresslevel=9, mtime=0)
+    # The station picks U_SPIFFS when the file name contains "spiffs"
+    filename = ("spiffs" if args.spiffs else "firmware") + (".bin" if args.raw else ".bin.gz")
+
+    print(f"{args.image}: {len(image)} bytes, sent {len(payload)} ({100 * len(payload) / len(image):.0f} %), "
+          f"sha256 {digest[:16]}…")
+
+    failed = 0
+    with concurrent.futures.ThreadPoolExecutor(max_workers=len(args.hosts)) as pool:
+        jobs = [pool.submit(push, h, filename, payload, digest, args.auth, args.timeout) for h in args.hosts]
+        for job in concurrent.futures.as_completed(jobs):
+            host, answer, secs = job.result()
+            ok = answer.startswith("OK")
+            failed += not ok
+            print(f"{host:24s} {secs:6.1f} s {len(payload) / secs / 1024:7.1f} KB/s  {answer}")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
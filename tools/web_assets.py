@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""Compress the web pages into src/hardware/resources/WebFiles.cpp.
+
+Each file in src/hardware/resources/web/ becomes a gzip byte array in
+flash plus a WebAsset (WebFiles.h) with its MIME type and an ETag taken
+from the content hash. The station sends the bytes as they are, with
+Content-Encoding: gzip, and answers 304 when the browser already has
+that ETag.
+
+extra_script.py runs this before every firmware build; the output is
+only rewritten when a page changed. Run it by hand after editing a page
+for env:native, which has no pre-script:
+    tools/web_assets.py
+    tools/web_assets.py --check    # exit 1 if WebFiles.cpp is stale
+"""
+import argparse
+import gzip
+import hashlib
+import os
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+WEB_DIR = os.path.join(ROOT, "src", "hardware", "resources", "web")
+OUT = os.path.join(ROOT, "src", "hardware", "resources", "WebFiles.cpp")
+
+MIME = {".html": "text/html", ".css": "text/css", ".js": "application/javascript", ".svg": "image/svg+xml"}
+
+
+def symbol(filename):
+    # index.html -> INDEX_PAGE, app.js -> APP_JS
+    stem, ext = os.path.splitext(filename)
+    suffix = "PAGE" if ext == ".html" else ext[1:].upper()
+    return (stem.replace("-", "_").replace(".", "_") + "_" + suffix).upper()
+
+
+def render():
+    out = [
+        "// ============================================================",
+        "// WebFiles.cpp  —  GENERATED by tools/web_assets.py, do not edit.",
+        "// Sources: src/hardware/resources/web/. Gzip in flash, see WebFiles.h",
+        "// ============================================================",
+        '#include "WebFiles.h"',
+    ]
+    for name in sorted(os.listdir(WEB_DIR)):
+        ext = os.path.splitext(name)[1]
+        if ext not in MIME:
+            continue
+        with open(os.path.join(WEB_DIR, name), "rb") as f:
+            raw = f.read()
+        gz = gzip.compress(raw, compresslevel=9, mtime=0)  # mtime=0: same input, same bytes
+        sym = symbol(name)
+        etag = hashlib.sha256(gz).hexdigest()[:16]
+
+        out.append("")
+        out.append("// %s: %d bytes, %d gzip" % (name, len(raw), len(gz)))
+        out.append("static const uint8_t %s_GZ[] = {" % sym)
+        for i in range(0, len(gz), 16):
+            out.append("  " + ", ".join("0x%02x" % b for b in gz[i:i + 16]) + ",")
+        out.append("};")
+        out.append('const WebAsset %s = {"%s", %s_GZ, sizeof(%s_GZ), "\\"%s\\""};'
+                   % (sym, MIME[ext], sym, sym, etag))
+    return "\n".join(out) + "\n"
+
+
+def generate(check=False):
+    text = render()
+    try:
+        with open(OUT) as f:
+            current = f.read()
+    except OSError:
+        current = None
+    if current == text:
+        return True
+    if check:
+        return False
+    with open(OUT, "w") as f:
+        f.write(text)
+    print("[web] %s regenerated" % os.path.relpath(OUT, ROOT))
+    return True
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--check", action="store_true", help="only report whether WebFiles.cpp is up to date")
+    args = ap.parse_args()
+    if not generate(check=args.check):
+        print("%s is stale, run tools/web_assets.py" % os.path.relpath(OUT, ROOT))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
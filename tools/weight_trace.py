@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+"""Host-side decoder and benchmark for the weight traces recorded on the station.
+
+Format (src/core/WeightTraceCodec.h):
+    b'WT' <version=1>
+    per sample: varint(dt_ms) zigzag-varint(dw_g)
+
+Usage:
+    # binary from GET /weight_trace?i=0
+    curl -u admin:admin http://tote-outbound.local/weight_trace -o trace.bin
+    tools/weight_trace.py decode trace.bin > trace.csv
+
+    # base64 "data" field of the backend payload
+    tools/weight_trace.py decode --b64 'V1QB...'
+
+    # compression ratio / throughput on synthetic dosing curves
+    tools/weight_trace.py bench
+"""
+import argparse
+import base64
+import random
+import struct
+import sys
+import time
+
+MAGIC = b"WT"
+VERSION = 1
+RAW_SAMPLE_BYTES = 8  # uint32 t_ms + float32 kg, what the firmware would otherwise send
+
+
+def zigzag(v):
+    return ((v << 1) ^ (v >> 31)) & 0xFFFFFFFF
+
+
+def unzigzag(v):
+    return (v >> 1) ^ -(v & 1)
+
+
+def put_varint(out, v):
+    while v >= 0x80:
+        out.append((v & 0x7F) | 0x80)
+        v >>= 7
+    out.append(v)
+
+
+def encode(samples):
+    """samples: iterable of (t_ms, grams) → bytes"""
+    out = bytearray(MAGIC)
+    out.append(VERSION)
+    last_t = last_g = 0
+    for t, g in samples:
+        put_varint(out, (t - last_t) & 0xFFFFFFFF)
+        put_varint(out, zigzag(g - last_g))
+        last_t, last_g = t, g
+    return bytes(out)
+
+
+def decode(buf):
+    """bytes → list of (t_ms, grams)"""
+    if len(buf) < 3 or buf[:2] != MAGIC or buf[2] != VERSION:
+        raise ValueError("not a weight trace (bad header)")
+    samples = []
+    pos, t, g = 3, 0, 0
+    n = len(buf)
+    while pos < n:
+        fields = []
+        for _ in range(2):
+            v = shift = 0
+            while True:
+                if pos >= n or shift > 28:
+                    raise ValueError("truncated varint at byte %d" % pos)
+                b = buf[pos]
+                pos += 1
+                v |= (b & 0x7F) << shift
+                shift += 7
+                if not b & 0x80:
+                    break
+            fields.append(v)
+        t += fields[0]
+        g += unzigzag(fields[1])
+        samples.append((t, g))
+    return samples
+
+
+def synthetic_cycle(rng, base_g=180000, water_g=2000, ice_g=2000, period_ms=45):
+    """Water ramp, ice ramp with in-flight mass, 8 s settle; noise ±15 g."""
+    samples, t, w = [], 0, float(base_g)
+    for target, rate_g_per_s in ((base_g + water_g, 250.0), (base_g + water_g + ice_g, 180.0)):
+        while w < target:
+            t += period_ms + rng.randint(-5, 15)
+            w += rate_g_per_s * period_ms / 1000.0
+            samples.append((t, int(w + rng.gauss(0, 15))))
+    end = t + 8000
+    while t < end:
+        t += period_ms + rng.randint(-5, 15)
+        w += max(0.0, 60.0 - (t - end + 8000) / 50.0) * period_ms / 1000.0
+        samples.append((t, int(w + rng.gauss(0, 15))))
+    return samples
+
+
+def cmd_decode(args):
+    if args.b64:
+        buf = base64.b64decode(args.b64)
+    else:
+        with open(args.file, "rb") as f:
+            buf = f.read()
+    print("t_ms,weight_kg")
+    for t, g in decode(buf):
+        print("%d,%.3f" % (t, g / 1000.0))
+
+
+def cmd_bench(args):
+    rng = random.Random(args.seed)
+    cycles = [synthetic_cycle(rng) for _ in range(args.cycles)]
+    n_samples = sum(len(c) for c in cycles)
+
+    t0 = time.perf_counter()
+    blobs = [encode(c) for c in cycles]
+    t_enc = time.perf_counter() - t0
+
+    t0 = time.perf_counter()
+    decoded = [decode(b) for b in blobs]
+    t_dec = time.perf_counter() - t0
+
+    assert decoded == cycles, "round-trip mismatch"
+    enc_bytes = sum(len(b) for b in blobs)
+    raw_bytes = n_samples * RAW_SAMPLE_BYTES
+    b64_bytes = sum(len(base64.b64encode(b)) for b in blobs)
+
+    print("cycles            %d" % args.cycles)
+    print("samples/cycle     %.0f" % (n_samples / args.cycles))
+    print("raw bytes/cycle   %.0f  (%d B/sample)" % (raw_bytes / args.cycles, RAW_SAMPLE_BYTES))
+    print("wt1 bytes/cycle   %.0f  (%.2f B/sample)" % (enc_bytes / args.cycles, enc_bytes / n_samples))
+    print("base64 bytes/cycle %.0f" % (b64_bytes / args.cycles))
+    print("compression ratio %.2fx" % (raw_bytes / enc_bytes))
+    print("encode            %.2f Msample/s (python)" % (n_samples / t_enc / 1e6))
+    print("decode            %.2f Msample/s (python)" % (n_samples / t_dec / 1e6))
+
+
+def main():
+    p = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = p.add_subparsers(dest="cmd", required=True)
+
+    d = sub.add_parser("decode", help="decode a trace to CSV")
+    d.add_argument("file", nargs="?", help="binary trace from /weight_trace")
+    d.add_argument("--b64", help="base64 'data' field from the backend payload")
+    d.set_defaults(func=cmd_decode)
+
+    b = sub.add_parser("bench", help="compression ratio and throughput on synthetic curves")
+    b.add_argument("--cycles", type=int, default=200)
+    b.add_argument("--seed", type=int, default=1)
+    b.set_defaults(func=cmd_bench)
+
+    args = p.parse_args()
+    if args.cmd == "decode" and not (args.file or args.b64):
+        p.error("decode needs a file or --b64")
+    args.func(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())